@@ -0,0 +1,115 @@
+//============================================================================
+// Benchmark: lock-free ID index vs unordered_map behind a shared_mutex
+//
+// T reader threads look up random IDs for a fixed time while one loader
+// thread keeps adding new IDs (so both tables grow and resize during the
+// run). Reported are total lookups per second and the loader's adds per
+// second for T = 1, 2, 4, ... 64, for BidIdIndex and for a
+// std::unordered_map guarded by a shared_mutex. Look at both columns: a
+// busy shared_mutex keeps the loader out, which leaves the core to the
+// readers but stops the data from changing.
+//
+// Usage: bench_index [ids=1000000] [ms per run=500] [max threads=64]
+// With fewer cores than threads, the readers share cores and the numbers
+// show scheduling as much as scaling.
+//============================================================================
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "BidIndex.hpp"
+
+using namespace std;
+
+struct LockedMap {
+    mutable shared_mutex lock;
+    unordered_map<string, uint64_t> map;
+
+    bool Insert(const string& id, uint64_t value) {
+        unique_lock<shared_mutex> guard(lock);
+        return map.insert_or_assign(id, value).second;
+    }
+    bool Find(const string& id, uint64_t& value) const {
+        shared_lock<shared_mutex> guard(lock);
+        auto it = map.find(id);
+        if (it == map.end()) return false;
+        value = it->second;
+        return true;
+    }
+};
+
+struct Rates {
+    double finds;
+    double adds;
+};
+
+template <typename Index>
+static Rates run(unsigned threads, size_t count, int ms) {
+    Index index;
+    for (size_t i = 0; i < count; i++) index.Insert(to_string(i), i);
+
+    atomic<bool> stop{false};
+    atomic<uint64_t> sink{0};
+    const auto start = chrono::steady_clock::now();
+    vector<size_t> done(threads * 8, 0);   // 8 apart: no false sharing between counters
+    vector<thread> workers;
+    for (unsigned t = 0; t < threads; t++) {
+        workers.emplace_back([&, t] {
+            mt19937_64 rng(t + 1);
+            size_t ops = 0;
+            uint64_t value = 0, found = 0;
+            string id;
+            while (!stop.load(memory_order_relaxed)) {
+                id = to_string(rng() % count);
+                found += index.Find(id, value) ? value : 0;   // used, or the compiler drops the lookup
+                ops++;
+            }
+            done[t * 8] = ops;
+            sink += found;
+        });
+    }
+    size_t added = 0;
+    thread loader([&] {
+        for (size_t i = count; !stop.load(memory_order_relaxed); i++, added++) {
+            index.Insert(to_string(i), i);
+        }
+    });
+    this_thread::sleep_for(chrono::milliseconds(ms));
+    stop = true;
+    // Timed to the stop, not to 'ms': with more threads than cores the
+    // sleeper may wake up late
+    const double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    loader.join();
+    for (thread& w : workers) w.join();
+
+    size_t total = 0;
+    for (unsigned t = 0; t < threads; t++) total += done[t * 8];
+    return {total / seconds, added / seconds};
+}
+
+int main(int argc, char* argv[]) {
+    const size_t count = argc > 1 ? strtoull(argv[1], nullptr, 10) : 1000000;
+    const int ms = argc > 2 ? atoi(argv[2]) : 500;
+    const unsigned most = argc > 3 ? static_cast<unsigned>(atoi(argv[3])) : 64;
+
+    printf("%zu IDs, one loader thread adding more, %d ms per run, %u hardware threads\n\n",
+           count, ms, thread::hardware_concurrency());
+    printf("%8s %14s %12s %14s %12s\n", "", "locked map", "", "BidIdIndex", "");
+    printf("%8s %14s %12s %14s %12s\n", "readers", "finds/s", "adds/s", "finds/s", "adds/s");
+    for (unsigned threads = 1; threads <= most; threads *= 2) {
+        Rates locked = run<LockedMap>(threads, count, ms);
+        Rates lockFree = run<BidIdIndex>(threads, count, ms);
+        printf("%8u %14.0f %12.0f %14.0f %12.0f\n", threads, locked.finds, locked.adds,
+               lockFree.finds, lockFree.adds);
+    }
+    return 0;
+}
@@ -0,0 +1,105 @@
+//============================================================================
+// Benchmark: one lock vs sharded locks under a mixed workload
+//
+// T threads run a mix of operations for a fixed time against a
+// BidShardedStore: 90% Search, 5% Append, 5% Remove, on random IDs. The
+// same run is repeated with 1 shard (one store, one lock) and with S
+// shards, for T = 1, 2, 4, ... up to twice the hardware threads. Reported
+// is total operations per second.
+//
+// Each shard is a hash map of bids, standing in for the list and its ID
+// index (the list itself lives in the main program).
+//
+// Usage: bench_shards [shards=64] [bids=1000000] [ms per run=500]
+// With one core there is nothing to scale onto; both columns stay flat.
+//============================================================================
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "BidShards.hpp"
+
+using namespace std;
+
+class MapStore : public BidStore {
+public:
+    void Append(const Bid& bid) override { bids.emplace(bid.bidId, bid); }
+    void Prepend(const Bid& bid) override { bids.emplace(bid.bidId, bid); }
+    bool Remove(const string& bidId) override { return bids.erase(bidId) > 0; }
+    Bid Search(const string& bidId) const override {
+        auto it = bids.find(bidId);
+        return it == bids.end() ? Bid{} : it->second;
+    }
+    int Size() const override { return static_cast<int>(bids.size()); }
+    void ForEach(const function<void(const Bid&)>& visit) const override {
+        for (const auto& entry : bids) visit(entry.second);
+    }
+private:
+    unordered_map<string, Bid> bids;
+};
+
+static double opsPerSecond(size_t shards, unsigned threads, size_t count, int ms) {
+    BidShardedStore store(shards, [] { return make_unique<MapStore>(); });
+    for (size_t i = 0; i < count; i++) {
+        Bid b;
+        b.bidId = to_string(i);
+        b.fund = "General Fund";
+        store.Append(b);
+    }
+
+    atomic<bool> stop{false};
+    vector<size_t> done(threads * 8, 0);   // 8 apart: no false sharing between counters
+    vector<thread> workers;
+    for (unsigned t = 0; t < threads; t++) {
+        workers.emplace_back([&, t] {
+            mt19937_64 rng(t + 1);
+            size_t ops = 0;
+            Bid b;
+            b.fund = "General Fund";
+            while (!stop.load(memory_order_relaxed)) {
+                b.bidId = to_string(rng() % (count * 2));
+                unsigned op = rng() % 100;
+                if (op < 90) {
+                    store.Search(b.bidId);
+                } else if (op < 95) {
+                    store.Append(b);
+                } else {
+                    store.Remove(b.bidId);
+                }
+                ops++;
+            }
+            done[t * 8] = ops;
+        });
+    }
+    this_thread::sleep_for(chrono::milliseconds(ms));
+    stop = true;
+    for (thread& w : workers) w.join();
+
+    size_t total = 0;
+    for (unsigned t = 0; t < threads; t++) total += done[t * 8];
+    return total * 1000.0 / ms;
+}
+
+int main(int argc, char* argv[]) {
+    const size_t shards = argc > 1 ? strtoull(argv[1], nullptr, 10) : 64;
+    const size_t count = argc > 2 ? strtoull(argv[2], nullptr, 10) : 1000000;
+    const int ms = argc > 3 ? atoi(argv[3]) : 500;
+    const unsigned hardware = max(1u, thread::hardware_concurrency());
+
+    printf("%zu bids, 90%% search / 5%% append / 5%% remove, %d ms per run\n\n", count, ms);
+    printf("%8s %16s %16s %9s\n", "threads", "1 shard ops/s", (to_string(shards) + " shards ops/s").c_str(), "gain");
+    for (unsigned threads = 1; threads <= 2 * hardware; threads *= 2) {
+        double one = opsPerSecond(1, threads, count, ms);
+        double many = opsPerSecond(shards, threads, count, ms);
+        printf("%8u %16.0f %16.0f %8.2fx\n", threads, one, many, many / one);
+    }
+    return 0;
+}
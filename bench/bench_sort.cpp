@@ -0,0 +1,82 @@
+//============================================================================
+// Benchmark: radix sort vs std::sort on sort entries
+//
+// Sorts N (key, pointer) entries, the array LinkedList::Sort builds, by
+// amount in cents (values up to $100,000.00, so 4 of the 8 key bytes vary)
+// and by 8-digit numeric ID. Compared: std::sort, std::stable_sort (what
+// the list needs: equal keys keep their order) and radixSort with 1, 2,
+// 4, ... threads up to the hardware's. Each is timed best of three, on a
+// fresh copy of the unsorted entries.
+//
+// Usage: bench_sort [entries=10000000]
+//============================================================================
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BidSort.hpp"
+
+using namespace std;
+
+static double bestMs(const vector<BidSortEntry>& input, const function<void(vector<BidSortEntry>&)>& sort) {
+    double best = 1e300;
+    for (int round = 0; round < 3; round++) {
+        vector<BidSortEntry> entries = input;
+        auto start = chrono::steady_clock::now();
+        sort(entries);
+        best = min(best, chrono::duration<double, milli>(chrono::steady_clock::now() - start).count());
+        if (!is_sorted(entries.begin(), entries.end(),
+                       [](const BidSortEntry& a, const BidSortEntry& b) { return a.key < b.key; })) {
+            printf("not sorted!\n");
+            exit(1);
+        }
+    }
+    return best;
+}
+
+static void report(const char* name, double ms, size_t count, double baseline) {
+    printf("%-26s %9.2f ms %8.1f ns/entry %7.2fx\n", name, ms, ms * 1e6 / count, baseline / ms);
+}
+
+static void compare(const char* title, const vector<BidSortEntry>& input) {
+    printf("%s\n", title);
+    auto byKey = [](const BidSortEntry& a, const BidSortEntry& b) { return a.key < b.key; };
+
+    double sortMs = bestMs(input, [&](vector<BidSortEntry>& e) { sort(e.begin(), e.end(), byKey); });
+    report("std::sort", sortMs, input.size(), sortMs);
+    double stableMs = bestMs(input, [&](vector<BidSortEntry>& e) { stable_sort(e.begin(), e.end(), byKey); });
+    report("std::stable_sort", stableMs, input.size(), sortMs);
+
+    const unsigned hardware = max(1u, thread::hardware_concurrency());
+    for (unsigned threads = 1;; threads = min(threads * 2, hardware)) {
+        double ms = bestMs(input, [&](vector<BidSortEntry>& e) { radixSort(e, threads); });
+        string name = "radixSort " + to_string(threads) + (threads == 1 ? " thread" : " threads");
+        report(name.c_str(), ms, input.size(), sortMs);
+        if (threads == hardware) break;
+    }
+    printf("\n");
+}
+
+int main(int argc, char* argv[]) {
+    const size_t count = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10000000;
+
+    mt19937_64 rng(42);
+    vector<BidSortEntry> amounts(count), ids(count);
+    for (size_t i = 0; i < count; i++) {
+        void* item = reinterpret_cast<void*>(i);
+        amounts[i] = {amountSortKey(static_cast<double>(rng() % 10000000) / 100.0), item};
+        ids[i] = {10000000 + rng() % 90000000, item};
+    }
+
+    printf("%zu entries\n\n", count);
+    compare("By amount (cents)", amounts);
+    compare("By numeric ID", ids);
+    return 0;
+}
@@ -0,0 +1,332 @@
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+#include "AsyncFileReader.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#define HAVE_POSIX_IO 1
+#endif
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#define HAVE_IO_URING 1
+#endif
+
+static constexpr size_t kBufferAlign = 4096;
+
+// Page-aligned, so the kernel can copy whole pages into it
+struct AlignedDelete {
+    void operator()(char* p) const { ::operator delete[](p, std::align_val_t(kBufferAlign)); }
+};
+using AlignedBuffer = std::unique_ptr<char[], AlignedDelete>;
+
+static AlignedBuffer alignedBuffer(size_t bytes) {
+    return AlignedBuffer(static_cast<char*>(::operator new[](bytes, std::align_val_t(kBufferAlign))));
+}
+
+#ifdef HAVE_IO_URING
+
+/**
+ * The two rings shared with the kernel. We fill submission entries and
+ * move the SQ tail; the kernel posts completions and moves the CQ tail.
+ * The head/tail words are read and written with acquire/release, as the
+ * kernel does on its side.
+ **/
+struct AsyncFileReader::Ring {
+    int            fd       = -1;
+    void*          sqMap    = nullptr;
+    size_t         sqBytes  = 0;
+    void*          cqMap    = nullptr;
+    size_t         cqBytes  = 0;
+    io_uring_sqe*  sqes     = nullptr;
+    size_t         sqeBytes = 0;
+    unsigned*      sqTail   = nullptr;
+    unsigned*      sqMask   = nullptr;
+    unsigned*      sqArray  = nullptr;
+    unsigned*      cqHead   = nullptr;
+    unsigned*      cqTail   = nullptr;
+    unsigned*      cqMask   = nullptr;
+    io_uring_cqe*  cqes     = nullptr;
+
+    // false if the kernel has no io_uring, or it is blocked
+    bool open(unsigned entries) {
+        io_uring_params p{};
+        fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &p));
+        if (fd < 0) {
+            return false;
+        }
+        sqBytes = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+        cqBytes = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+        sqeBytes = p.sq_entries * sizeof(io_uring_sqe);
+        sqMap = ::mmap(nullptr, sqBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+        cqMap = ::mmap(nullptr, cqBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        void* s = ::mmap(nullptr, sqeBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+        if (sqMap == MAP_FAILED || cqMap == MAP_FAILED || s == MAP_FAILED) {
+            if (sqMap == MAP_FAILED) sqMap = nullptr;
+            if (cqMap == MAP_FAILED) cqMap = nullptr;
+            if (s != MAP_FAILED) ::munmap(s, sqeBytes);
+            return false;
+        }
+        sqes = static_cast<io_uring_sqe*>(s);
+
+        char* sq = static_cast<char*>(sqMap);
+        char* cq = static_cast<char*>(cqMap);
+        sqTail  = reinterpret_cast<unsigned*>(sq + p.sq_off.tail);
+        sqMask  = reinterpret_cast<unsigned*>(sq + p.sq_off.ring_mask);
+        sqArray = reinterpret_cast<unsigned*>(sq + p.sq_off.array);
+        cqHead  = reinterpret_cast<unsigned*>(cq + p.cq_off.head);
+        cqTail  = reinterpret_cast<unsigned*>(cq + p.cq_off.tail);
+        cqMask  = reinterpret_cast<unsigned*>(cq + p.cq_off.ring_mask);
+        cqes    = reinterpret_cast<io_uring_cqe*>(cq + p.cq_off.cqes);
+        return true;
+    }
+
+    ~Ring() {
+        if (sqes != nullptr) ::munmap(sqes, sqeBytes);
+        if (cqMap != nullptr) ::munmap(cqMap, cqBytes);
+        if (sqMap != nullptr) ::munmap(sqMap, sqBytes);
+        if (fd >= 0) ::close(fd);
+    }
+
+    // Queue one readv and tell the kernel. false if it refused
+    bool submit(uint64_t userData, int file, const iovec* iov, uint64_t offset) {
+        const unsigned tail = std::atomic_ref<unsigned>(*sqTail).load(std::memory_order_relaxed);
+        const unsigned index = tail & *sqMask;
+        io_uring_sqe& sqe = sqes[index];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = IORING_OP_READV;   // READ needs 5.6; READV is there since 5.1
+        sqe.fd = file;
+        sqe.addr = reinterpret_cast<uint64_t>(iov);
+        sqe.len = 1;
+        sqe.off = offset;
+        sqe.user_data = userData;
+        sqArray[index] = index;
+        std::atomic_ref<unsigned>(*sqTail).store(tail + 1, std::memory_order_release);
+
+        for (;;) {
+            long r = ::syscall(__NR_io_uring_enter, fd, 1, 0, 0, nullptr, 0);
+            if (r >= 0) return true;
+            if (errno != EINTR && errno != EAGAIN) {
+                std::atomic_ref<unsigned>(*sqTail).store(tail, std::memory_order_release);
+                return false;
+            }
+        }
+    }
+
+    // Wait for the next completion
+    io_uring_cqe reap() {
+        for (;;) {
+            const unsigned head = std::atomic_ref<unsigned>(*cqHead).load(std::memory_order_relaxed);
+            if (head != std::atomic_ref<unsigned>(*cqTail).load(std::memory_order_acquire)) {
+                io_uring_cqe cqe = cqes[head & *cqMask];
+                std::atomic_ref<unsigned>(*cqHead).store(head + 1, std::memory_order_release);
+                return cqe;
+            }
+            long r = ::syscall(__NR_io_uring_enter, fd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+            if (r < 0 && errno != EINTR) {
+                throw std::runtime_error(std::string("io_uring wait failed: ") + std::strerror(errno));
+            }
+        }
+    }
+};
+
+#else
+
+struct AsyncFileReader::Ring {
+    bool open(unsigned) { return false; }
+};
+
+#endif
+
+AsyncFileReader::AsyncFileReader(const std::string& path, size_t blockBytes, unsigned depth, bool useRing)
+    : filePath(path), blockBytes(std::max<size_t>(blockBytes, kBufferAlign)),
+      depth(std::max(depth, 1u)), useRing(useRing) {
+#ifdef HAVE_POSIX_IO
+    fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open " + path);
+    }
+    struct stat st{};
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Failed to stat " + path);
+    }
+    if (!S_ISREG(st.st_mode)) {
+        this->useRing = false;   // a pipe has no offsets to read ahead at
+    }
+    fileSize = static_cast<uint64_t>(st.st_size);
+#ifdef POSIX_FADV_SEQUENTIAL
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+#else
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        throw std::runtime_error("Failed to open " + path);
+    }
+#endif
+}
+
+AsyncFileReader::~AsyncFileReader() {
+#ifdef HAVE_POSIX_IO
+    if (fd >= 0) {
+        ::close(fd);
+    }
+#endif
+}
+
+uint64_t AsyncFileReader::ReadAll(const std::function<void(std::string_view chunk)>& consume) {
+    if (useRing && fileSize > 0) {
+        Ring ring;
+        if (ring.open(depth)) {
+            uint64_t bytes = readRing(ring, consume);
+            if (bytes != UINT64_MAX) {
+                backend = "io_uring";
+                return bytes;
+            }
+        }
+    }
+    backend = "read";
+    return readPlain(consume);
+}
+
+#ifdef HAVE_IO_URING
+
+/**
+ * Chunk k of the file goes into buffer k % depth. Chunks are handed over
+ * in order, waiting for the next one if it is not complete yet; whatever
+ * completes meanwhile is filed under its own buffer. A short read is
+ * queued again for the rest.
+ *
+ * @return bytes read, or UINT64_MAX if the kernel refused the very first
+ *         read (nothing was handed over; the caller falls back to read())
+ **/
+uint64_t AsyncFileReader::readRing(Ring& ring, const std::function<void(std::string_view)>& consume) {
+    struct Slot {
+        AlignedBuffer buffer;
+        iovec         iov{};
+        uint64_t      offset = 0;
+        size_t        length = 0;
+        size_t        filled = 0;
+        bool          done   = false;
+    };
+    std::vector<Slot> slots(depth);
+    for (Slot& s : slots) {
+        s.buffer = alignedBuffer(blockBytes);
+    }
+
+    const uint64_t chunks = (fileSize + blockBytes - 1) / blockBytes;
+    uint64_t nextChunk = 0;
+    unsigned inFlight = 0;
+
+    auto queue = [&](Slot& s) {
+        s.iov.iov_base = s.buffer.get() + s.filled;
+        s.iov.iov_len = s.length - s.filled;
+        if (!ring.submit(static_cast<uint64_t>(&s - slots.data()), fd, &s.iov, s.offset + s.filled)) {
+            return false;
+        }
+        inFlight++;
+        return true;
+    };
+    auto start = [&](Slot& s) {
+        s.offset = nextChunk * blockBytes;
+        s.length = static_cast<size_t>(std::min<uint64_t>(blockBytes, fileSize - s.offset));
+        s.filled = 0;
+        s.done = false;
+        nextChunk++;
+        return queue(s);
+    };
+    // The kernel still writes into the buffers of reads in flight
+    auto drain = [&] {
+        while (inFlight > 0) {
+            ring.reap();
+            inFlight--;
+        }
+    };
+
+    for (unsigned i = 0; i < depth && nextChunk < chunks; i++) {
+        if (!start(slots[i])) {
+            if (i == 0) return UINT64_MAX;
+            drain();
+            throw std::runtime_error("Failed to queue a read of " + filePath);
+        }
+    }
+
+    uint64_t total = 0;
+    try {
+        for (uint64_t k = 0; k < chunks; k++) {
+            Slot& s = slots[k % depth];
+            while (!s.done) {
+                io_uring_cqe cqe = ring.reap();
+                inFlight--;
+                Slot& c = slots[cqe.user_data];
+                if (cqe.res == -EINTR || cqe.res == -EAGAIN) {
+                    if (!queue(c)) throw std::runtime_error("Failed to queue a read of " + filePath);
+                } else if (cqe.res < 0) {
+                    throw std::runtime_error("Failed to read " + filePath + ": " + std::strerror(-cqe.res));
+                } else if (cqe.res == 0) {
+                    c.length = c.filled;   // the file got shorter
+                    c.done = true;
+                } else {
+                    c.filled += static_cast<size_t>(cqe.res);
+                    c.done = (c.filled == c.length);
+                    if (!c.done && !queue(c)) throw std::runtime_error("Failed to queue a read of " + filePath);
+                }
+            }
+            consume(std::string_view(s.buffer.get(), s.filled));
+            total += s.filled;
+            if (nextChunk < chunks && !start(s)) {
+                throw std::runtime_error("Failed to queue a read of " + filePath);
+            }
+        }
+    } catch (...) {
+        drain();
+        throw;
+    }
+    return total;
+}
+
+#else
+
+uint64_t AsyncFileReader::readRing(Ring&, const std::function<void(std::string_view)>&) {
+    return UINT64_MAX;
+}
+
+#endif
+
+uint64_t AsyncFileReader::readPlain(const std::function<void(std::string_view)>& consume) {
+    AlignedBuffer buffer = alignedBuffer(blockBytes);
+    uint64_t total = 0;
+#ifdef HAVE_POSIX_IO
+    // The ring reads at offsets, so the file position is still at the start
+    for (;;) {
+        ssize_t n = ::read(fd, buffer.get(), blockBytes);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error("Failed to read " + filePath + ": " + std::strerror(errno));
+        }
+        if (n == 0) break;
+        consume(std::string_view(buffer.get(), static_cast<size_t>(n)));
+        total += static_cast<uint64_t>(n);
+    }
+#else
+    std::ifstream in(filePath, std::ios::binary);
+    while (in.read(buffer.get(), static_cast<std::streamsize>(blockBytes)) || in.gcount() > 0) {
+        consume(std::string_view(buffer.get(), static_cast<size_t>(in.gcount())));
+        total += static_cast<uint64_t>(in.gcount());
+    }
+#endif
+    return total;
+}
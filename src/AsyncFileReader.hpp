@@ -0,0 +1,69 @@
+//============================================================================
+// Name        : AsyncFileReader.hpp
+//
+// Sequential file reader that keeps several large reads in flight and
+// hands the bytes over in file order, chunk by chunk. csv::Parser tokenizes
+// each chunk while the next ones are still being read.
+//
+// Why? Reading line by line through ifstream asks the kernel for a few KB
+// at a time and waits for each; on a cold cache the load is the sum of
+// disk time and parse time. With reads queued ahead, the disk works on
+// chunk n+1..n+depth while chunk n is parsed, and the load takes about
+// as long as the slower of the two.
+//
+// - Linux: io_uring (system calls only, no liburing). 'depth' reads of
+//   'blockBytes' each are queued into page-aligned buffers; a buffer is
+//   queued again as soon as its chunk has been handed over.
+// - Kernels without io_uring (before 5.1, or where it's blocked) and other
+//   POSIX systems: plain read() into one buffer. Elsewhere: ifstream.
+//
+// Both tell the kernel the file is read front to back (posix_fadvise), so
+// its own readahead grows as well.
+//============================================================================
+
+#ifndef ASYNC_FILE_READER_HPP
+#define ASYNC_FILE_READER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+class AsyncFileReader {
+public:
+    static constexpr size_t   kBlockBytes = 1 << 20;
+    static constexpr unsigned kDepth      = 4;
+
+    // Opens the file; throws std::runtime_error if it can't.
+    // useRing = false forces the plain read() path.
+    explicit AsyncFileReader(const std::string& path, size_t blockBytes = kBlockBytes,
+                             unsigned depth = kDepth, bool useRing = true);
+    ~AsyncFileReader();
+
+    AsyncFileReader(const AsyncFileReader&) = delete;
+    AsyncFileReader& operator=(const AsyncFileReader&) = delete;
+
+    // Call 'consume' with every chunk in file order; a chunk is only valid
+    // during the call. Throws std::runtime_error on a read error.
+    // @return bytes read
+    uint64_t ReadAll(const std::function<void(std::string_view chunk)>& consume);
+
+    const char* Backend() const { return backend; }   // "io_uring" or "read", once ReadAll ran
+
+private:
+    struct Ring;
+
+    uint64_t readRing(Ring& ring, const std::function<void(std::string_view)>& consume);
+    uint64_t readPlain(const std::function<void(std::string_view)>& consume);
+
+    std::string filePath;
+    size_t      blockBytes;
+    unsigned    depth;
+    bool        useRing;
+    int         fd       = -1;
+    uint64_t    fileSize = 0;
+    const char* backend  = "read";
+};
+
+#endif // ASYNC_FILE_READER_HPP
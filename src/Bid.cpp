@@ -0,0 +1,44 @@
+#include <algorithm>
+#include <string_view>
+
+#include "Bid.hpp"
+#include "MappedCsv.hpp"
+
+std::string Bid::Title() const {
+    if (titleSource == nullptr) {
+        return title;
+    }
+    return unquoteCsvField(titleSource->view(titleOffset, titleLength));
+}
+
+static bool allDigits(const std::string& s) {
+    return !s.empty() && std::all_of(s.begin(), s.end(), [](char c) { return c >= '0' && c <= '9'; });
+}
+
+bool bidIdLess(const std::string& a, const std::string& b) {
+    bool numericA = allDigits(a), numericB = allDigits(b);
+    if (numericA != numericB) {
+        return numericA; // mixing number and text order wouldn't be transitive
+    }
+    if (!numericA) {
+        return a < b;
+    }
+    size_t za = a.find_first_not_of('0'), zb = b.find_first_not_of('0');
+    std::string_view va = za == std::string::npos ? "" : std::string_view(a).substr(za);
+    std::string_view vb = zb == std::string::npos ? "" : std::string_view(b).substr(zb);
+    if (va.size() != vb.size()) return va.size() < vb.size();
+    return va < vb;
+}
+
+bool bidIdNumber(const std::string& id, uint64_t& value) {
+    size_t start = id.find_first_not_of('0');
+    if (id.empty() || (start != std::string::npos && id.size() - start > 19)) {
+        return false;
+    }
+    value = 0;
+    for (char c : id) {
+        if (c < '0' || c > '9') return false;
+        value = value * 10 + static_cast<uint64_t>(c - '0');
+    }
+    return true;
+}
@@ -0,0 +1,51 @@
+//============================================================================
+// Name        : Bid.hpp
+//
+// The Bid record shared by the list, the operation log and the tests.
+//
+// Why a separate header? The struct used to live in LinkedList.cpp, but the
+// log has to encode and decode bids too, and the tests should exercise the
+// real definition rather than a copy.
+//
+// Lazy titles: when loaded with --lazy-titles, 'title' stays empty and the
+// bid points at the raw title bytes inside the memory-mapped CSV instead.
+// Always read the title through Title(), which handles both cases.
+//============================================================================
+
+#ifndef BID_HPP
+#define BID_HPP
+
+#include <cstdint>
+#include <string>
+
+class MappedFile;
+
+// Define a structure to hold bid information with unique identifier, title, fund, and amount
+struct Bid {
+    std::string bidId;
+    std::string title;
+    std::string fund;
+    double amount;
+
+    // Set only for lazy titles; the mapped file outlives every bid using it
+    const MappedFile* titleSource = nullptr;
+    uint64_t          titleOffset = 0;
+    uint32_t          titleLength = 0;
+
+    Bid() {
+        amount = 0.0;
+    }
+
+    // The title, decoded (unquoted) from the mapped file if it lives there
+    std::string Title() const;
+};
+
+// Order of bid IDs: numeric IDs first, by value ("99" < "100"), then
+// everything else as text. Used wherever bids are kept or merged in ID order.
+bool bidIdLess(const std::string& a, const std::string& b);
+
+// True for all-digit IDs short enough for 64 bits; 'value' is then their
+// number, and comparing values gives the same order as bidIdLess
+bool bidIdNumber(const std::string& id, uint64_t& value);
+
+#endif // BID_HPP
@@ -0,0 +1,279 @@
+#include <algorithm>
+
+#include "BidAsync.hpp"
+
+//----------------------------------------------------------------------------
+// BidWorkerPool
+//----------------------------------------------------------------------------
+
+BidWorkerPool::BidWorkerPool(const BidPoolOptions& opts) : options(opts) {
+    unsigned threads = options.threads;
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    options.maxQueued = std::max<size_t>(1, options.maxQueued);
+
+    for (unsigned i = 0; i < threads; i++) {
+        deques.push_back(std::make_unique<WorkerDeque>());
+    }
+    for (unsigned i = 0; i < threads; i++) {
+        workers.emplace_back(&BidWorkerPool::run, this, i);
+    }
+}
+
+BidWorkerPool::~BidWorkerPool() {
+    {
+        std::lock_guard<std::mutex> guard(idleLock);
+        stopping = true;
+    }
+    workReady.notify_all();
+    roomReady.notify_all();
+    for (std::thread& t : workers) {
+        t.join();
+    }
+}
+
+bool BidWorkerPool::reserve() {
+    size_t n = queued.load();
+    while (n < options.maxQueued) {
+        if (queued.compare_exchange_weak(n, n + 1)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Queue a task. The slot is reserved before the push, so a worker can see
+ * the count before the task lands in its deque; it then looks again.
+ *
+ * A sleeper counts itself in idleWorkers and then re-checks 'queued'; we
+ * raise 'queued' and then check idleWorkers. Either it sees our task or we
+ * see it asleep and wake it under idleLock, so no wakeup is lost.
+ */
+void BidWorkerPool::Submit(std::function<void()> task) {
+    if (stopping) {
+        throw BidQueueFull("pool is shutting down");
+    }
+    if (!reserve()) {
+        if (!options.blockWhenFull) {
+            throw BidQueueFull("queue full (" + std::to_string(options.maxQueued) + " tasks)");
+        }
+        std::unique_lock<std::mutex> guard(idleLock);
+        roomWaiters++;
+        roomReady.wait(guard, [&] { return stopping || reserve(); });
+        roomWaiters--;
+        if (stopping) {
+            throw BidQueueFull("pool is shutting down");
+        }
+    }
+
+    WorkerDeque& d = *deques[nextDeque.fetch_add(1, std::memory_order_relaxed) % deques.size()];
+    {
+        std::lock_guard<std::mutex> dequeGuard(d.lock);
+        d.tasks.push_back(std::move(task));
+    }
+    if (idleWorkers > 0) {
+        std::lock_guard<std::mutex> guard(idleLock);
+        workReady.notify_one();
+    }
+}
+
+/**
+ * Newest task from our own deque, else the oldest from someone else's.
+ * Stealing from the far end keeps thieves and owner apart, and takes the
+ * task that has waited longest. Only the deque being looked at is locked.
+ */
+bool BidWorkerPool::takeTask(size_t self, std::function<void()>& task) {
+    bool found = false;
+    {
+        WorkerDeque& own = *deques[self];
+        std::lock_guard<std::mutex> guard(own.lock);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            found = true;
+        }
+    }
+    for (size_t k = 1; !found && k < deques.size(); k++) {
+        WorkerDeque& victim = *deques[(self + k) % deques.size()];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            steals.fetch_add(1, std::memory_order_relaxed);
+            found = true;
+        }
+    }
+    if (!found) {
+        return false;
+    }
+
+    // The slot is free; wake a Submit waiting for one (same handshake as workReady)
+    queued--;
+    if (roomWaiters > 0) {
+        std::lock_guard<std::mutex> guard(idleLock);
+        roomReady.notify_one();
+    }
+    return true;
+}
+
+void BidWorkerPool::run(size_t self) {
+    std::function<void()> task;
+    for (;;) {
+        if (!takeTask(self, task)) {
+            if (queued > 0) {
+                // Reserved but not pushed yet, or passed over mid-scan; look again
+                std::this_thread::yield();
+                continue;
+            }
+            std::unique_lock<std::mutex> guard(idleLock);
+            idleWorkers++;
+            workReady.wait(guard, [&] { return queued > 0 || stopping; });
+            idleWorkers--;
+            if (queued == 0) {
+                return;   // stopping, and nothing left to run
+            }
+            continue;
+        }
+        try {
+            task();
+        } catch (...) {
+            // Nowhere to report it; the queries catch their own and pass them on
+        }
+        task = nullptr;
+    }
+}
+
+//----------------------------------------------------------------------------
+// BidAsyncQueries
+//----------------------------------------------------------------------------
+
+// A plain store is the caller's to keep alive: an empty owner, just the pointer
+BidAsyncQueries::BidAsyncQueries(const BidStore& store, const BidPoolOptions& options)
+    : pin([&store] { return std::shared_ptr<const BidStore>(std::shared_ptr<void>(), &store); }),
+      pool(options) {}
+
+BidAsyncQueries::BidAsyncQueries(const BidReloader& reloader, const BidPoolOptions& options)
+    : pin([&reloader] { return reloader.Current(); }), pool(options) {}
+
+/**
+ * Attach to the lookup already running for this ID, or start one.
+ * @return the pending lookup; a new one is only queued by the caller that
+ *         created it, so a burst of requests queues a single task
+ */
+std::shared_ptr<BidAsyncQueries::PendingSearch>
+BidAsyncQueries::join(const std::string& bidId, SearchDone done) {
+    std::shared_ptr<PendingSearch> search;
+    const bool own = static_cast<bool>(done);
+    {
+        std::lock_guard<std::mutex> guard(pendingLock);
+        auto it = pending.find(bidId);
+        if (it != pending.end()) {
+            if (done) it->second->callbacks.push_back(std::move(done));
+            merged.fetch_add(1, std::memory_order_relaxed);
+            return it->second;
+        }
+        search = std::make_shared<PendingSearch>();
+        search->future = search->promise.get_future().share();
+        if (done) search->callbacks.push_back(std::move(done));
+        pending.emplace(bidId, search);
+    }
+
+    try {
+        pool.Submit([this, bidId] { lookUp(bidId); });
+    } catch (...) {
+        // Requests that joined while Submit waited for room get the error
+        // too; ours is thrown to the caller instead
+        std::exception_ptr error = std::current_exception();
+        std::vector<SearchDone> joined;
+        {
+            std::lock_guard<std::mutex> guard(pendingLock);
+            pending.erase(bidId);
+            joined = std::move(search->callbacks);
+        }
+        search->promise.set_exception(error);
+        for (size_t i = own ? 1 : 0; i < joined.size(); i++) {
+            joined[i](Bid(), error);
+        }
+        throw;
+    }
+    return search;
+}
+
+/**
+ * Requests for the ID keep joining while the store is searched. The lookup
+ * is taken out of 'pending' before its result is published, so a request
+ * arriving after that starts a fresh lookup and sees any write made since.
+ */
+void BidAsyncQueries::lookUp(const std::string& bidId) {
+    Bid found;
+    std::exception_ptr error;
+    try {
+        std::shared_ptr<const BidStore> store = pin();
+        if (store) found = store->Search(bidId);
+    } catch (...) {
+        error = std::current_exception();
+    }
+
+    std::shared_ptr<PendingSearch> search;
+    {
+        std::lock_guard<std::mutex> guard(pendingLock);
+        auto it = pending.find(bidId);
+        search = it->second;
+        pending.erase(it);
+    }
+    if (error) {
+        search->promise.set_exception(error);
+    } else {
+        search->promise.set_value(found);
+    }
+    for (auto& done : search->callbacks) {
+        done(found, error);
+    }
+}
+
+std::shared_future<Bid> BidAsyncQueries::Search(const std::string& bidId) {
+    return join(bidId, nullptr)->future;
+}
+
+void BidAsyncQueries::Search(const std::string& bidId, SearchDone done) {
+    join(bidId, std::move(done));
+}
+
+std::future<std::vector<Bid>> BidAsyncQueries::Filter(std::function<bool(const Bid&)> match) {
+    auto promise = std::make_shared<std::promise<std::vector<Bid>>>();
+    std::future<std::vector<Bid>> result = promise->get_future();
+    pool.Submit([this, promise, match = std::move(match)] {
+        try {
+            std::vector<Bid> matches;
+            if (std::shared_ptr<const BidStore> store = pin()) {
+                store->ForEach([&](const Bid& b) {
+                    if (match(b)) matches.push_back(b);
+                });
+            }
+            promise->set_value(std::move(matches));
+        } catch (...) {
+            promise->set_exception(std::current_exception());
+        }
+    });
+    return result;
+}
+
+void BidAsyncQueries::Filter(std::function<bool(const Bid&)> match, FilterDone done) {
+    pool.Submit([this, match = std::move(match), done = std::move(done)] {
+        std::vector<Bid> matches;
+        std::exception_ptr error;
+        try {
+            if (std::shared_ptr<const BidStore> store = pin()) {
+                store->ForEach([&](const Bid& b) {
+                    if (match(b)) matches.push_back(b);
+                });
+            }
+        } catch (...) {
+            error = std::current_exception();
+            matches.clear();
+        }
+        done(std::move(matches), error);
+    });
+}
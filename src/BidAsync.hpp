@@ -0,0 +1,148 @@
+//============================================================================
+// Name        : BidAsync.hpp
+//
+// Asynchronous queries on a BidStore for programs that embed the store and
+// must not block their own event loop.
+//
+// BidWorkerPool: a fixed set of threads, each with its own task deque.
+// Submitted tasks are dealt out round-robin; a worker takes its newest task
+// first (still warm in cache) and, when its deque runs dry, steals the
+// oldest task from another worker. One slow query then holds up only its
+// own thread, not the tasks queued behind it. Submit and steal lock only
+// the one deque they touch; the queue count is an atomic, and a pool-wide
+// lock is taken only to sleep or to wake a sleeper. A queue limit gives
+// callers backpressure: when it is reached, Submit waits for room or
+// throws BidQueueFull, whichever was configured.
+//
+// BidAsyncQueries: Search and Filter on the pool, answered through futures
+// or completion callbacks. A Search for an ID that is already being looked
+// up joins that lookup instead of queueing another - a burst of requests
+// for one popular ID costs one lookup. A failed query reaches completion
+// callbacks as their exception_ptr argument, with an empty result.
+//
+// Queries only read the store. The skip list allows reads while another
+// thread writes; the linked list must not be changed while queries run.
+// Queries on a BidReloader instead each pin the version current when they
+// start, so a reload can replace the store while they run.
+//============================================================================
+
+#ifndef BID_ASYNC_HPP
+#define BID_ASYNC_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "BidReload.hpp"
+#include "BidStore.hpp"
+
+class BidQueueFull : public std::runtime_error {
+public:
+    BidQueueFull(const std::string& msg)
+        : std::runtime_error(std::string("BidAsync : ").append(msg)) {}
+};
+
+struct BidPoolOptions {
+    unsigned threads     = 0;      // 0 = one per hardware thread
+    size_t   maxQueued   = 1024;   // tasks waiting to start
+    bool     blockWhenFull = true; // false: Submit throws BidQueueFull instead
+};
+
+class BidWorkerPool {
+public:
+    explicit BidWorkerPool(const BidPoolOptions& options = {});
+    ~BidWorkerPool();                  // runs every queued task, then stops
+
+    BidWorkerPool(const BidWorkerPool&) = delete;
+    BidWorkerPool& operator=(const BidWorkerPool&) = delete;
+
+    void Submit(std::function<void()> task);
+
+    size_t Threads() const { return workers.size(); }
+    size_t Queued() const { return queued.load(); }
+    size_t Steals() const { return steals.load(std::memory_order_relaxed); }
+
+private:
+    // Own cache line each, so workers locking their deques don't collide
+    struct alignas(64) WorkerDeque {
+        std::mutex                        lock;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    bool reserve();   // a queue slot, if one is free
+    bool takeTask(size_t self, std::function<void()>& task);
+    void run(size_t self);
+
+    BidPoolOptions options;
+    std::vector<std::unique_ptr<WorkerDeque>> deques;
+    std::vector<std::thread> workers;
+
+    std::atomic<size_t>     queued{0};      // slots reserved by Submit, tasks not yet taken
+    std::atomic<size_t>     nextDeque{0};
+    std::atomic<bool>       stopping{false};
+    std::atomic<size_t>     steals{0};
+
+    // Only for sleeping and waking; the counts say whether anyone sleeps
+    std::mutex              idleLock;
+    std::condition_variable workReady;
+    std::condition_variable roomReady;
+    std::atomic<size_t>     idleWorkers{0};
+    std::atomic<size_t>     roomWaiters{0};
+};
+
+class BidAsyncQueries {
+public:
+    explicit BidAsyncQueries(const BidStore& store, const BidPoolOptions& options = {});
+    explicit BidAsyncQueries(const BidReloader& reloader, const BidPoolOptions& options = {});
+
+    // Completion callbacks; 'error' is set, and the result empty, if the query failed
+    using SearchDone = std::function<void(const Bid&, std::exception_ptr error)>;
+    using FilterDone = std::function<void(std::vector<Bid>, std::exception_ptr error)>;
+
+    // Empty Bid if not found, as with BidStore::Search. Callbacks run on a
+    // worker thread. If the pool refuses the lookup, the caller that
+    // started it gets the exception and every request that joined it gets
+    // it through its future or callback.
+    std::shared_future<Bid> Search(const std::string& bidId);
+    void Search(const std::string& bidId, SearchDone done);
+
+    // Every bid 'match' accepts, in the store's order. An exception from
+    // 'match' fails the query.
+    std::future<std::vector<Bid>> Filter(std::function<bool(const Bid&)> match);
+    void Filter(std::function<bool(const Bid&)> match, FilterDone done);
+
+    size_t MergedSearches() const { return merged.load(std::memory_order_relaxed); }
+    const BidWorkerPool& Pool() const { return pool; }
+
+private:
+    // One lookup in flight, shared by every request for its ID
+    struct PendingSearch {
+        std::promise<Bid>       promise;
+        std::shared_future<Bid> future;
+        std::vector<SearchDone> callbacks;
+    };
+
+    std::shared_ptr<PendingSearch> join(const std::string& bidId, SearchDone done);
+    void lookUp(const std::string& bidId);
+
+    // The store to query; pinned per task, so a reload can't free it mid-query
+    std::function<std::shared_ptr<const BidStore>()> pin;
+    std::mutex      pendingLock;
+    std::unordered_map<std::string, std::shared_ptr<PendingSearch>> pending;
+    std::atomic<size_t> merged{0};
+
+    BidWorkerPool pool;   // last: its destructor drains tasks that use the members above
+};
+
+#endif // BID_ASYNC_HPP
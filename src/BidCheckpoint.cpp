@@ -0,0 +1,135 @@
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include "BidCheckpoint.hpp"
+#include "BidCodec.hpp"
+
+static const char CHECKPOINT_MAGIC[8] = {'B', 'I', 'D', 'C', 'K', 'P', 'T', '1'};
+
+void BidCheckpoint::Write(const std::string& path, uint64_t lsn, const std::vector<Bid>& bids) {
+    std::string bytes(CHECKPOINT_MAGIC, sizeof CHECKPOINT_MAGIC);
+    ByteWriter w(bytes);
+    w.u64(lsn);
+    w.u64(bids.size());
+    for (const Bid& bid : bids) {
+        w.bid(bid);
+    }
+    w.u32(crc32Update(bytes.data(), bytes.size()));
+
+    BidLog::WriteFileAtomically(path, bytes);
+}
+
+bool BidCheckpoint::Read(const std::string& path, uint64_t& lsn,
+                         const std::function<void(const Bid&)>& visit) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        return false;
+    }
+    std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    // Check the whole file before handing out a single bid
+    const size_t fixed = sizeof CHECKPOINT_MAGIC + 8 + 8 + 4;
+    if (bytes.size() < fixed || std::memcmp(bytes.data(), CHECKPOINT_MAGIC, sizeof CHECKPOINT_MAGIC) != 0) {
+        throw BidLogError("not a checkpoint file: " + path);
+    }
+    uint32_t storedCrc;
+    ByteReader(bytes.data() + bytes.size() - 4, 4).u32(storedCrc);
+    if (crc32Update(bytes.data(), bytes.size() - 4) != storedCrc) {
+        throw BidLogError("checksum mismatch in " + path);
+    }
+
+    ByteReader r(bytes.data() + sizeof CHECKPOINT_MAGIC, bytes.size() - sizeof CHECKPOINT_MAGIC - 4);
+    uint64_t count;
+    r.u64(lsn);
+    r.u64(count);
+    Bid bid;
+    for (uint64_t i = 0; i < count; i++) {
+        if (!r.bid(bid)) {
+            throw BidLogError("truncated checkpoint " + path);
+        }
+        visit(bid);
+    }
+    return true;
+}
+
+//----------------------------------------------------------------------------
+// Checkpointer
+//----------------------------------------------------------------------------
+
+Checkpointer::Checkpointer(BidLog& log, const std::string& path)
+    : log(log), path(path), worker(&Checkpointer::run, this) {}
+
+Checkpointer::~Checkpointer() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    changed.notify_all();
+    worker.join();
+}
+
+void Checkpointer::Submit(uint64_t lsn, std::vector<Bid> snapshot) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queued = std::move(snapshot);
+        queuedLsn = lsn;
+        hasQueued = true;
+    }
+    changed.notify_all();
+}
+
+void Checkpointer::Wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    changed.wait(lock, [&] { return !hasQueued && !busy; });
+}
+
+uint64_t Checkpointer::LastLsn() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return lastLsn;
+}
+
+std::string Checkpointer::LastError() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return lastError;
+}
+
+/**
+ * Order matters for crash safety: the checkpoint must be durable before the
+ * log records it replaces are dropped. Write returns only once the new file
+ * and its directory entry are both synced, so the log's own rename can't
+ * reach the disk ahead of it. A crash in between just means the
+ * next start replays a few records the checkpoint already covers - so the
+ * records are skipped by lsn, not applied twice.
+ */
+void Checkpointer::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        changed.wait(lock, [&] { return stopping || hasQueued; });
+        if (!hasQueued) {
+            break;
+        }
+
+        std::vector<Bid> snapshot = std::move(queued);
+        uint64_t lsn = queuedLsn;
+        hasQueued = false;
+        busy = true;
+        lock.unlock();
+
+        std::string error;
+        try {
+            BidCheckpoint::Write(path, lsn, snapshot);
+            log.TruncateThrough(lsn);
+        } catch (const BidLogError& e) {
+            error = e.what();
+        }
+
+        lock.lock();
+        busy = false;
+        lastError = error;
+        if (error.empty()) {
+            lastLsn = lsn;
+        }
+        changed.notify_all();
+    }
+}
@@ -0,0 +1,82 @@
+//============================================================================
+// Name        : BidCheckpoint.hpp
+//
+// Periodic full snapshots of the list so startup doesn't replay history.
+//
+// File layout (all integers little-endian, see BidCodec):
+//
+//   "BIDCKPT1" | u64 lsn | u64 count | count x bid | u32 CRC-32 of the rest
+//
+// 'lsn' is the last log record the snapshot includes. Startup loads the
+// snapshot, then replays only log records newer than 'lsn', so restart time
+// depends on the edits since the last checkpoint rather than on all history.
+//
+// Why a background thread? Encoding and fsyncing millions of bids takes a
+// while. The menu thread only copies the bids (a consistent image, since
+// nothing else edits the list) and hands the copy over.
+//============================================================================
+
+#ifndef BID_CHECKPOINT_HPP
+#define BID_CHECKPOINT_HPP
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Bid.hpp"
+#include "BidLog.hpp"
+
+class BidCheckpoint {
+public:
+    // Atomically replaces any older checkpoint at 'path'
+    static void Write(const std::string& path, uint64_t lsn, const std::vector<Bid>& bids);
+
+    // Returns false if there is no checkpoint yet.
+    // Throws BidLogError if the file exists but fails its checksum.
+    static bool Read(const std::string& path, uint64_t& lsn,
+                     const std::function<void(const Bid&)>& visit);
+};
+
+/**
+ * Writes checkpoints on its own thread, then trims the log behind them.
+ * If a new snapshot arrives while one is still being written, only the
+ * newest waiting snapshot is kept - an older one would be stale anyway.
+ */
+class Checkpointer {
+public:
+    Checkpointer(BidLog& log, const std::string& path);
+    ~Checkpointer();                  // finishes any checkpoint in progress
+
+    Checkpointer(const Checkpointer&) = delete;
+    Checkpointer& operator=(const Checkpointer&) = delete;
+
+    void Submit(uint64_t lsn, std::vector<Bid> snapshot);
+    void Wait();                      // until nothing is queued or running
+
+    uint64_t    LastLsn() const;      // lsn covered by the newest checkpoint
+    std::string LastError() const;    // empty if the last attempt succeeded
+
+private:
+    void run();
+
+    BidLog&     log;
+    std::string path;
+
+    mutable std::mutex      mutex;
+    std::condition_variable changed;
+    std::vector<Bid>        queued;
+    uint64_t                queuedLsn = 0;
+    bool                    hasQueued = false;
+    bool                    busy      = false;
+    bool                    stopping  = false;
+    uint64_t                lastLsn   = 0;
+    std::string             lastError;
+
+    std::thread worker;
+};
+
+#endif // BID_CHECKPOINT_HPP
@@ -0,0 +1,117 @@
+#include <array>
+#include <cstring>
+
+#include "BidCodec.hpp"
+
+// Lookup table for the byte-at-a-time CRC-32, built once on first use
+static const std::array<uint32_t, 256>& crcTable() {
+    static const std::array<uint32_t, 256> table = [] {
+        std::array<uint32_t, 256> t{};
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+            }
+            t[i] = c;
+        }
+        return t;
+    }();
+    return table;
+}
+
+uint32_t crc32Update(const void* data, size_t length, uint32_t crc) {
+    const auto& table = crcTable();
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++) {
+        crc = table[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+//----------------------------------------------------------------------------
+// ByteWriter
+//----------------------------------------------------------------------------
+
+void ByteWriter::u8(uint8_t value) {
+    out.push_back(static_cast<char>(value));
+}
+
+void ByteWriter::u32(uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+void ByteWriter::u64(uint64_t value) {
+    for (int i = 0; i < 8; i++) {
+        out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+void ByteWriter::f64(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof bits);
+    u64(bits);
+}
+
+void ByteWriter::str(const std::string& value) {
+    u32(static_cast<uint32_t>(value.size()));
+    out.append(value);
+}
+
+void ByteWriter::bid(const Bid& value) {
+    str(value.bidId);
+    str(value.Title()); // lazy titles are materialized; files never hold offsets
+    str(value.fund);
+    f64(value.amount);
+}
+
+//----------------------------------------------------------------------------
+// ByteReader
+//----------------------------------------------------------------------------
+
+bool ByteReader::u8(uint8_t& value) {
+    if (remaining() < 1) return false;
+    value = static_cast<uint8_t>(*pos++);
+    return true;
+}
+
+bool ByteReader::u32(uint32_t& value) {
+    if (remaining() < 4) return false;
+    value = 0;
+    for (int i = 0; i < 4; i++) {
+        value |= static_cast<uint32_t>(static_cast<unsigned char>(pos[i])) << (8 * i);
+    }
+    pos += 4;
+    return true;
+}
+
+bool ByteReader::u64(uint64_t& value) {
+    if (remaining() < 8) return false;
+    value = 0;
+    for (int i = 0; i < 8; i++) {
+        value |= static_cast<uint64_t>(static_cast<unsigned char>(pos[i])) << (8 * i);
+    }
+    pos += 8;
+    return true;
+}
+
+bool ByteReader::f64(double& value) {
+    uint64_t bits;
+    if (!u64(bits)) return false;
+    std::memcpy(&value, &bits, sizeof value);
+    return true;
+}
+
+bool ByteReader::str(std::string& value) {
+    uint32_t length;
+    if (!u32(length) || remaining() < length) return false;
+    value.assign(pos, length);
+    pos += length;
+    return true;
+}
+
+bool ByteReader::bid(Bid& value) {
+    return str(value.bidId) && str(value.title) && str(value.fund) && f64(value.amount);
+}
@@ -0,0 +1,68 @@
+//============================================================================
+// Name        : BidCodec.hpp
+//
+// Little binary encoding helpers for anything we write to disk.
+//
+// Why not just write text? The log has to detect torn writes after a crash,
+// which means length-prefixed records with a checksum. Length-prefixed
+// strings also mean titles with commas, quotes or newlines need no escaping.
+//
+// Integers are written little-endian byte by byte so files are portable
+// between machines; doubles are stored as their raw IEEE-754 bits.
+//============================================================================
+
+#ifndef BID_CODEC_HPP
+#define BID_CODEC_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "Bid.hpp"
+
+// CRC-32 (IEEE polynomial, same as zip/png). Pass a previous result as 'crc'
+// to checksum data in pieces.
+uint32_t crc32Update(const void* data, size_t length, uint32_t crc = 0);
+
+/**
+ * Appends primitive values to a byte string.
+ */
+class ByteWriter {
+public:
+    explicit ByteWriter(std::string& out) : out(out) {}
+
+    void u8(uint8_t value);
+    void u32(uint32_t value);
+    void u64(uint64_t value);
+    void f64(double value);
+    void str(const std::string& value); // u32 length + bytes
+    void bid(const Bid& value);
+
+private:
+    std::string& out;
+};
+
+/**
+ * Reads primitive values back out of a byte range.
+ * Every read returns false instead of running past the end, so a truncated
+ * record is reported rather than read as garbage.
+ */
+class ByteReader {
+public:
+    ByteReader(const char* data, size_t length) : pos(data), end(data + length) {}
+
+    bool u8(uint8_t& value);
+    bool u32(uint32_t& value);
+    bool u64(uint64_t& value);
+    bool f64(double& value);
+    bool str(std::string& value);
+    bool bid(Bid& value);
+
+    size_t remaining() const { return static_cast<size_t>(end - pos); }
+
+private:
+    const char* pos;
+    const char* end;
+};
+
+#endif // BID_CODEC_HPP
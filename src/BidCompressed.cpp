@@ -0,0 +1,678 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <exception>
+#include <thread>
+
+#include "BidCompressed.hpp"
+
+static constexpr size_t   kSampleBytes   = 32 * 1024;   // of titles, to train the symbol table
+static constexpr int      kTrainRounds   = 5;
+static constexpr size_t   kRetrainBelow  = 4096;        // titles; a smaller table is retrained as bids arrive
+static constexpr unsigned kMaxCentBits   = 56;          // wider blocks keep doubles
+static constexpr uint8_t  kEscape        = 255;
+
+// ---------------------------------------------------------------------------
+// Varints and bit packing
+// ---------------------------------------------------------------------------
+
+static void putVarint(std::string& out, uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back(static_cast<char>((v & 0x7f) | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<char>(v));
+}
+
+static uint64_t getVarint(const char*& p) {
+    uint64_t v = 0;
+    for (unsigned shift = 0;; shift += 7) {
+        const uint8_t byte = static_cast<uint8_t>(*p++);
+        v |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (byte < 0x80) return v;
+    }
+}
+
+static unsigned bitsFor(uint64_t maxValue) {
+    unsigned bits = 0;
+    while (bits < 64 && (maxValue >> bits) != 0) bits++;
+    return bits;
+}
+
+// Values at 'bits' each, least significant bit first
+static void putBits(std::string& out, const std::vector<uint64_t>& values, unsigned bits) {
+    const size_t start = out.size();
+    out.resize(start + (values.size() * bits + 7) / 8, '\0');
+    unsigned char* base = reinterpret_cast<unsigned char*>(out.data() + start);
+    uint64_t bit = 0;
+    for (uint64_t v : values) {
+        for (unsigned i = 0; i < bits; i++, bit++) {
+            if ((v >> i) & 1) base[bit / 8] |= static_cast<unsigned char>(1u << (bit % 8));
+        }
+    }
+}
+
+// Value 'index' of a packed run; 'bits' is at most 56, so it spans at most 8 bytes
+static uint64_t getBits(const char* base, size_t index, unsigned bits) {
+    if (bits == 0) return 0;
+    const uint64_t bit = static_cast<uint64_t>(index) * bits;
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(base) + bit / 8;
+    const unsigned shift = bit % 8;
+    uint64_t v = 0;
+    for (unsigned i = 0; i < (shift + bits + 7) / 8; i++) {
+        v |= static_cast<uint64_t>(p[i]) << (8 * i);
+    }
+    return (v >> shift) & ((uint64_t(1) << bits) - 1);
+}
+
+static uint64_t zigzag(int64_t v) { return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63); }
+static int64_t unzigzag(uint64_t v) { return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1); }
+
+// The amount as whole cents, if that gives back exactly the same double
+static bool wholeCents(double amount, int64_t& cents) {
+    if (!std::isfinite(amount) || std::fabs(amount) >= 1e15) return false;
+    cents = std::llround(amount * 100.0);
+    return static_cast<double>(cents) / 100.0 == amount;
+}
+
+// Numeric IDs without leading zeros; those can be rebuilt from their value
+static bool canonicalNumber(const std::string& id, uint64_t& value) {
+    return bidIdNumber(id, value) && (id.size() == 1 || id[0] != '0');
+}
+
+// Memory of a Bid object: the struct, plus strings too long to be stored inside it
+static uint64_t plainBytes(const Bid& bid) {
+    auto heap = [](const std::string& s) {
+        return s.size() > std::string().capacity() ? s.size() + 1 : 0;
+    };
+    return sizeof(Bid) + heap(bid.bidId) + heap(bid.title) + heap(bid.fund);
+}
+
+// Walks a block's ID column
+class IdCursor {
+public:
+    explicit IdCursor(const char* ids) : p(ids) {}
+
+    // Even tags are the difference from the previous numeric ID, odd
+    // tags the length of an ID stored as text
+    void Next(std::string& id) {
+        const uint64_t tag = getVarint(p);
+        if (tag & 1) {
+            id.assign(p, tag >> 1);
+            p += tag >> 1;
+        } else {
+            previous += tag >> 1;
+            id = std::to_string(previous);
+        }
+    }
+
+private:
+    const char* p;
+    uint64_t previous = 0;
+};
+
+// ---------------------------------------------------------------------------
+// TitleSymbols
+// ---------------------------------------------------------------------------
+
+size_t TitleSymbols::longestMatch(std::string_view text, size_t at) const {
+    for (uint8_t code : byFirstByte[static_cast<uint8_t>(text[at])]) {
+        const std::string& s = symbols[code];
+        if (s.size() <= text.size() - at && text.compare(at, s.size(), s) == 0) {
+            return code;
+        }
+    }
+    return kMaxSymbols;
+}
+
+/**
+ * FSST's bottom-up training, simplified: compress the sample with the
+ * current table, credit each symbol used and each pair of neighbouring
+ * symbols (if together they fit in 8 bytes) with the bytes they cover,
+ * and keep the 255 candidates with the most. A few rounds grow common
+ * words out of the letters they start from.
+ **/
+void TitleSymbols::Train(const std::vector<std::string_view>& sample) {
+    auto index = [this]() {
+        for (std::vector<uint8_t>& codes : byFirstByte) codes.clear();
+        for (size_t code = 0; code < symbols.size(); code++) {
+            byFirstByte[static_cast<uint8_t>(symbols[code][0])].push_back(static_cast<uint8_t>(code));
+        }
+        for (std::vector<uint8_t>& codes : byFirstByte) {
+            std::stable_sort(codes.begin(), codes.end(),
+                             [this](uint8_t a, uint8_t b) { return symbols[a].size() > symbols[b].size(); });
+        }
+    };
+
+    symbols.clear();
+    index();
+    for (int round = 0; round < kTrainRounds; round++) {
+        std::unordered_map<std::string, uint64_t> gain;
+        for (std::string_view text : sample) {
+            std::string_view previous;
+            for (size_t at = 0; at < text.size();) {
+                const size_t code = longestMatch(text, at);
+                const std::string_view current = code == kMaxSymbols ? text.substr(at, 1)
+                                                                     : std::string_view(symbols[code]);
+                gain[std::string(current)] += current.size();
+                if (!previous.empty() && previous.size() + current.size() <= kMaxLength) {
+                    std::string pair(previous);
+                    pair.append(current);
+                    gain[pair] += pair.size();
+                }
+                previous = current;
+                at += current.size();
+            }
+        }
+
+        std::vector<std::pair<uint64_t, std::string>> ranked;
+        ranked.reserve(gain.size());
+        for (auto& [symbol, bytes] : gain) {
+            ranked.emplace_back(bytes, symbol);
+        }
+        const size_t keep = std::min(ranked.size(), kMaxSymbols);
+        std::partial_sort(ranked.begin(), ranked.begin() + keep, ranked.end(),
+                          [](const auto& a, const auto& b) {
+                              return a.first != b.first ? a.first > b.first : a.second < b.second;
+                          });
+        symbols.clear();
+        for (size_t i = 0; i < keep; i++) {
+            symbols.push_back(std::move(ranked[i].second));
+        }
+        index();
+    }
+}
+
+void TitleSymbols::Encode(std::string_view text, std::string& out) const {
+    for (size_t at = 0; at < text.size();) {
+        const size_t code = longestMatch(text, at);
+        if (code == kMaxSymbols) {
+            out.push_back(static_cast<char>(kEscape));
+            out.push_back(text[at++]);
+        } else {
+            out.push_back(static_cast<char>(code));
+            at += symbols[code].size();
+        }
+    }
+}
+
+std::string TitleSymbols::Decode(std::string_view code) const {
+    std::string text;
+    text.reserve(code.size() * 2);
+    for (size_t i = 0; i < code.size(); i++) {
+        const uint8_t c = static_cast<uint8_t>(code[i]);
+        if (c == kEscape) {
+            text.push_back(code[++i]);
+        } else {
+            text.append(symbols[c]);
+        }
+    }
+    return text;
+}
+
+uint64_t TitleSymbols::Bytes() const {
+    uint64_t bytes = sizeof(*this) + symbols.capacity() * sizeof(std::string);   // symbols fit inside
+    for (const std::vector<uint8_t>& codes : byFirstByte) {
+        bytes += codes.size();
+    }
+    return bytes;
+}
+
+// ---------------------------------------------------------------------------
+// BidCompressedStore
+// ---------------------------------------------------------------------------
+
+void BidCompressedStore::Append(const Bid& bid) {
+    queue(bid, false);
+}
+
+void BidCompressedStore::Prepend(const Bid& bid) {
+    queue(bid, true);
+}
+
+void BidCompressedStore::queue(const Bid& bid, bool front) {
+    Queued q{bid, front, sequence++};
+    if (q.bid.titleSource != nullptr) {   // a lazy title is compressed like any other
+        q.bid.title = q.bid.Title();
+        q.bid.titleSource = nullptr;
+    }
+    queued.push_back(std::move(q));
+    count++;
+}
+
+uint32_t BidCompressedStore::fundCode(const std::string& fund) const {
+    auto [it, added] = fundCodes.try_emplace(fund, static_cast<uint32_t>(funds.size()));
+    if (added) {
+        funds.push_back(fund);
+    }
+    return it->second;
+}
+
+/**
+ * Block layout, each column starting at the offset kept in the Block:
+ *   IDs      varint tag per bid (see IdCursor)
+ *   amounts  u8 0, varint zigzag lowest cents, u8 width, packed cents above it
+ *            - or u8 1 and the doubles as they are
+ *   funds    u8 width, packed dictionary codes
+ *   lengths  varint per bid: bytes of its compressed title
+ *   titles   the compressed titles back to back
+ **/
+BidCompressedStore::Block BidCompressedStore::encode(const Bid* bids, size_t n) const {
+    Block block;
+    block.firstId = bids[0].bidId;
+    block.count = static_cast<uint32_t>(n);
+    std::string& out = block.data;
+
+    uint64_t previous = 0;
+    for (size_t i = 0; i < n; i++) {
+        const std::string& id = bids[i].bidId;
+        uint64_t value;
+        if (canonicalNumber(id, value) && value >= previous && value - previous < (uint64_t(1) << 63)) {
+            putVarint(out, (value - previous) << 1);
+            previous = value;
+        } else {
+            putVarint(out, (static_cast<uint64_t>(id.size()) << 1) | 1);
+            out.append(id);
+        }
+    }
+
+    block.amountsAt = static_cast<uint32_t>(out.size());
+    std::vector<uint64_t> packed(n);
+    std::vector<int64_t> cents(n);
+    bool whole = true;
+    for (size_t i = 0; i < n && whole; i++) {
+        whole = wholeCents(bids[i].amount, cents[i]);
+    }
+    const int64_t low = whole ? *std::min_element(cents.begin(), cents.end()) : 0;
+    const int64_t high = whole ? *std::max_element(cents.begin(), cents.end()) : 0;
+    const unsigned centBits = bitsFor(static_cast<uint64_t>(high) - static_cast<uint64_t>(low));
+    if (whole && centBits <= kMaxCentBits) {
+        out.push_back(0);
+        putVarint(out, zigzag(low));
+        out.push_back(static_cast<char>(centBits));
+        for (size_t i = 0; i < n; i++) {
+            packed[i] = static_cast<uint64_t>(cents[i]) - static_cast<uint64_t>(low);
+        }
+        putBits(out, packed, centBits);
+    } else {
+        out.push_back(1);
+        for (size_t i = 0; i < n; i++) {
+            char raw[sizeof(double)];
+            std::memcpy(raw, &bids[i].amount, sizeof(double));
+            out.append(raw, sizeof(double));
+        }
+    }
+
+    block.fundsAt = static_cast<uint32_t>(out.size());
+    uint32_t highest = 0;
+    for (size_t i = 0; i < n; i++) {
+        packed[i] = fundCode(bids[i].fund);
+        highest = std::max(highest, static_cast<uint32_t>(packed[i]));
+    }
+    const unsigned fundBits = bitsFor(highest);
+    out.push_back(static_cast<char>(fundBits));
+    putBits(out, packed, fundBits);
+
+    std::string titles;
+    block.lengthsAt = static_cast<uint32_t>(out.size());
+    uint64_t plain = 0;
+    for (size_t i = 0; i < n; i++) {
+        const size_t before = titles.size();
+        symbols.Encode(bids[i].Title(), titles);
+        putVarint(out, titles.size() - before);
+        plain += plainBytes(bids[i]);
+    }
+    block.titlesAt = static_cast<uint32_t>(out.size());
+    out.append(titles);
+    out.shrink_to_fit();
+    block.plainBytes = static_cast<uint32_t>(std::min<uint64_t>(plain, UINT32_MAX));
+    return block;
+}
+
+void BidCompressedStore::encodeAll(std::vector<Bid>& bids, std::vector<Block>& out) const {
+    const size_t n = bids.size();
+    const size_t parts = (n + kBlockBids - 1) / kBlockBids;
+    for (size_t p = 0; p < parts; p++) {
+        const size_t from = p * n / parts;
+        out.push_back(encode(bids.data() + from, (p + 1) * n / parts - from));
+    }
+}
+
+void BidCompressedStore::decode(const Block& block, std::vector<Bid>& out) const {
+    out.resize(block.count);
+    const char* data = block.data.data();
+
+    IdCursor ids(data);
+    for (Bid& bid : out) {
+        ids.Next(bid.bidId);
+    }
+
+    const char* amounts = data + block.amountsAt;
+    if (amounts[0] == 0) {
+        const char* p = amounts + 1;
+        const int64_t low = unzigzag(getVarint(p));
+        const unsigned bits = static_cast<uint8_t>(*p++);
+        for (uint32_t i = 0; i < block.count; i++) {
+            out[i].amount = static_cast<double>(low + static_cast<int64_t>(getBits(p, i, bits))) / 100.0;
+        }
+    } else {
+        for (uint32_t i = 0; i < block.count; i++) {
+            std::memcpy(&out[i].amount, amounts + 1 + i * sizeof(double), sizeof(double));
+        }
+    }
+
+    const char* codes = data + block.fundsAt + 1;
+    const unsigned fundBits = static_cast<uint8_t>(data[block.fundsAt]);
+    const char* lengths = data + block.lengthsAt;
+    const char* titles = data + block.titlesAt;
+    for (uint32_t i = 0; i < block.count; i++) {
+        out[i].fund = funds[getBits(codes, i, fundBits)];
+        const uint64_t length = getVarint(lengths);
+        out[i].title = symbols.Decode(std::string_view(titles, length));
+        titles += length;
+    }
+}
+
+/**
+ * One record without decoding the rest of its block: walk the IDs and
+ * title lengths up to it, and read its amount and fund code directly.
+ **/
+Bid BidCompressedStore::decodeRecord(const Block& block, uint32_t slot) const {
+    Bid bid;
+    const char* data = block.data.data();
+    IdCursor ids(data);
+    for (uint32_t i = 0; i <= slot; i++) {
+        ids.Next(bid.bidId);
+    }
+
+    const char* amounts = data + block.amountsAt;
+    if (amounts[0] == 0) {
+        const char* p = amounts + 1;
+        const int64_t low = unzigzag(getVarint(p));
+        const unsigned bits = static_cast<uint8_t>(*p++);
+        bid.amount = static_cast<double>(low + static_cast<int64_t>(getBits(p, slot, bits))) / 100.0;
+    } else {
+        std::memcpy(&bid.amount, amounts + 1 + slot * sizeof(double), sizeof(double));
+    }
+
+    bid.fund = funds[getBits(data + block.fundsAt + 1, slot, static_cast<uint8_t>(data[block.fundsAt]))];
+
+    const char* lengths = data + block.lengthsAt;
+    const char* titles = data + block.titlesAt;
+    for (uint32_t i = 0; i < slot; i++) {
+        titles += getVarint(lengths);
+    }
+    bid.title = symbols.Decode(std::string_view(titles, getVarint(lengths)));
+    return bid;
+}
+
+void BidCompressedStore::train(const std::vector<std::string_view>& titles) const {
+    uint64_t total = 0;
+    for (std::string_view t : titles) total += t.size();
+    const size_t stride = std::max<uint64_t>(1, total / kSampleBytes);
+    std::vector<std::string_view> sample;
+    for (size_t i = 0; i < titles.size(); i += stride) {
+        sample.push_back(titles[i]);
+    }
+    symbols.Train(sample);
+    trainedOn = std::max<size_t>(titles.size(), 1);
+}
+
+/**
+ * The queue sorted into store order, then each block it reaches is
+ * decoded, merged with its share of the queue and re-encoded (split in
+ * two or more if it outgrows kBlockBids). Blocks it doesn't reach are
+ * kept as they are.
+ **/
+void BidCompressedStore::merge() const {
+    if (queued.empty()) {
+        return;
+    }
+    std::vector<Queued> in;
+    in.swap(queued);
+    if (trainedOn == 0) {
+        std::vector<std::string_view> titles;
+        for (const Queued& q : in) titles.push_back(q.bid.title);
+        train(titles);
+    }
+
+    // Equal IDs: prepends before the stored ones (latest first), appends after
+    std::stable_sort(in.begin(), in.end(), [](const Queued& a, const Queued& b) {
+        if (bidIdLess(a.bid.bidId, b.bid.bidId)) return true;
+        if (bidIdLess(b.bid.bidId, a.bid.bidId)) return false;
+        if (a.front != b.front) return a.front;
+        return a.front ? a.sequence > b.sequence : a.sequence < b.sequence;
+    });
+    auto precedes = [](const Queued& q, const std::string& id) {
+        return bidIdLess(q.bid.bidId, id) || (q.front && !bidIdLess(id, q.bid.bidId));
+    };
+
+    std::vector<Block> out;
+    std::vector<Bid> merged, stored;
+    size_t next = 0;
+    for (size_t b = 0; b < blocks.size(); b++) {
+        size_t end = next;
+        if (b + 1 == blocks.size()) {
+            end = in.size();
+        } else {
+            while (end < in.size() && precedes(in[end], blocks[b + 1].firstId)) end++;
+        }
+        if (end == next) {
+            out.push_back(std::move(blocks[b]));
+            continue;
+        }
+
+        decode(blocks[b], stored);
+        merged.clear();
+        for (Bid& bid : stored) {
+            while (next < end && precedes(in[next], bid.bidId)) merged.push_back(std::move(in[next++].bid));
+            merged.push_back(std::move(bid));
+        }
+        while (next < end) merged.push_back(std::move(in[next++].bid));
+        encodeAll(merged, out);
+    }
+    if (blocks.empty()) {
+        for (Queued& q : in) merged.push_back(std::move(q.bid));
+        encodeAll(merged, out);
+    }
+    blocks.swap(out);
+
+    if (trainedOn < kRetrainBelow && static_cast<size_t>(count) >= 2 * trainedOn) {
+        rebuild();
+    }
+}
+
+// A table trained on the first few bids entered by hand would be kept
+// for a whole load after them; retrain while the store is still small
+void BidCompressedStore::rebuild() const {
+    std::vector<Bid> all, stored;
+    all.reserve(count);
+    for (const Block& block : blocks) {
+        decode(block, stored);
+        std::move(stored.begin(), stored.end(), std::back_inserter(all));
+    }
+    std::vector<std::string_view> titles;
+    for (const Bid& bid : all) titles.push_back(bid.title);
+    train(titles);
+    blocks.clear();
+    encodeAll(all, blocks);
+}
+
+size_t BidCompressedStore::firstBlockFor(const std::string& bidId) const {
+    auto it = std::lower_bound(blocks.begin(), blocks.end(), bidId, [](const Block& block, const std::string& id) {
+        return bidIdLess(block.firstId, id);
+    });
+    // Equal IDs can also end the block before
+    const size_t b = static_cast<size_t>(it - blocks.begin());
+    return b == 0 ? 0 : b - 1;
+}
+
+// "7" and "007" sort together; step over equal-sorting IDs to the exact one
+bool BidCompressedStore::find(const std::string& bidId, size_t& block, uint32_t& slot) const {
+    merge();
+    std::string id;
+    for (size_t b = firstBlockFor(bidId); b < blocks.size(); b++) {
+        IdCursor ids(blocks[b].data.data());
+        for (uint32_t i = 0; i < blocks[b].count; i++) {
+            ids.Next(id);
+            if (id == bidId) {
+                block = b;
+                slot = i;
+                return true;
+            }
+            if (bidIdLess(bidId, id)) {
+                return false;
+            }
+        }
+    }
+    return false;
+}
+
+bool BidCompressedStore::Remove(const std::string& bidId) {
+    size_t b;
+    uint32_t slot;
+    if (!find(bidId, b, slot)) {
+        return false;
+    }
+    std::vector<Bid> stored;
+    decode(blocks[b], stored);
+    stored.erase(stored.begin() + slot);
+    if (stored.empty()) {
+        blocks.erase(blocks.begin() + static_cast<std::ptrdiff_t>(b));
+    } else {
+        blocks[b] = encode(stored.data(), stored.size());
+    }
+    count--;
+    return true;
+}
+
+Bid BidCompressedStore::Search(const std::string& bidId) const {
+    size_t b;
+    uint32_t slot;
+    if (!find(bidId, b, slot)) {
+        return Bid{};
+    }
+    return decodeRecord(blocks[b], slot);
+}
+
+void BidCompressedStore::ForEach(const std::function<void(const Bid&)>& visit) const {
+    merge();
+    std::vector<Bid> stored;
+    for (const Block& block : blocks) {
+        decode(block, stored);
+        for (const Bid& bid : stored) {
+            visit(bid);
+        }
+    }
+}
+
+void BidCompressedStore::ForEachInRange(const std::string& first, const std::string& last,
+                                        const std::function<void(const Bid&)>& visit) const {
+    merge();
+    std::vector<Bid> stored;
+    for (size_t b = firstBlockFor(first); b < blocks.size(); b++) {
+        if (bidIdLess(last, blocks[b].firstId)) {
+            return;
+        }
+        decode(blocks[b], stored);
+        for (const Bid& bid : stored) {
+            if (bidIdLess(last, bid.bidId)) {
+                return;
+            }
+            if (!bidIdLess(bid.bidId, first)) {
+                visit(bid);
+            }
+        }
+    }
+}
+
+// Fund codes are compared in place; only matching records are decoded
+void BidCompressedStore::ForEachInFund(const std::string& fund,
+                                       const std::function<void(const Bid&)>& visit) const {
+    merge();
+    auto it = fundCodes.find(fund);
+    if (it == fundCodes.end()) {
+        return;
+    }
+    for (const Block& block : blocks) {
+        const char* codes = block.data.data() + block.fundsAt;
+        for (uint32_t i = 0; i < block.count; i++) {
+            if (getBits(codes + 1, i, static_cast<uint8_t>(codes[0])) == it->second) {
+                visit(decodeRecord(block, i));
+            }
+        }
+    }
+}
+
+int BidCompressedStore::FundSize(const std::string& fund) const {
+    merge();
+    auto it = fundCodes.find(fund);
+    if (it == fundCodes.end()) {
+        return 0;
+    }
+    int matches = 0;
+    for (const Block& block : blocks) {
+        const char* codes = block.data.data() + block.fundsAt;
+        for (uint32_t i = 0; i < block.count; i++) {
+            matches += getBits(codes + 1, i, static_cast<uint8_t>(codes[0])) == it->second;
+        }
+    }
+    return matches;
+}
+
+size_t BidCompressedStore::ForEachParallel(unsigned threads,
+                                           const std::function<void(size_t part, const Bid&)>& visit) const {
+    merge();
+    const size_t n = blocks.size();
+    const size_t parts = std::min<size_t>(ResolveThreads(threads), n);
+    if (parts <= 1) {
+        return BidStore::ForEachParallel(threads, visit);
+    }
+
+    std::vector<std::exception_ptr> errors(parts);
+    auto walk = [&](size_t part) {
+        try {
+            std::vector<Bid> stored;
+            for (size_t b = part * n / parts; b < (part + 1) * n / parts; b++) {
+                decode(blocks[b], stored);
+                for (const Bid& bid : stored) {
+                    visit(part, bid);
+                }
+            }
+        } catch (...) {
+            errors[part] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t p = 1; p < parts; p++) {
+        workers.emplace_back(walk, p);
+    }
+    walk(0);
+    for (std::thread& t : workers) {
+        t.join();
+    }
+    for (std::exception_ptr& e : errors) {
+        if (e) std::rethrow_exception(e);
+    }
+    return parts;
+}
+
+CompressedStats BidCompressedStore::Stats() const {
+    merge();
+    CompressedStats stats;
+    stats.bids = static_cast<size_t>(count);
+    stats.blocks = blocks.size();
+    stats.bytes = blocks.capacity() * sizeof(Block) + symbols.Bytes();
+    for (const Block& block : blocks) {
+        stats.bytes += block.data.capacity();
+        if (block.firstId.size() > std::string().capacity()) stats.bytes += block.firstId.capacity() + 1;
+        stats.plainBytes += block.plainBytes;
+    }
+    for (const std::string& fund : funds) {
+        stats.bytes += 2 * (sizeof(std::string) + fund.size()) + sizeof(uint32_t);
+    }
+    stats.symbols = symbols.Size();
+    stats.funds = funds.size();
+    return stats;
+}
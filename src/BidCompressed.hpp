@@ -0,0 +1,147 @@
+//============================================================================
+// Name        : BidCompressed.hpp
+//
+// Bid store kept sorted by ID (see bidIdLess) in compressed blocks of 128
+// bids. Selected with --store=compressed.
+//
+// Why? An archive of bids is mostly read, and as Bid objects every bid
+// costs over a hundred bytes of struct, strings and allocator overhead.
+// Here each block stores its columns encoded separately:
+//
+// - IDs: sorted, so numeric IDs are stored as the varint difference from
+//   the previous one (usually one byte). Other IDs are stored as text.
+// - Amounts: whole cents, minus the block's lowest, bit-packed at the
+//   width the block needs. A block with an amount that isn't whole cents
+//   keeps its amounts as doubles.
+// - Funds: a code into the store's fund dictionary, bit-packed.
+// - Titles: compressed with one static symbol table (FSST-style): up to
+//   255 common substrings of 1-8 bytes, each written as a one-byte code,
+//   other bytes escaped. The table is trained on a sample of the first
+//   titles loaded. Each title is compressed on its own, so one record's
+//   title is decoded without its neighbours.
+//
+// A lookup binary searches the block directory (each block's first ID),
+// walks the block's IDs and decodes the one record it finds. Scans decode
+// a block at a time into a reused buffer, and fund queries compare codes
+// without decoding titles at all.
+//
+// Edits are batched: Append/Prepend only queue the bid, and the queue is
+// merged into the blocks by the next read, re-encoding only the blocks it
+// lands in. Remove re-encodes one block.
+//
+// One thread at a time, including the const calls (they can merge the
+// queue); ForEachParallel decodes blocks on several threads once merged.
+//============================================================================
+
+#ifndef BID_COMPRESSED_HPP
+#define BID_COMPRESSED_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "BidStore.hpp"
+
+struct CompressedStats {
+    size_t   bids        = 0;
+    size_t   blocks      = 0;
+    uint64_t bytes       = 0;   // encoded blocks, directory, symbol table and fund dictionary
+    uint64_t plainBytes  = 0;   // the same bids as Bid objects, estimated
+    size_t   symbols     = 0;   // in the title symbol table
+    size_t   funds       = 0;   // in the fund dictionary
+};
+
+// Static symbol table for short strings (FSST-style). Code 255 escapes
+// one literal byte; codes below it stand for a symbol of 1-8 bytes.
+class TitleSymbols {
+public:
+    static constexpr size_t kMaxSymbols = 255;
+    static constexpr size_t kMaxLength  = 8;
+
+    // Builds the table from a sample of strings; replaces any previous one
+    void Train(const std::vector<std::string_view>& sample);
+    void Encode(std::string_view text, std::string& out) const;   // appends
+    std::string Decode(std::string_view code) const;
+    size_t Size() const { return symbols.size(); }
+    uint64_t Bytes() const;
+
+private:
+    size_t longestMatch(std::string_view text, size_t at) const;   // code, or kMaxSymbols
+
+    std::vector<std::string> symbols;
+    std::array<std::vector<uint8_t>, 256> byFirstByte;   // codes, longest symbol first
+};
+
+class BidCompressedStore : public BidStore {
+public:
+    static constexpr uint32_t kBlockBids = 128;
+
+    BidCompressedStore() = default;
+
+    // Both insert in ID order. Among equal IDs, Append goes after the
+    // existing ones and Prepend before them, like the list.
+    void Append(const Bid& bid) override;
+    void Prepend(const Bid& bid) override;
+    bool Remove(const std::string& bidId) override;
+    Bid Search(const std::string& bidId) const override;
+    int Size() const override { return count; }
+    void ForEach(const std::function<void(const Bid&)>& visit) const override;
+
+    void ForEachInFund(const std::string& fund, const std::function<void(const Bid&)>& visit) const override;
+    int FundSize(const std::string& fund) const override;
+    void ForEachInRange(const std::string& first, const std::string& last,
+                        const std::function<void(const Bid&)>& visit) const override;
+    // Runs of whole blocks, each thread decoding its own
+    size_t ForEachParallel(unsigned threads,
+                           const std::function<void(size_t part, const Bid&)>& visit) const override;
+
+    CompressedStats Stats() const;
+
+private:
+    // Byte offsets of each column in 'data'
+    struct Block {
+        std::string          firstId;   // directory key
+        uint32_t             count      = 0;
+        uint32_t             amountsAt  = 0;
+        uint32_t             fundsAt    = 0;
+        uint32_t             lengthsAt  = 0;
+        uint32_t             titlesAt   = 0;
+        uint32_t             plainBytes = 0;
+        std::string          data;
+    };
+    struct Queued {
+        Bid      bid;
+        bool     front;      // from Prepend
+        uint64_t sequence;
+    };
+
+    void queue(const Bid& bid, bool front);
+    void merge() const;                         // the queue into the blocks
+    void train(const std::vector<std::string_view>& titles) const;
+    void rebuild() const;                       // re-encode everything with a new table
+
+    Block encode(const Bid* bids, size_t n) const;
+    void encodeAll(std::vector<Bid>& bids, std::vector<Block>& out) const;   // in blocks of at most kBlockBids
+    void decode(const Block& block, std::vector<Bid>& out) const;
+    Bid decodeRecord(const Block& block, uint32_t slot) const;
+    uint32_t fundCode(const std::string& fund) const;
+
+    size_t firstBlockFor(const std::string& bidId) const;   // the first that can hold it
+    bool find(const std::string& bidId, size_t& block, uint32_t& slot) const;
+
+    int count = 0;
+    uint64_t sequence = 0;
+    mutable std::vector<Queued> queued;
+    mutable std::vector<Block> blocks;
+    mutable TitleSymbols symbols;
+    mutable size_t trainedOn = 0;               // titles the table was trained from (0: none yet)
+    mutable std::vector<std::string> funds;     // dictionary: code -> fund
+    mutable std::unordered_map<std::string, uint32_t> fundCodes;
+};
+
+#endif // BID_COMPRESSED_HPP
@@ -0,0 +1,200 @@
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+
+#include "BidDiff.hpp"
+#include "BidHash.hpp"
+
+// One hash over every compared field; equal hashes mean "unchanged"
+static uint64_t fieldsHash(const Bid& bid) {
+    uint64_t amountBits;
+    std::memcpy(&amountBits, &bid.amount, sizeof amountBits);
+    uint64_t h = hash64(bid.Title());
+    h = hash64(bid.fund, h);
+    return mixHash64(h ^ amountBits);
+}
+
+// Which fields differ; called only when the field hashes disagree
+static unsigned changedFields(const Bid& before, const Bid& after) {
+    unsigned fields = 0;
+    if (before.Title() != after.Title()) fields |= BidChange::TITLE;
+    if (before.fund != after.fund)       fields |= BidChange::FUND;
+    if (before.amount != after.amount)   fields |= BidChange::AMOUNT;
+    return fields;
+}
+
+static void compareMatched(const Bid& before, const Bid& after, BidDiffResult& out) {
+    if (fieldsHash(before) == fieldsHash(after)) {
+        return;
+    }
+    unsigned fields = changedFields(before, after);
+    if (fields != 0) {
+        out.changed.push_back({before, after, fields});
+    }
+}
+
+static bool sortedById(const std::vector<Bid>& bids) {
+    for (size_t i = 1; i < bids.size(); i++) {
+        if (bidIdLess(bids[i].bidId, bids[i - 1].bidId)) return false;
+    }
+    return true;
+}
+
+/**
+ * Both sides sorted: advance whichever side has the smaller ID.
+ * Equal IDs are a match; a smaller ID with no partner was added/removed.
+ */
+static void mergeJoin(const std::vector<Bid>& before, const std::vector<Bid>& after, BidDiffResult& out) {
+    size_t i = 0, j = 0;
+    while (i < before.size() && j < after.size()) {
+        const Bid& b = before[i];
+        const Bid& a = after[j];
+        if (bidIdLess(b.bidId, a.bidId)) {
+            out.removed.push_back(b);
+            i++;
+        } else if (bidIdLess(a.bidId, b.bidId)) {
+            out.added.push_back(a);
+            j++;
+        } else {
+            compareMatched(b, a, out);
+            i++;
+            j++;
+        }
+    }
+    out.removed.insert(out.removed.end(), before.begin() + i, before.end());
+    out.added.insert(out.added.end(), after.begin() + j, after.end());
+}
+
+// The ID as the joins compare it: bidIdLess takes "007" and "7" as equal,
+// so all-digit IDs lose their leading zeros (keeping one digit for "000")
+static std::string_view joinKey(const std::string& id) {
+    if (id.empty() || !std::all_of(id.begin(), id.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+        return id;
+    }
+    size_t start = std::min(id.find_first_not_of('0'), id.size() - 1);
+    return std::string_view(id).substr(start);
+}
+
+// Key for the per-partition table: the precomputed hash travels with the ID
+struct HashedId {
+    uint64_t         hash;
+    std::string_view id;
+    bool operator==(const HashedId& other) const { return id == other.id; }
+};
+
+struct HashedIdHasher {
+    size_t operator()(const HashedId& key) const { return static_cast<size_t>(key.hash); }
+};
+
+// First and last unmatched "before" record carrying an ID
+struct Chain {
+    uint32_t head;
+    uint32_t tail;
+};
+
+/**
+ * Unsorted input: partitioned hash join.
+ * 1. hash every ID (in parallel chunks)
+ * 2. bucket record numbers by hash into one partition per thread
+ * 3. each thread builds a table over its "before" partition, probes it with
+ *    its "after" partition, and whatever is left unmatched was removed
+ */
+static void hashJoin(const std::vector<Bid>& before, const std::vector<Bid>& after,
+                     unsigned threads, BidDiffResult& out) {
+    auto hashAll = [threads](const std::vector<Bid>& bids) {
+        std::vector<uint64_t> hashes(bids.size());
+        std::vector<std::thread> workers;
+        size_t chunk = (bids.size() + threads - 1) / threads;
+        for (unsigned t = 0; t < threads; t++) {
+            size_t lo = t * chunk, hi = std::min(bids.size(), lo + chunk);
+            if (lo >= hi) break;
+            workers.emplace_back([&, lo, hi] {
+                for (size_t k = lo; k < hi; k++) hashes[k] = hash64(joinKey(bids[k].bidId));
+            });
+        }
+        for (auto& w : workers) w.join();
+        return hashes;
+    };
+    std::vector<uint64_t> beforeHash = hashAll(before);
+    std::vector<uint64_t> afterHash = hashAll(after);
+
+    const unsigned partitions = threads;
+    std::vector<std::vector<uint32_t>> beforeParts(partitions), afterParts(partitions);
+    for (size_t k = 0; k < before.size(); k++) {
+        beforeParts[beforeHash[k] % partitions].push_back(static_cast<uint32_t>(k));
+    }
+    for (size_t k = 0; k < after.size(); k++) {
+        afterParts[afterHash[k] % partitions].push_back(static_cast<uint32_t>(k));
+    }
+
+    // Exports can repeat an ID. Repeats are chained in file order through
+    // 'nextSame' and paired with the repeats on the other side one by one,
+    // the same way the merge join pairs them.
+    const uint32_t none = UINT32_MAX;
+    std::vector<uint32_t> nextSame(before.size(), none);
+
+    std::vector<BidDiffResult> partial(partitions);
+    std::vector<std::thread> workers;
+    for (unsigned p = 0; p < partitions; p++) {
+        workers.emplace_back([&, p] {
+            BidDiffResult& res = partial[p];
+            std::unordered_map<HashedId, Chain, HashedIdHasher> table;
+            table.reserve(beforeParts[p].size());
+            for (uint32_t k : beforeParts[p]) {
+                auto [it, inserted] = table.try_emplace({beforeHash[k], joinKey(before[k].bidId)}, Chain{k, k});
+                if (!inserted) {
+                    nextSame[it->second.tail] = k;
+                    it->second.tail = k;
+                }
+            }
+            for (uint32_t k : afterParts[p]) {
+                auto it = table.find({afterHash[k], joinKey(after[k].bidId)});
+                if (it == table.end()) {
+                    res.added.push_back(after[k]);
+                    continue;
+                }
+                compareMatched(before[it->second.head], after[k], res);
+                it->second.head = nextSame[it->second.head];
+                if (it->second.head == none) {
+                    table.erase(it);
+                }
+            }
+            for (const auto& left : table) {
+                for (uint32_t k = left.second.head; k != none; k = nextSame[k]) {
+                    res.removed.push_back(before[k]);
+                }
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    for (auto& res : partial) {
+        out.added.insert(out.added.end(), res.added.begin(), res.added.end());
+        out.removed.insert(out.removed.end(), res.removed.begin(), res.removed.end());
+        out.changed.insert(out.changed.end(), res.changed.begin(), res.changed.end());
+    }
+}
+
+BidDiffResult diffBids(const std::vector<Bid>& before, const std::vector<Bid>& after, unsigned threads) {
+    BidDiffResult result;
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    if (sortedById(before) && sortedById(after)) {
+        result.usedMergeJoin = true;
+        mergeJoin(before, after, result);
+        return result;
+    }
+
+    hashJoin(before, after, threads, result);
+
+    auto byId = [](const Bid& a, const Bid& b) { return bidIdLess(a.bidId, b.bidId); };
+    std::sort(result.added.begin(), result.added.end(), byId);
+    std::sort(result.removed.begin(), result.removed.end(), byId);
+    std::sort(result.changed.begin(), result.changed.end(),
+              [](const BidChange& a, const BidChange& b) { return bidIdLess(a.after.bidId, b.after.bidId); });
+    return result;
+}
@@ -0,0 +1,49 @@
+//============================================================================
+// Name        : BidDiff.hpp
+//
+// Reconciles two exports: which bids were added, removed or changed.
+//
+// Why two strategies?
+// - Both inputs sorted by ID (exports usually are): a merge join walks them
+//   side by side once, no hash table, no extra memory.
+// - Otherwise: records are split into partitions by a hash of their ID,
+//   and each thread joins one partition of "before" against the same
+//   partition of "after". Partitions share nothing, so no locks are needed.
+//
+// Each record's compared fields (title, fund, amount) are folded into one
+// 64-bit hash first, so unchanged records cost one integer compare.
+//============================================================================
+
+#ifndef BID_DIFF_HPP
+#define BID_DIFF_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Bid.hpp"
+
+struct BidChange {
+    enum Field : unsigned {
+        TITLE  = 1,
+        FUND   = 2,
+        AMOUNT = 4
+    };
+
+    Bid      before;
+    Bid      after;
+    unsigned fields = 0;   // bitmask of Field values that differ
+};
+
+struct BidDiffResult {
+    std::vector<Bid>       added;     // only in "after"
+    std::vector<Bid>       removed;   // only in "before"
+    std::vector<BidChange> changed;   // in both, with different fields
+    bool                   usedMergeJoin = false;
+};
+
+// Results come back sorted by ID either way. threads = 0 uses every core.
+BidDiffResult diffBids(const std::vector<Bid>& before, const std::vector<Bid>& after,
+                       unsigned threads = 0);
+
+#endif // BID_DIFF_HPP
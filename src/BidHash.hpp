@@ -0,0 +1,38 @@
+//============================================================================
+// Name        : BidHash.hpp
+//
+// 64-bit string hashing shared by the sketches and hash-based structures.
+//
+// Why not std::hash? Its output differs between standard libraries and is
+// allowed to change between runs, so two loaders could not merge their
+// sketches. FNV-1a is simple and stable; the MurmurHash3 finalizer on top
+// spreads its weak low bits so every bit of the result is usable.
+//============================================================================
+
+#ifndef BID_HASH_HPP
+#define BID_HASH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// MurmurHash3 64-bit finalizer: every input bit affects every output bit
+inline uint64_t mixHash64(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDull;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+inline uint64_t hash64(std::string_view text, uint64_t seed = 0) {
+    uint64_t h = 0xCBF29CE484222325ull ^ mixHash64(seed);
+    for (unsigned char c : text) {
+        h ^= c;
+        h *= 0x100000001B3ull;
+    }
+    return mixHash64(h);
+}
+
+#endif // BID_HASH_HPP
@@ -0,0 +1,417 @@
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+#include "BidHash.hpp"
+#include "BidIndex.hpp"
+
+// Slot meta: bits 0-1 state, bit 2 long ID, bits 8-15 inline length,
+// bits 16-63 the top of the ID's hash
+static constexpr uint64_t kEmpty     = 0;
+static constexpr uint64_t kErased    = 1;
+static constexpr uint64_t kLive      = 2;
+static constexpr uint64_t kStateMask = 3;
+static constexpr uint64_t kLongKey   = 4;
+
+#ifdef BID_INDEX_TESTING
+#define TEST_POINT(name) (BidIdIndex::testHook ? BidIdIndex::testHook(name) : void())
+#else
+#define TEST_POINT(name) ((void)0)
+#endif
+
+static constexpr size_t kMinCapacity   = 64;
+static constexpr size_t kMigrateGroups = 4;   // moved per write while resizing
+
+static size_t roundUpPow2(size_t n) {
+    return std::bit_ceil(n < kMinCapacity ? kMinCapacity : n);
+}
+
+// Probing starts from the hash bits kept in the meta, so a slot can be
+// re-homed in a bigger table without the ID's full hash
+static size_t homeSlot(size_t mask, uint64_t hashOrMeta) {
+    return (hashOrMeta >> 16) & mask;
+}
+
+BidIdIndex::Table::Table(size_t cap)
+    : capacity(cap),
+      mask(cap - 1),
+      slots(new Slot[cap]()),
+      versions(new std::atomic<uint64_t>[cap / kGroupSlots]()) {
+}
+
+BidIdIndex::BidIdIndex(size_t expected, unsigned stripeCount) {
+    const size_t count = std::bit_ceil(stripeCount != 0 ? stripeCount : 1u);
+    stripes.reset(new Stripe[count]);
+    stripeMask = count - 1;
+
+    tables.push_back(std::make_unique<Table>(roundUpPow2(expected * 2)));
+    current.store(tables.back().get(), std::memory_order_release);
+}
+
+size_t BidIdIndex::Capacity() const {
+    const Table* n = next.load(std::memory_order_acquire);
+    return (n != nullptr ? n : current.load(std::memory_order_acquire))->capacity;
+}
+
+BidIdIndex::Probe BidIdIndex::makeProbe(const std::string& bidId) {
+    Probe p{};
+    p.hash = hash64(bidId);
+    p.id = &bidId;
+    p.meta = (p.hash & ~uint64_t{0xFFFF}) | kLive;
+    if (bidId.size() > kInlineKey) {
+        p.meta |= kLongKey;
+    } else {
+        p.meta |= uint64_t{bidId.size()} << 8;
+        std::memcpy(p.key, bidId.data(), bidId.size());
+    }
+    return p;
+}
+
+/**
+ * Seqlock read: note the group's version, copy the slot, and check the
+ * version again. An odd version means a writer is inside the group; a
+ * changed one means the copy may be torn. Either way, read again.
+ **/
+void BidIdIndex::readSlot(const Table& t, size_t pos, SlotImage& out) {
+    const std::atomic<uint64_t>& version = t.versions[pos / kGroupSlots];
+    const Slot& slot = t.slots[pos];
+    for (;;) {
+        const uint64_t before = version.load(std::memory_order_acquire);
+        if (before & 1) {
+            std::this_thread::yield();
+            continue;
+        }
+        out.meta  = slot.meta.load(std::memory_order_relaxed);
+        out.key0  = slot.key[0].load(std::memory_order_relaxed);
+        out.key1  = slot.key[1].load(std::memory_order_relaxed);
+        out.value = slot.value.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (version.load(std::memory_order_relaxed) == before) {
+            return;
+        }
+    }
+}
+
+bool BidIdIndex::matches(const SlotImage& s, const Probe& p) {
+    if (s.meta != p.meta) {
+        return false;
+    }
+    if (p.meta & kLongKey) {
+        // Long IDs are never freed while the index lives, so this is safe
+        // even if the slot has been reused since it was read
+        return *reinterpret_cast<const std::string*>(s.key0) == *p.id;
+    }
+    return s.key0 == p.key[0] && s.key1 == p.key[1];
+}
+
+/**
+ * Walks from the ID's home slot to the first empty one. Erased slots are
+ * stepped over: the ID may have been placed past them before they were
+ * erased.
+ **/
+bool BidIdIndex::lookup(const Table& t, const Probe& p, uint64_t& value) {
+    size_t pos = homeSlot(t.mask, p.hash);
+    for (size_t step = 0; step < t.capacity; step++, pos = (pos + 1) & t.mask) {
+        SlotImage s;
+        readSlot(t, pos, s);
+        if ((s.meta & kStateMask) == kEmpty) {
+            return false;
+        }
+        if (matches(s, p)) {
+            value = s.value;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Lock-free: reads only. If the ID is missing, the lookup is repeated
+ * when a resize started or finished meanwhile, since the ID may have
+ * moved out of the table that was searched.
+ **/
+bool BidIdIndex::Find(const std::string& bidId, uint64_t& value) const {
+    const Probe p = makeProbe(bidId);
+    for (;;) {
+        const uint64_t before = epoch.load(std::memory_order_acquire);
+        // 'next' before 'current': the resize ends by setting 'current'
+        // and only then clearing 'next', so a null 'next' means 'current'
+        // is already the table that holds every ID. (A null 'next' from
+        // before a resize started is covered by the epoch check.)
+        const Table* n = next.load(std::memory_order_acquire);
+        TEST_POINT("find:tables");
+        const Table* t = current.load(std::memory_order_acquire);
+
+        // Old table first: a moving ID is copied to the new table before
+        // its old slot is erased, so it is always found in one of them
+        if (lookup(*t, p, value) || (n != nullptr && lookup(*n, p, value))) {
+            return true;
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (epoch.load(std::memory_order_relaxed) == before) {
+            return false;
+        }
+    }
+}
+
+void BidIdIndex::lockGroup(std::atomic<uint64_t>& version) {
+    uint64_t v = version.load(std::memory_order_relaxed);
+    for (;;) {
+        if (v & 1) {
+            std::this_thread::yield();
+            v = version.load(std::memory_order_relaxed);
+        } else if (version.compare_exchange_weak(v, v + 1, std::memory_order_acquire,
+                                                 std::memory_order_relaxed)) {
+            break;
+        }
+    }
+    // Slot stores must not become visible before the odd version
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+void BidIdIndex::unlockGroup(std::atomic<uint64_t>& version) {
+    version.fetch_add(1, std::memory_order_release);
+}
+
+void BidIdIndex::writeSlot(Table& t, size_t pos, uint64_t meta, uint64_t key0, uint64_t key1,
+                           uint64_t value) {
+    Slot& slot = t.slots[pos];
+    slot.key[0].store(key0, std::memory_order_relaxed);
+    slot.key[1].store(key1, std::memory_order_relaxed);
+    slot.value.store(value, std::memory_order_relaxed);
+    slot.meta.store(meta, std::memory_order_relaxed);
+}
+
+uint64_t BidIdIndex::keepLongKey(const std::string& bidId) {
+    std::lock_guard<std::mutex> guard(longKeysLock);
+    longKeys.push_back(std::make_unique<std::string>(bidId));
+    return reinterpret_cast<uint64_t>(longKeys.back().get());
+}
+
+/**
+ * Adds the ID to 't', or replaces its value there. The caller holds the
+ * ID's stripe, so nobody else adds or erases this ID meanwhile; writers
+ * of other IDs may still take the free slot we picked, in which case we
+ * look again.
+ **/
+bool BidIdIndex::place(Table& t, const Probe& p, uint64_t value) {
+    for (;;) {
+        size_t pos = homeSlot(t.mask, p.hash);
+        size_t freeSlot = t.capacity;
+        for (size_t step = 0; step < t.capacity; step++, pos = (pos + 1) & t.mask) {
+            SlotImage s;
+            readSlot(t, pos, s);
+            const uint64_t state = s.meta & kStateMask;
+            if (state == kEmpty) {
+                if (freeSlot == t.capacity) freeSlot = pos;
+                break;
+            }
+            if (state == kErased && freeSlot == t.capacity) {
+                freeSlot = pos;
+            } else if (matches(s, p)) {
+                std::atomic<uint64_t>& version = t.versions[pos / kGroupSlots];
+                lockGroup(version);
+                t.slots[pos].value.store(value, std::memory_order_relaxed);
+                unlockGroup(version);
+                return false;
+            }
+        }
+        if (freeSlot == t.capacity) {
+            throw std::runtime_error("BidIndex : table full");   // resizing keeps it at most 3/4 full
+        }
+
+        std::atomic<uint64_t>& version = t.versions[freeSlot / kGroupSlots];
+        lockGroup(version);
+        const uint64_t state = t.slots[freeSlot].meta.load(std::memory_order_relaxed) & kStateMask;
+        if (state == kLive) {
+            unlockGroup(version);   // another ID got there first
+            continue;
+        }
+        const uint64_t key0 = (p.meta & kLongKey) ? keepLongKey(*p.id) : p.key[0];
+        writeSlot(t, freeSlot, p.meta, key0, p.key[1], value);
+        unlockGroup(version);
+        if (state == kEmpty) {
+            t.used.fetch_add(1, std::memory_order_relaxed);
+        }
+        return true;
+    }
+}
+
+bool BidIdIndex::update(Table& t, const Probe& p, uint64_t value) {
+    size_t pos = homeSlot(t.mask, p.hash);
+    for (size_t step = 0; step < t.capacity; step++, pos = (pos + 1) & t.mask) {
+        SlotImage s;
+        readSlot(t, pos, s);
+        if ((s.meta & kStateMask) == kEmpty) {
+            return false;
+        }
+        if (matches(s, p)) {
+            std::atomic<uint64_t>& version = t.versions[pos / kGroupSlots];
+            lockGroup(version);
+            t.slots[pos].value.store(value, std::memory_order_relaxed);
+            unlockGroup(version);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool BidIdIndex::erase(Table& t, const Probe& p) {
+    size_t pos = homeSlot(t.mask, p.hash);
+    for (size_t step = 0; step < t.capacity; step++, pos = (pos + 1) & t.mask) {
+        SlotImage s;
+        readSlot(t, pos, s);
+        if ((s.meta & kStateMask) == kEmpty) {
+            return false;
+        }
+        if (matches(s, p)) {
+            std::atomic<uint64_t>& version = t.versions[pos / kGroupSlots];
+            lockGroup(version);
+            t.slots[pos].meta.store(kErased, std::memory_order_relaxed);
+            unlockGroup(version);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * 'current' and 'next' only change while every stripe is held, so they
+ * stay put for as long as we hold ours. While resizing, an ID not yet
+ * moved is updated where it is; new IDs go to the new table.
+ **/
+bool BidIdIndex::Insert(const std::string& bidId, uint64_t value) {
+    const Probe p = makeProbe(bidId);
+    bool added;
+    {
+        std::lock_guard<std::mutex> guard(stripes[p.hash & stripeMask].lock);
+        Table* t = current.load(std::memory_order_relaxed);
+        Table* n = next.load(std::memory_order_relaxed);
+        if (n != nullptr) {
+            added = !update(*t, p, value) && place(*n, p, value);
+        } else {
+            added = place(*t, p, value);
+        }
+    }
+    if (added) {
+        live.fetch_add(1, std::memory_order_relaxed);
+    }
+    maintain();
+    return added;
+}
+
+bool BidIdIndex::Erase(const std::string& bidId) {
+    const Probe p = makeProbe(bidId);
+    bool erased;
+    {
+        std::lock_guard<std::mutex> guard(stripes[p.hash & stripeMask].lock);
+        Table* t = current.load(std::memory_order_relaxed);
+        Table* n = next.load(std::memory_order_relaxed);
+        erased = erase(*t, p) || (n != nullptr && erase(*n, p));
+    }
+    if (erased) {
+        live.fetch_sub(1, std::memory_order_relaxed);
+    }
+    maintain();
+    return erased;
+}
+
+/**
+ * Runs after each write, with no stripe held: starts a resize, or moves
+ * the next few groups of one. Every write while resizing does its share,
+ * so the old table is empty before the new one can fill up.
+ **/
+void BidIdIndex::maintain() {
+    const Table* t = current.load(std::memory_order_relaxed);
+    if (next.load(std::memory_order_relaxed) == nullptr &&
+        t->used.load(std::memory_order_relaxed) * 4 <= t->capacity * 3) {
+        return;
+    }
+    std::lock_guard<std::mutex> guard(resizeLock);
+    lockAllStripes();
+    t = current.load(std::memory_order_relaxed);   // may have moved on while we waited
+    if (next.load(std::memory_order_relaxed) != nullptr) {
+        migrateSome();
+    } else if (t->used.load(std::memory_order_relaxed) * 4 > t->capacity * 3) {
+        startResize();
+    }
+    unlockAllStripes();
+}
+
+void BidIdIndex::lockAllStripes() {
+    for (size_t s = 0; s <= stripeMask; s++) {
+        stripes[s].lock.lock();
+    }
+}
+
+void BidIdIndex::unlockAllStripes() {
+    for (size_t s = stripeMask + 1; s-- > 0;) {
+        stripes[s].lock.unlock();
+    }
+}
+
+/**
+ * Sized for four times the live IDs: twice as big when the table is full
+ * of them, smaller (at most by half) when it is mostly erased slots.
+ * 'next' is published before the epoch moves: a reader whose first
+ * epoch read sees the new epoch then also sees the new table. A reader
+ * that started earlier and saw no new table finds the epoch changed once
+ * IDs start moving, and looks again.
+ **/
+void BidIdIndex::startResize() {
+    const Table& from = *current.load(std::memory_order_relaxed);
+    const size_t wanted = std::max(live.load(std::memory_order_relaxed) * 4, from.capacity / 2);
+    tables.push_back(std::make_unique<Table>(roundUpPow2(wanted)));
+    migrated = 0;
+    next.store(tables.back().get(), std::memory_order_release);
+    epoch.fetch_add(1, std::memory_order_release);
+}
+
+/**
+ * Moves kMigrateGroups groups of the old table: each live ID is copied
+ * to the new table, then erased from the old one. With every stripe held
+ * no writer is about; readers carry on, using the group versions. After
+ * the last group the new table becomes current.
+ **/
+void BidIdIndex::migrateSome() {
+    Table& from = *current.load(std::memory_order_relaxed);
+    Table& to = *next.load(std::memory_order_relaxed);
+    const size_t groups = from.capacity / kGroupSlots;
+
+    for (size_t g = 0; g < kMigrateGroups && migrated < groups; g++, migrated++) {
+        std::atomic<uint64_t>& version = from.versions[migrated];
+        lockGroup(version);
+        for (size_t pos = migrated * kGroupSlots; pos < (migrated + 1) * kGroupSlots; pos++) {
+            Slot& slot = from.slots[pos];
+            const uint64_t meta = slot.meta.load(std::memory_order_relaxed);
+            if ((meta & kStateMask) != kLive) {
+                continue;
+            }
+
+            // The ID is not in 'to' yet, so the first free slot will do
+            size_t dest = homeSlot(to.mask, meta);
+            while ((to.slots[dest].meta.load(std::memory_order_relaxed) & kStateMask) == kLive) {
+                dest = (dest + 1) & to.mask;
+            }
+            std::atomic<uint64_t>& destVersion = to.versions[dest / kGroupSlots];
+            lockGroup(destVersion);
+            if (to.slots[dest].meta.load(std::memory_order_relaxed) == kEmpty) {
+                to.used.fetch_add(1, std::memory_order_relaxed);
+            }
+            writeSlot(to, dest, meta, slot.key[0].load(std::memory_order_relaxed),
+                      slot.key[1].load(std::memory_order_relaxed), slot.value.load(std::memory_order_relaxed));
+            unlockGroup(destVersion);
+            slot.meta.store(kErased, std::memory_order_relaxed);
+        }
+        unlockGroup(version);
+    }
+
+    if (migrated == groups) {
+        epoch.fetch_add(1, std::memory_order_release);
+        TEST_POINT("resize:finishing");
+        current.store(&to, std::memory_order_release);
+        next.store(nullptr, std::memory_order_release);
+    }
+}
@@ -0,0 +1,135 @@
+//============================================================================
+// Name        : BidIndex.hpp
+//
+// Concurrent ID index: bid ID -> 64-bit value (a row number, a handle),
+// for many reader threads while a loader thread writes.
+//
+// Why not unordered_map behind a lock? Every lookup would then write to
+// the lock's cache line, so readers slow each other down even when nobody
+// writes. Here a lookup writes nothing at all:
+//
+// - Open addressing, linear probing. A slot holds 48 bits of the ID's
+//   hash, the ID inline (up to 16 bytes; longer IDs point to a heap copy)
+//   and the value - 32 bytes, two slots per cache line, no node to chase.
+// - Slots come in groups of 8, each group with a version counter
+//   (seqlock). A writer makes the version odd, changes the slot, and makes
+//   it even again. A reader notes the version, reads the slot, and reads
+//   it again if the version moved meanwhile.
+// - Writers lock one of 64 stripes, picked by the ID's hash, so two
+//   writers of the same ID take turns, while writers of different IDs
+//   only meet on the group they both write to.
+// - Growing is incremental. When the table gets 3/4 full a new one is
+//   allocated, and every write after that moves a few groups across
+//   (writers take turns for that; readers don't wait).
+//   Meanwhile lookups check the old table and then the new one, and a
+//   lookup that raced with the start or end of a resize is repeated.
+//   Old tables are kept until the index is destroyed, since a reader may
+//   still be in one; as tables double, the old ones add up to less than
+//   the current one.
+//
+// Long IDs (over 16 bytes) stay on the heap until the index is destroyed
+// too, even once erased - a reader may be comparing against one.
+//============================================================================
+
+#ifndef BID_INDEX_HPP
+#define BID_INDEX_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class BidIdIndex {
+public:
+    explicit BidIdIndex(size_t expected = 0, unsigned stripes = kStripes);
+
+    BidIdIndex(const BidIdIndex&) = delete;
+    BidIdIndex& operator=(const BidIdIndex&) = delete;
+
+    // Add the ID, or replace its value. @return true if it was new
+    bool Insert(const std::string& bidId, uint64_t value);
+    bool Erase(const std::string& bidId);                        // false if absent
+    bool Find(const std::string& bidId, uint64_t& value) const;  // never locks
+
+    size_t Size() const { return live.load(std::memory_order_relaxed); }
+    size_t Capacity() const;          // slots in the newest table
+    bool   Resizing() const { return next.load(std::memory_order_acquire) != nullptr; }
+
+#ifdef BID_INDEX_TESTING
+    // Test seam: called at the points named in BidIndex.cpp where another
+    // thread's step decides what a lookup sees. Only in test builds.
+    static inline std::function<void(const char* point)> testHook;
+#endif
+
+    static constexpr size_t   kGroupSlots = 8;
+    static constexpr size_t   kInlineKey  = 16;
+    static constexpr unsigned kStripes    = 64;
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> meta;      // state, inline length, hash tag
+        std::atomic<uint64_t> key[2];    // ID bytes, or key[0] = const std::string*
+        std::atomic<uint64_t> value;
+    };
+    struct Table {
+        explicit Table(size_t capacity);
+        size_t                                   capacity;
+        size_t                                   mask;
+        std::unique_ptr<Slot[]>                  slots;
+        std::unique_ptr<std::atomic<uint64_t>[]> versions;   // one per group
+        std::atomic<size_t>                      used{0};    // live + erased slots
+    };
+    // What a lookup compares a slot against
+    struct Probe {
+        uint64_t           hash;
+        uint64_t           meta;
+        uint64_t           key[2];
+        const std::string* id;
+    };
+    // A consistent copy of one slot
+    struct SlotImage {
+        uint64_t meta, key0, key1, value;
+    };
+    struct alignas(64) Stripe {
+        std::mutex lock;
+    };
+
+    static Probe makeProbe(const std::string& bidId);
+    static void readSlot(const Table& t, size_t pos, SlotImage& out);
+    static bool matches(const SlotImage& s, const Probe& p);
+    static bool lookup(const Table& t, const Probe& p, uint64_t& value);
+    static void lockGroup(std::atomic<uint64_t>& version);
+    static void unlockGroup(std::atomic<uint64_t>& version);
+
+    bool place(Table& t, const Probe& p, uint64_t value);
+    bool update(Table& t, const Probe& p, uint64_t value);
+    bool erase(Table& t, const Probe& p);
+    void writeSlot(Table& t, size_t pos, uint64_t meta, uint64_t key0, uint64_t key1, uint64_t value);
+    uint64_t keepLongKey(const std::string& bidId);
+
+    void maintain();
+    void lockAllStripes();
+    void unlockAllStripes();
+    void startResize();
+    void migrateSome();
+
+    std::unique_ptr<Stripe[]> stripes;
+    size_t                    stripeMask;
+
+    std::atomic<Table*>   current{nullptr};
+    std::atomic<Table*>   next{nullptr};       // set while resizing
+    std::atomic<uint64_t> epoch{0};            // bumped when a resize starts or ends
+    std::atomic<size_t>   live{0};
+
+    std::mutex                                resizeLock;   // one thread resizes at a time
+    size_t                                    migrated = 0; // groups of 'current' moved so far
+    std::vector<std::unique_ptr<Table>>       tables;       // every table ever used
+    std::mutex                                longKeysLock;
+    std::vector<std::unique_ptr<std::string>> longKeys;
+};
+
+#endif // BID_INDEX_HPP
@@ -0,0 +1,232 @@
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "BidHash.hpp"
+#include "BidJoin.hpp"
+#include "MappedCsv.hpp"
+
+// A key's hash and the row it came from; this is what gets partitioned
+struct JoinKeyRow {
+    uint64_t hash;
+    uint32_t row;
+};
+
+static constexpr unsigned kMaxPassBits  = 8;   // fan-out per partitioning pass
+static constexpr unsigned kMaxTotalBits = 16;  // two passes
+static constexpr uint32_t kEmptySlot    = UINT32_MAX;
+
+/**
+ * One partitioning pass over src[lo, hi): count how many rows land in each
+ * partition, turn the counts into start offsets, then copy every row to
+ * its partition's next free slot in dst.
+ * @return fan-out + 1 boundaries; partition p is [b[p], b[p+1])
+ */
+static std::vector<size_t> scatterPass(const JoinKeyRow* src, JoinKeyRow* dst, size_t lo, size_t hi,
+                                       unsigned shift, unsigned bits) {
+    const size_t fanout = size_t(1) << bits;
+    const uint64_t mask = fanout - 1;
+
+    std::vector<size_t> bounds(fanout + 1, 0);
+    for (size_t i = lo; i < hi; i++) {
+        bounds[((src[i].hash >> shift) & mask) + 1]++;
+    }
+    bounds[0] = lo;
+    for (size_t p = 1; p <= fanout; p++) {
+        bounds[p] += bounds[p - 1];
+    }
+
+    std::vector<size_t> next(bounds.begin(), bounds.end() - 1);
+    for (size_t i = lo; i < hi; i++) {
+        dst[next[(src[i].hash >> shift) & mask]++] = src[i];
+    }
+    return bounds;
+}
+
+// Reorder rows into 2^bits partitions by the low hash bits; returns boundaries
+static std::vector<size_t> radixPartition(std::vector<JoinKeyRow>& rows, unsigned bits) {
+    if (bits == 0) {
+        return {0, rows.size()};
+    }
+    const unsigned firstBits = std::min(bits, kMaxPassBits);
+    const unsigned secondBits = bits - firstBits;
+
+    std::vector<JoinKeyRow> scratch(rows.size());
+    std::vector<size_t> first = scatterPass(rows.data(), scratch.data(), 0, rows.size(), 0, firstBits);
+    if (secondBits == 0) {
+        rows.swap(scratch);
+        return first;
+    }
+
+    // Second pass splits each first-pass partition in place (back into 'rows')
+    std::vector<size_t> bounds;
+    bounds.reserve((size_t(1) << bits) + 1);
+    for (size_t p = 0; p + 1 < first.size(); p++) {
+        std::vector<size_t> sub = scatterPass(scratch.data(), rows.data(), first[p], first[p + 1],
+                                              firstBits, secondBits);
+        bounds.insert(bounds.end(), sub.begin(), sub.end() - 1);
+    }
+    bounds.push_back(rows.size());
+    return bounds;
+}
+
+static std::vector<JoinKeyRow> hashKeys(const std::vector<std::string_view>& keys) {
+    std::vector<JoinKeyRow> rows(keys.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+        rows[i] = {hash64(keys[i]), static_cast<uint32_t>(i)};
+    }
+    return rows;
+}
+
+std::vector<JoinPair> hashJoinKeys(const std::vector<std::string_view>& left,
+                                   const std::vector<std::string_view>& right,
+                                   JoinStats* stats, size_t cacheBytes) {
+    const bool buildLeft = left.size() <= right.size();
+    const auto& buildKeys = buildLeft ? left : right;
+    const auto& probeKeys = buildLeft ? right : left;
+
+    std::vector<JoinKeyRow> build = hashKeys(buildKeys);
+    std::vector<JoinKeyRow> probe = hashKeys(probeKeys);
+
+    // Per build row: its JoinKeyRow plus two table slots (load factor <= 1/2)
+    const size_t tableBytes = build.size() * (sizeof(JoinKeyRow) + 2 * sizeof(uint32_t));
+    unsigned bits = 0;
+    while ((tableBytes >> bits) > cacheBytes && bits < kMaxTotalBits) {
+        bits++;
+    }
+    std::vector<size_t> buildBounds = radixPartition(build, bits);
+    std::vector<size_t> probeBounds = radixPartition(probe, bits);
+
+    std::vector<JoinPair> pairs;
+    std::vector<uint32_t> slots;
+    for (size_t p = 0; p + 1 < buildBounds.size(); p++) {
+        const JoinKeyRow* b = build.data() + buildBounds[p];
+        const size_t nb = buildBounds[p + 1] - buildBounds[p];
+        if (nb == 0) {
+            continue;
+        }
+
+        // Open addressing with linear probing. Equal keys simply take
+        // consecutive slots, so a probe sees every duplicate on its way to
+        // the next empty slot. The low 'bits' bits are the same for the
+        // whole partition, so the slot comes from the bits above them.
+        size_t capacity = 2;
+        while (capacity < 2 * nb) capacity <<= 1;
+        const uint64_t mask = capacity - 1;
+        slots.assign(capacity, kEmptySlot);
+        for (uint32_t i = 0; i < nb; i++) {
+            uint64_t s = (b[i].hash >> bits) & mask;
+            while (slots[s] != kEmptySlot) s = (s + 1) & mask;
+            slots[s] = i;
+        }
+
+        for (size_t j = probeBounds[p]; j < probeBounds[p + 1]; j++) {
+            const JoinKeyRow& q = probe[j];
+            for (uint64_t s = (q.hash >> bits) & mask; slots[s] != kEmptySlot; s = (s + 1) & mask) {
+                const JoinKeyRow& m = b[slots[s]];
+                if (m.hash == q.hash && buildKeys[m.row] == probeKeys[q.row]) {
+                    pairs.push_back(buildLeft ? JoinPair{m.row, q.row} : JoinPair{q.row, m.row});
+                }
+            }
+        }
+    }
+
+    std::sort(pairs.begin(), pairs.end(), [](const JoinPair& a, const JoinPair& b) {
+        return a.left != b.left ? a.left < b.left : a.right < b.right;
+    });
+
+    if (stats != nullptr) {
+        stats->partitions = buildBounds.size() - 1;
+        stats->builtOnLeft = buildLeft;
+    }
+    return pairs;
+}
+
+//----------------------------------------------------------------------------
+// CSV files
+//----------------------------------------------------------------------------
+
+// A mapped CSV's rows as field spans, 'columns' spans per row
+struct JoinCsvRows {
+    std::vector<FieldSpan> header;
+    std::vector<FieldSpan> fields;
+    size_t columns = 0;
+
+    size_t count() const { return columns == 0 ? 0 : fields.size() / columns; }
+    const FieldSpan& at(size_t row, size_t col) const { return fields[row * columns + col]; }
+};
+
+static JoinCsvRows readCsvRows(const MappedFile& file, size_t keyColumn) {
+    JoinCsvRows rows;
+    rows.header = scanCsvHeader(file, ',');
+    rows.columns = rows.header.size();
+    if (keyColumn >= rows.columns) {
+        throw std::runtime_error("join key column " + std::to_string(keyColumn)
+                                 + " missing in " + file.path());
+    }
+    scanCsvRows(file, ',', [&](const std::vector<FieldSpan>& f) {
+        rows.fields.insert(rows.fields.end(), f.begin(), f.end());
+    });
+    return rows;
+}
+
+// " \"97988\" " -> "97988": exports pad some fields with spaces
+static std::string normalizeKey(std::string_view raw) {
+    auto trim = [](std::string_view v) {
+        while (!v.empty() && v.front() == ' ') v.remove_prefix(1);
+        while (!v.empty() && v.back() == ' ') v.remove_suffix(1);
+        return v;
+    };
+    std::string key = unquoteCsvField(trim(raw));
+    return std::string(trim(key));
+}
+
+static std::vector<std::string> keyColumn(const MappedFile& file, const JoinCsvRows& rows, size_t col) {
+    std::vector<std::string> keys(rows.count());
+    for (size_t r = 0; r < keys.size(); r++) {
+        const FieldSpan& f = rows.at(r, col);
+        keys[r] = normalizeKey(file.view(f.offset, f.length));
+    }
+    return keys;
+}
+
+static void writeFields(std::ostream& out, const MappedFile& file, const FieldSpan* fields,
+                        size_t count, size_t skip, bool& first) {
+    for (size_t c = 0; c < count; c++) {
+        if (c == skip) continue;
+        if (!first) out << ',';
+        out << file.view(fields[c].offset, fields[c].length);
+        first = false;
+    }
+}
+
+CsvJoinResult joinCsvFiles(const MappedFile& left, size_t leftKey,
+                           const MappedFile& right, size_t rightKey,
+                           std::ostream& out, size_t cacheBytes) {
+    JoinCsvRows leftRows = readCsvRows(left, leftKey);
+    JoinCsvRows rightRows = readCsvRows(right, rightKey);
+
+    // Views are taken only once the key vectors are complete
+    std::vector<std::string> leftKeys = keyColumn(left, leftRows, leftKey);
+    std::vector<std::string> rightKeys = keyColumn(right, rightRows, rightKey);
+    std::vector<std::string_view> leftViews(leftKeys.begin(), leftKeys.end());
+    std::vector<std::string_view> rightViews(rightKeys.begin(), rightKeys.end());
+
+    CsvJoinResult result;
+    result.leftRows = leftRows.count();
+    result.rightRows = rightRows.count();
+    std::vector<JoinPair> pairs = hashJoinKeys(leftViews, rightViews, &result.stats, cacheBytes);
+    result.joinedRows = pairs.size();
+
+    bool first = true;
+    writeFields(out, left, leftRows.header.data(), leftRows.columns, SIZE_MAX, first);
+    writeFields(out, right, rightRows.header.data(), rightRows.columns, rightKey, first);
+    out << '\n';
+    for (const JoinPair& p : pairs) {
+        first = true;
+        writeFields(out, left, &leftRows.fields[p.left * leftRows.columns], leftRows.columns, SIZE_MAX, first);
+        writeFields(out, right, &rightRows.fields[p.right * rightRows.columns], rightRows.columns, rightKey, first);
+        out << '\n';
+    }
+    return result;
+}
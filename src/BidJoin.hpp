@@ -0,0 +1,64 @@
+//============================================================================
+// Name        : BidJoin.hpp
+//
+// Joins two CSV exports on their auction ID column, e.g. the main export
+// with the December file, which adds InventoryID, VehicleID and
+// ReceiptNumber in a different column layout.
+//
+// How: a hash table is built on the smaller input's keys and probed with
+// the larger one's. Once that table no longer fits in cache, every probe
+// is a cache miss, so both inputs are first split by the low bits of the
+// key hash (radix partitioning) until each build partition's table fits.
+// Each partition is then joined on its own while it stays in cache. The
+// split takes at most two passes of at most 2^8 partitions each, so each
+// pass writes to few enough places for the TLB to keep up.
+//============================================================================
+
+#ifndef BID_JOIN_HPP
+#define BID_JOIN_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+class MappedFile;
+
+// About an L2 cache: the most a partition's hash table may take
+constexpr size_t kJoinCacheBytes = 256 * 1024;
+
+struct JoinPair {
+    uint32_t left;    // row number in the left input
+    uint32_t right;   // row number in the right input
+};
+
+struct JoinStats {
+    size_t partitions  = 1;     // 1 = the table fit in cache, no partitioning
+    bool   builtOnLeft = true;  // which input the table was built on
+};
+
+// Every (left, right) pair with equal keys, ordered by left then right
+std::vector<JoinPair> hashJoinKeys(const std::vector<std::string_view>& left,
+                                   const std::vector<std::string_view>& right,
+                                   JoinStats* stats = nullptr,
+                                   size_t cacheBytes = kJoinCacheBytes);
+
+struct CsvJoinResult {
+    size_t    leftRows  = 0;
+    size_t    rightRows = 0;
+    size_t    joinedRows = 0;
+    JoinStats stats;
+};
+
+/**
+ * Inner join of two CSV files on one column each (unquoted and trimmed
+ * before comparing). Writes the merged CSV to 'out': every left column,
+ * then every right column except its key, fields copied byte for byte.
+ * Throws std::runtime_error if a key column doesn't exist.
+ */
+CsvJoinResult joinCsvFiles(const MappedFile& left, size_t leftKey,
+                           const MappedFile& right, size_t rightKey,
+                           std::ostream& out, size_t cacheBytes = kJoinCacheBytes);
+
+#endif // BID_JOIN_HPP
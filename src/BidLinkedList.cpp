@@ -0,0 +1,537 @@
+#include <algorithm>
+#include <exception>
+#include <thread>
+
+#include "BidLinkedList.hpp"
+
+LinkedList::LinkedList(int segSize) : head(nullptr), tail(nullptr), size(0), segmentSize(std::max(1, segSize)) {}
+
+/**
+ * Destructor - must manually free all nodes we allocated with 'new'.
+ * Save next pointer BEFORE deleting current node, or we lose it.
+ */
+LinkedList::~LinkedList() {
+    Node* current = head;
+    while (current != nullptr) {
+        Node* nextNode = current->next;
+        delete current;
+        current = nextNode;
+    }
+}
+
+/**
+ * Append - O(1) thanks to tail pointer.
+ * This is why we maintain tail - CSV loading adds 12k bids sequentially.
+ */
+void LinkedList::Append(const Bid& bid) {
+    Node *newNode = new Node(bid);
+    if (head == nullptr) {
+        head = tail = newNode;
+    } else {
+        newNode->prev = tail;
+        tail->next = newNode;
+        tail = newNode;
+    }
+    LinkFund(newNode, false);
+    LinkId(newNode, false);
+    SegmentAdd(newNode, false);
+    frozen.reset();
+    size++;
+}
+
+/**
+  * Prepend:
+  * Prepend a new bid to the start of the list.
+  * Allocate a new node containing the bid.
+  * If the list is empty, set both head and tail to this node.
+  * Otherwise, link the new node so its next points to the current head,
+  * and the old head's prev points back to it,
+  * Update head to the new node
+  * Increment the size counter.
+**/
+void LinkedList::Prepend(const Bid& bid) {
+    Node *newNode = new Node(bid);
+    if (head == nullptr) {
+        head = tail = newNode;
+    } else {
+        newNode->next = head;
+        head->prev = newNode;
+        head = newNode;
+    }
+    LinkFund(newNode, true);
+    LinkId(newNode, true);
+    SegmentAdd(newNode, true);
+    frozen.reset();
+    size++;
+}
+
+/**
+ * Visit all bids in the list
+ * ForEach walks through the linked list from head to tail.
+ * For each node, it calls visit (e.g. displayBid to show the bid data),
+ * then moves on to the next node until the list ends.
+**/
+void LinkedList::ForEach(const std::function<void(const Bid&)>& visit) const {
+    Node *current = head;
+    while (current != nullptr) {
+        visit(current->bid);
+        current = current->next;
+    }
+}
+
+/**
+ * Remove a specified bid
+ * @param bidId The bid id to remove from the list
+ * Look the ID up in the index; if it's there, unlink that node.
+ * If the list is empty or the ID unknown, do nothing.
+ * @return true if a bid was removed
+**/
+bool LinkedList::Remove(const std::string& bidId) {
+    Handle handle = Find(bidId);
+    if (!handle) {
+        return false;
+    }
+    Remove(handle);
+    return true;
+}
+
+/**
+ * Remove the bid a handle points at - O(1), no walk.
+ * The neighbors are linked to each other (or head/tail moved if there is
+ * no neighbor on that side), the node leaves its fund chain and the ID
+ * index, and is deleted. The handle is invalid afterwards.
+**/
+void LinkedList::Remove(Handle handle) {
+    Node *node = handle.node;
+    if (node == nullptr) {
+        return;
+    }
+
+    SegmentRemove(node);   // needs node->next, so before unlinking
+    if (node->prev != nullptr) {
+        node->prev->next = node->next;
+    } else {
+        head = node->next;
+    }
+    if (node->next != nullptr) {
+        node->next->prev = node->prev;
+    } else {
+        tail = node->prev;
+    }
+
+    UnlinkFund(node);
+    UnlinkId(node);
+    delete node; // free node memory
+    frozen.reset();
+    size--;
+}
+
+/**
+ * Search for the specified bidId
+ * @param bidId The bid id to search for
+ * @return a copy of the first bid with that ID, or an empty Bid
+**/
+Bid LinkedList::Search(const std::string& bidId) const {
+    if (frozen) {
+        const Bid *bid = frozen->Find(bidId);
+        return bid ? *bid : Bid{};
+    }
+    Handle handle = Find(bidId);
+    return handle ? handle.bid() : Bid{}; // returns empty bid if no match found
+}
+
+/**
+ * Search for many IDs at once. Frozen, the lookups are interleaved so their
+ * memory waits overlap; otherwise it is one Search after another.
+ **/
+std::vector<Bid> LinkedList::SearchBatch(const std::vector<std::string>& bidIds) const {
+    if (!frozen) {
+        return BidStore::SearchBatch(bidIds);
+    }
+    std::vector<const Bid*> hits;
+    frozen->FindBatch(bidIds, hits);
+    std::vector<Bid> found;
+    found.reserve(hits.size());
+    for (const Bid *bid : hits) {
+        found.push_back(bid ? *bid : Bid{});
+    }
+    return found;
+}
+
+/**
+ * Handle to the first bid with this ID - average O(1) through the index
+ **/
+LinkedList::Handle LinkedList::Find(const std::string& bidId) const {
+    auto it = ids.find(bidId);
+    return it == ids.end() ? Handle() : Handle(it->second.first);
+}
+
+/**
+ * Ends of the list, for walking it with Handle::next() / Handle::prev()
+ **/
+LinkedList::Handle LinkedList::First() const {
+    return Handle(head);
+}
+
+LinkedList::Handle LinkedList::Last() const {
+    return Handle(tail);
+}
+
+/**
+ * Returns the current size (number of elements) in the list
+ **/
+int LinkedList::Size() const {
+    return size;
+}
+
+/**
+ * Copy of every bid in list order.
+ * Checkpointing hands this to a background thread, so the thread never
+ * reads nodes the menu might be removing at the same time.
+ **/
+std::vector<Bid> LinkedList::Snapshot() const {
+    std::vector<Bid> bids;
+    bids.reserve(size);
+    for (Node *current = head; current != nullptr; current = current->next) {
+        bids.push_back(current->bid);
+    }
+    return bids;
+}
+
+/**
+ * Ordered queries: straight from the sorted arrays when frozen, otherwise
+ * the scan-and-sort from BidStore
+ **/
+void LinkedList::ForEachInRange(const std::string& first, const std::string& last,
+                                const std::function<void(const Bid&)>& visit) const {
+    if (frozen) {
+        frozen->ForEachInRange(first, last, visit);
+    } else {
+        BidStore::ForEachInRange(first, last, visit);
+    }
+}
+
+void LinkedList::ForEachInAmountRange(double low, double high,
+                                      const std::function<void(const Bid&)>& visit) const {
+    if (frozen) {
+        frozen->ForEachInAmountRange(low, high, visit);
+    } else {
+        BidStore::ForEachInAmountRange(low, high, visit);
+    }
+}
+
+/**
+ * Parallel scan: part p walks segments [p*S/parts, (p+1)*S/parts), from
+ * its first segment's start up to the next part's start. The calling
+ * thread runs part 0. An exception from 'visit' is rethrown here once all
+ * parts have stopped.
+ **/
+size_t LinkedList::ForEachParallel(unsigned threads,
+                                   const std::function<void(size_t part, const Bid&)>& visit) const {
+    const size_t parts = std::min<size_t>(ResolveThreads(threads), segments.size());
+    if (parts <= 1) {
+        return BidStore::ForEachParallel(threads, visit);
+    }
+
+    std::vector<std::exception_ptr> errors(parts);
+    auto walk = [&](size_t part) {
+        const Node *end = (part + 1 < parts) ? segments[(part + 1) * segments.size() / parts] : nullptr;
+        try {
+            for (const Node *n = segments[part * segments.size() / parts]; n != end; n = n->next) {
+                visit(part, n->bid);
+            }
+        } catch (...) {
+            errors[part] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t p = 1; p < parts; p++) {
+        workers.emplace_back(walk, p);
+    }
+    walk(0);
+    for (std::thread &t : workers) {
+        t.join();
+    }
+    for (std::exception_ptr &e : errors) {
+        if (e) std::rethrow_exception(e);
+    }
+    return parts;
+}
+
+/**
+ * Count a new node into the first or last segment, opening a new segment
+ * with it when that one is full.
+ **/
+void LinkedList::SegmentAdd(Node *node, bool atFront) {
+    if (segments.empty()) {
+        segments.push_back(node);
+        node->segmentStart = true;
+        frontFill = backFill = 1;
+    } else if (atFront) {
+        if (frontFill >= segmentSize) {
+            segments.insert(segments.begin(), node);
+            frontFill = 0;
+        } else {
+            segments.front()->segmentStart = false;   // the segment now begins here
+            segments.front() = node;
+        }
+        node->segmentStart = true;
+        frontFill++;
+    } else if (backFill >= segmentSize) {
+        segments.push_back(node);
+        node->segmentStart = true;
+        backFill = 1;
+    } else {
+        backFill++;
+    }
+}
+
+/**
+ * A segment's first node is leaving: its successor takes over the mark,
+ * unless the segment has no other node. Only this case searches
+ * 'segments' - once per segmentSize removals at most, on average.
+ **/
+void LinkedList::SegmentRemove(Node *node) {
+    if (!node->segmentStart) {
+        return;
+    }
+    auto it = std::find(segments.begin(), segments.end(), node);
+    Node *successor = node->next;
+    if (successor != nullptr && !successor->segmentStart) {
+        *it = successor;
+        successor->segmentStart = true;
+        return;
+    }
+
+    // Last node of its segment. If that was an end segment, the next
+    // insert there opens a fresh one, since the neighbor's fill is unknown.
+    if (it == segments.begin()) frontFill = segmentSize;
+    if (it + 1 == segments.end()) backFill = segmentSize;
+    segments.erase(it);
+}
+
+/**
+ * Reorder the list by amount (lowest first) or by ID (bidIdLess order).
+ * Bids with equal keys keep their order. IDs that aren't numbers, or are
+ * too long for 64 bits, can't be radix keys; they already sort after all
+ * the others, so they are comparison-sorted on their own and put last.
+ **/
+void LinkedList::Sort(BidSortKey by, unsigned threads) {
+    if (size < 2) {
+        return;
+    }
+    std::vector<BidSortEntry> order, textIds;
+    order.reserve(size);
+    for (Node *current = head; current != nullptr; current = current->next) {
+        uint64_t key = 0;
+        if (by == BidSortKey::AMOUNT) {
+            order.push_back({amountSortKey(current->bid.amount), current});
+        } else if (bidIdNumber(current->bid.bidId, key)) {
+            order.push_back({key, current});
+        } else {
+            textIds.push_back({0, current});
+        }
+    }
+
+    radixSort(order, threads);
+    if (!textIds.empty()) {
+        std::stable_sort(textIds.begin(), textIds.end(), [](const BidSortEntry& a, const BidSortEntry& b) {
+            return bidIdLess(static_cast<Node*>(a.item)->bid.bidId, static_cast<Node*>(b.item)->bid.bidId);
+        });
+        order.insert(order.end(), textIds.begin(), textIds.end());
+    }
+    Relink(order);
+}
+
+/**
+ * Chain every node in 'order' and rebuild what depends on list order.
+ * The nodes are visited in sorted order, i.e. all over the heap, so each
+ * step prefetches the node a few entries ahead.
+ * Only nodes marked sharedId can change which node is first for their ID;
+ * the index is reset for those alone and refilled in the new order.
+ **/
+void LinkedList::Relink(const std::vector<BidSortEntry>& order) {
+    const size_t ahead = 8;
+    for (const BidSortEntry &e : order) {
+        Node *node = static_cast<Node*>(e.item);
+        if (node->sharedId) ids[node->bid.bidId].first = nullptr;
+    }
+    for (auto &entry : funds) {
+        entry.second = FundChain{};
+    }
+    for (Node *start : segments) {
+        start->segmentStart = false;
+    }
+    segments.clear();
+
+    Node *previous = nullptr;
+    for (size_t i = 0; i < order.size(); i++) {
+#if defined(__GNUC__)
+        if (i + ahead < order.size()) {
+            const Node *later = static_cast<const Node*>(order[i + ahead].item);
+            __builtin_prefetch(&later->bid.fund);   // read by LinkFund
+            __builtin_prefetch(&later->next);       // the links, a line further on
+        }
+#endif
+        Node *node = static_cast<Node*>(order[i].item);
+        node->prev = previous;
+        node->next = nullptr;
+        if (previous != nullptr) {
+            previous->next = node;
+        } else {
+            head = node;
+        }
+        node->fundNext = node->fundPrev = nullptr;
+        LinkFund(node, false);
+        if (node->sharedId) {
+            IdEntry &entry = ids[node->bid.bidId];
+            if (entry.first == nullptr) entry.first = node;
+        }
+        SegmentAdd(node, false);
+        previous = node;
+    }
+    tail = previous;
+    frozen.reset();
+}
+
+/**
+ * Every segmentStart mark is in 'segments', in list order, and the first
+ * segment starts at head. Walks the whole list; tests call it after edits.
+ **/
+bool LinkedList::SegmentsValid() const {
+    size_t k = 0;
+    for (const Node *n = head; n != nullptr; n = n->next) {
+        if (n->segmentStart) {
+            if (k >= segments.size() || segments[k] != n) return false;
+            k++;
+        }
+    }
+    return k == segments.size() && (head == nullptr || (!segments.empty() && segments[0] == head));
+}
+
+/**
+ * Build the read-optimized copy from the current contents.
+ * Freezing again after an edit rebuilds it from scratch - O(n log n).
+ **/
+void LinkedList::Freeze() {
+    frozen = std::make_unique<FrozenBids>(Snapshot());
+}
+
+/**
+ * Visit every bid from tail back to head (newest appends first)
+ **/
+void LinkedList::ForEachReverse(const std::function<void(const Bid&)>& visit) const {
+    for (Node *current = tail; current != nullptr; current = current->prev) {
+        visit(current->bid);
+    }
+}
+
+/**
+ * Hook a new node into its fund's chain.
+ * Appended nodes go last and prepended ones first, so each chain stays in
+ * the same order as the main list.
+ **/
+void LinkedList::LinkFund(Node *node, bool atFront) {
+    FundChain &chain = funds[node->bid.fund];
+    if (chain.head == nullptr) {
+        chain.head = chain.tail = node;
+    } else if (atFront) {
+        node->fundNext = chain.head;
+        chain.head->fundPrev = node;
+        chain.head = node;
+    } else {
+        node->fundPrev = chain.tail;
+        chain.tail->fundNext = node;
+        chain.tail = node;
+    }
+    chain.count++;
+}
+
+/**
+ * Take a node out of its fund's chain before it is deleted - O(1), same
+ * relinking as Remove(handle) but through fundNext/fundPrev.
+ * A fund whose last bid goes away is dropped from the table.
+ **/
+void LinkedList::UnlinkFund(Node *node) {
+    auto it = funds.find(node->bid.fund);
+    if (it == funds.end()) {
+        return;
+    }
+    FundChain &chain = it->second;
+
+    if (node->fundPrev != nullptr) {
+        node->fundPrev->fundNext = node->fundNext;
+    } else {
+        chain.head = node->fundNext;
+    }
+    if (node->fundNext != nullptr) {
+        node->fundNext->fundPrev = node->fundPrev;
+    } else {
+        chain.tail = node->fundPrev;
+    }
+    if (--chain.count == 0) {
+        funds.erase(it);
+    }
+}
+
+/**
+ * Record a new node in the ID index.
+ * A prepended duplicate becomes the first node for its ID; an appended one
+ * only bumps the count.
+ **/
+void LinkedList::LinkId(Node *node, bool atFront) {
+    IdEntry &entry = ids[node->bid.bidId];
+    if (entry.first != nullptr) {
+        node->sharedId = entry.first->sharedId = true;
+    }
+    if (entry.first == nullptr || atFront) {
+        entry.first = node;
+    }
+    entry.count++;
+}
+
+/**
+ * Drop a node from the ID index before it is deleted.
+ * If it was the first of several nodes with its ID, the next one further
+ * down the list takes over - the only walk left, and only for repeated IDs.
+ **/
+void LinkedList::UnlinkId(Node *node) {
+    auto it = ids.find(node->bid.bidId);
+    if (it == ids.end()) {
+        return;
+    }
+    IdEntry &entry = it->second;
+    if (--entry.count == 0) {
+        ids.erase(it);
+        return;
+    }
+    if (entry.first == node) {
+        Node *current = node->next;
+        while (current != nullptr && current->bid.bidId != node->bid.bidId) {
+            current = current->next;
+        }
+        entry.first = current;
+    }
+}
+
+/**
+ * Visit every bid of one fund, in list order, without touching the others
+ **/
+void LinkedList::ForEachInFund(const std::string& fund, const std::function<void(const Bid&)>& visit) const {
+    auto it = funds.find(fund);
+    if (it == funds.end()) {
+        return;
+    }
+    for (Node *current = it->second.head; current != nullptr; current = current->fundNext) {
+        visit(current->bid);
+    }
+}
+
+/**
+ * Number of bids in one fund, kept up to date by Append/Prepend/Remove
+ **/
+int LinkedList::FundSize(const std::string& fund) const {
+    auto it = funds.find(fund);
+    return it == funds.end() ? 0 : it->second.count;
+}
@@ -0,0 +1,176 @@
+//============================================================================
+// Name        : BidLinkedList.hpp
+//
+// The doubly linked bid list behind the menu, the default --store. It used
+// to live in LinkedList.cpp next to main; it has its own module so the
+// tests run the real class rather than a copy of it.
+//
+// Why a doubly linked list with both head AND tail pointers?
+// - Head pointer: required for traversal from the start
+// - Tail pointer: makes Append O(1) instead of O(n)
+// - Without tail, we'd have to walk the whole list to add to the end
+// - prev pointer: a node can unlink itself in O(1), no walk from head to
+//   find its predecessor; also lets us iterate backwards from tail
+//
+// Why track size separately?
+// - Avoids O(n) traversal just to count elements
+// - Used to show "12023 bids loaded" without re-counting
+//
+// Why handles?
+// - A Handle names one node and stays valid until that node is removed,
+//   so an index that stores handles can remove through Remove(handle)
+//   without searching. The ID index below is the first such index.
+//
+// Why a second 'fundNext'/'fundPrev' pair in every node?
+// - Listing one fund used to mean walking all 12k bids
+// - Each fund keeps its own head/tail, and fundNext chains that fund's
+//   nodes together, so one fund costs O(bids in that fund)
+// - The nodes themselves are shared: no extra allocation per bid, only
+//   two pointers, plus one table entry per distinct fund
+//
+// Why segments?
+// - A list can't be cut into pieces for threads without walking it first,
+//   and that walk is as long as the work itself
+// - 'segments' remembers the first node of every run of about
+//   segmentSize nodes, so ForEachParallel hands each thread a range of
+//   segments straight away
+// - Append/Prepend grow the last/first segment and open a new one once it
+//   is full; removing a segment's first node passes the mark to the next
+//   node (or drops the segment if it was its only node)
+//
+// Why Sort()?
+// - Reports over millions of bids want them by amount or ID. Sort() copies
+//   one integer key per node (cents, or the ID's number) and the node's
+//   address into an array, radix-sorts that (see BidSort.hpp) and relinks
+//   the nodes in the new order. No bid is copied or reallocated, so
+//   handles stay valid.
+// - Fund chains, the ID index and the segments are rebuilt on the way, so
+//   they follow the new order like they followed the old one
+//
+// Why Freeze()?
+// - After a load the list is mostly read. Freeze() copies it into flat
+//   arrays (see FrozenBids.hpp): a perfect hash for Search and sorted
+//   Eytzinger arrays for ID and amount ranges.
+// - Any edit throws the frozen copy away and the list answers from its
+//   nodes again, until the next Freeze()
+//
+// Trade-offs:
+// - 4 pointers per node (32 bytes) instead of 1. An XOR-linked list would
+//   fold next/prev into one word, but then a node can't be unlinked from
+//   its handle alone - you need a neighbor too - which is the whole point.
+// - Must keep tail in sync during Remove (edge case when removing last node)
+//============================================================================
+
+
+#ifndef BID_LINKED_LIST_HPP
+#define BID_LINKED_LIST_HPP
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "BidSort.hpp"
+#include "BidStore.hpp"
+#include "FrozenBids.hpp"
+
+class LinkedList : public BidStore {
+private:
+    struct Node {
+        Bid bid;
+        Node *next;
+        Node *prev;
+        Node *fundNext;   // next/previous node with the same fund
+        Node *fundPrev;
+        bool segmentStart = false;   // this node is in 'segments'
+        bool sharedId = false;       // another node had this ID too (Sort re-checks the index)
+        Node() : next(nullptr), prev(nullptr), fundNext(nullptr), fundPrev(nullptr) {}
+        Node(const Bid& aBid) : bid(aBid), next(nullptr), prev(nullptr), fundNext(nullptr), fundPrev(nullptr) {}
+    };
+
+    struct FundChain {
+        Node *head  = nullptr;
+        Node *tail  = nullptr;
+        int   count = 0;
+    };
+
+    // First node (in list order) with an ID, and how many nodes share it.
+    // IDs repeat in the exports; Search and Remove act on the first one.
+    struct IdEntry {
+        Node *first = nullptr;
+        int   count = 0;
+    };
+
+    Node *head;
+    Node *tail;
+    int   size;
+    std::unordered_map<std::string, FundChain> funds;
+    std::unordered_map<std::string, IdEntry>   ids;
+    std::unique_ptr<FrozenBids>           frozen;   // set by Freeze(), dropped on any edit
+
+    int           segmentSize;
+    std::vector<Node*> segments;        // first node of each segment, in list order
+    int           frontFill = 0;   // nodes prepended into the first segment
+    int           backFill  = 0;   // nodes appended into the last segment
+
+    void LinkFund(Node *node, bool atFront);
+    void UnlinkFund(Node *node);
+    void LinkId(Node *node, bool atFront);
+    void UnlinkId(Node *node);
+    void SegmentAdd(Node *node, bool atFront);
+    void SegmentRemove(Node *node);
+    void Relink(const std::vector<BidSortEntry>& order);
+
+public:
+    // Stable reference to one bid in the list; empty when nothing was found.
+    // Valid until that bid is removed.
+    class Handle {
+    public:
+        Handle() = default;
+        explicit operator bool() const { return node != nullptr; }
+        bool operator==(const Handle& other) const { return node == other.node; }
+        const Bid& bid() const { return node->bid; }
+        Handle next() const { return Handle(node->next); }
+        Handle prev() const { return Handle(node->prev); }
+
+    private:
+        friend class LinkedList;
+        explicit Handle(Node *n) : node(n) {}
+        Node *node = nullptr;
+    };
+
+    static constexpr int kSegmentSize = 256;
+
+    explicit LinkedList(int segmentSize = kSegmentSize);
+    virtual ~LinkedList();
+    void Append(const Bid& bid) override;
+    void Prepend(const Bid& bid) override;
+    bool Remove(const std::string& bidId) override;
+    void Remove(Handle handle);
+    Bid Search(const std::string& bidId) const override;
+    std::vector<Bid> SearchBatch(const std::vector<std::string>& bidIds) const override;
+    Handle Find(const std::string& bidId) const;
+    Handle First() const;
+    Handle Last() const;
+    int Size() const override;
+    void ForEach(const std::function<void(const Bid&)>& visit) const override;
+    std::vector<Bid> Snapshot() const override;
+    void ForEachReverse(const std::function<void(const Bid&)>& visit) const;
+    void ForEachInFund(const std::string& fund, const std::function<void(const Bid&)>& visit) const override;
+    int FundSize(const std::string& fund) const override;
+    void ForEachInRange(const std::string& first, const std::string& last,
+                        const std::function<void(const Bid&)>& visit) const override;
+    void ForEachInAmountRange(double low, double high,
+                              const std::function<void(const Bid&)>& visit) const override;
+    size_t ForEachParallel(unsigned threads,
+                           const std::function<void(size_t part, const Bid&)>& visit) const override;
+    size_t SegmentCount() const { return segments.size(); }
+    bool SegmentsValid() const;   // marks match 'segments', in list order - O(n), for checks
+    void Sort(BidSortKey by, unsigned threads = 0);
+    void Freeze();
+    bool IsFrozen() const { return frozen != nullptr; }
+};
+
+#endif // BID_LINKED_LIST_HPP
@@ -0,0 +1,427 @@
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include "BidCodec.hpp"
+#include "BidLog.hpp"
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// Push the OS write cache for 'f' down to the disk.
+// fdatasync skips the inode timestamp update where it exists (Linux).
+static bool syncFile(std::FILE* f) {
+    if (std::fflush(f) != 0) return false;
+#if defined(_WIN32)
+    return _commit(_fileno(f)) == 0;
+#elif defined(__linux__)
+    return fdatasync(fileno(f)) == 0;
+#else
+    return fsync(fileno(f)) == 0;
+#endif
+}
+
+static std::string readWholeFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+BidLog::BidLog(const std::string& path, std::chrono::milliseconds commitWindow)
+    : path(path), commitWindow(commitWindow) {
+    recover();
+    openForAppend();
+    flusher = std::thread(&BidLog::flusherLoop, this);
+}
+
+/**
+ * Destructor - commits whatever is still queued before closing, so a normal
+ * exit never loses an edit even if nobody waited on it.
+ */
+BidLog::~BidLog() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    flusher.join();
+    if (file != nullptr) {
+        std::fclose(file);
+    }
+}
+
+/**
+ * Walk the records in 'bytes' until the first one that is cut short or
+ * fails its checksum. Everything before that point is trustworthy.
+ * 'visit' also gets the byte offset where each record starts.
+ */
+static size_t scanFrames(const std::string& bytes,
+                         const std::function<void(const LogRecord&, size_t)>& visit) {
+    size_t offset = 0;
+    while (bytes.size() - offset >= 8) {
+        ByteReader header(bytes.data() + offset, 8);
+        uint32_t length, crc;
+        header.u32(length);
+        header.u32(crc);
+        if (bytes.size() - offset - 8 < length) break;          // torn write
+
+        const char* body = bytes.data() + offset + 8;
+        if (crc32Update(body, length) != crc) break;           // corrupted
+
+        LogRecord record;
+        ByteReader reader(body, length);
+        uint8_t op;
+        if (!reader.u64(record.lsn) || !reader.u8(op)) break;
+        record.op = static_cast<LogRecord::Op>(op);
+
+        bool ok = false;
+        switch (record.op) {
+            case LogRecord::APPEND: ok = reader.bid(record.bid); break;
+            case LogRecord::REMOVE: ok = reader.str(record.key); break;
+            case LogRecord::LOAD:
+                ok = reader.str(record.key);
+                // Sample fields, then the fingerprint, were added later;
+                // older records end before them
+                if (ok && reader.remaining() > 0) {
+                    ok = reader.u64(record.sampleSize) && reader.u64(record.sampleSeed);
+                }
+                if (ok && reader.remaining() > 0) {
+                    ok = reader.u64(record.fileSize) && reader.u32(record.fileCrc);
+                    record.hasFingerprint = ok;
+                }
+                break;
+        }
+        if (!ok) break;
+
+        visit(record, offset);
+        offset += 8 + length;
+    }
+    return offset;
+}
+
+size_t BidLog::ScanRecords(const std::string& bytes,
+                           const std::function<void(const LogRecord&)>& visit) {
+    return scanFrames(bytes, [&](const LogRecord& r, size_t) { visit(r); });
+}
+
+bool BidLog::Fingerprint(const std::string& path, uint64_t& size, uint32_t& crc) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+    std::vector<char> buffer(1 << 16);
+    size = 0;
+    crc = 0;
+    while (in.read(buffer.data(), buffer.size()) || in.gcount() > 0) {
+        crc = crc32Update(buffer.data(), static_cast<size_t>(in.gcount()), crc);
+        size += static_cast<uint64_t>(in.gcount());
+    }
+    return !in.bad();
+}
+
+// Make a rename in the directory holding 'path' durable. The rename itself
+// only changes the directory; until that is synced a power cut can undo it,
+// and renames of different files can reach the disk in either order.
+static bool syncDirectory(const std::string& path) {
+#if defined(_WIN32)
+    (void)path;
+    return true;   // NTFS journals the rename; there is no directory handle to flush
+#else
+    std::string dir = std::filesystem::path(path).parent_path().string();
+    int fd = ::open(dir.empty() ? "." : dir.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    bool ok = ::fsync(fd) == 0;
+    ok = (::close(fd) == 0) && ok;
+    return ok;
+#endif
+}
+
+// Rename a synced temp file over 'path' and wait until the rename is on disk
+static void replaceFile(const std::string& tmp, const std::string& path) {
+    std::error_code ec;
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) {
+        throw BidLogError("can't replace " + path + ": " + ec.message());
+    }
+    if (!syncDirectory(path)) {
+        throw BidLogError("can't sync the directory of " + path);
+    }
+}
+
+void BidLog::WriteFileAtomically(const std::string& path, const std::string& bytes) {
+    std::string tmp = path + ".tmp";
+    std::FILE* f = std::fopen(tmp.c_str(), "wb");
+    if (f == nullptr) {
+        throw BidLogError("Failed to open " + tmp);
+    }
+    bool ok = std::fwrite(bytes.data(), 1, bytes.size(), f) == bytes.size() && syncFile(f);
+    ok = (std::fclose(f) == 0) && ok;
+    if (!ok) {
+        throw BidLogError("write to " + tmp + " failed");
+    }
+    replaceFile(tmp, path);
+}
+
+/**
+ * Called once on open: find the last good record, chop any torn tail so new
+ * records land right after it, and continue numbering from its lsn.
+ */
+void BidLog::recover() {
+    std::string bytes = readWholeFile(path);
+    uint64_t lastLsn = 0;
+    size_t valid = ScanRecords(bytes, [&](const LogRecord& r) { lastLsn = r.lsn; });
+
+    if (valid < bytes.size()) {
+        std::error_code ec;
+        std::filesystem::resize_file(path, valid, ec);
+        if (ec) {
+            throw BidLogError("can't truncate torn tail of " + path + ": " + ec.message());
+        }
+    }
+    nextLsn = lastLsn + 1;
+    pendingLsn = durableLsn = lastLsn;
+}
+
+void BidLog::openForAppend() {
+    file = std::fopen(path.c_str(), "ab");
+    if (file == nullptr) {
+        throw BidLogError("Failed to open " + path);
+    }
+}
+
+size_t BidLog::Replay(const std::function<void(const LogRecord&)>& apply, uint64_t afterLsn) const {
+    size_t applied = 0;
+    ScanRecords(readWholeFile(path), [&](const LogRecord& r) {
+        if (r.lsn > afterLsn) {
+            apply(r);
+            applied++;
+        }
+    });
+    return applied;
+}
+
+uint64_t BidLog::enqueue(LogRecord::Op op, const std::string& payload) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!ioError.empty()) {
+        throw BidLogError(ioError);
+    }
+
+    uint64_t lsn = nextLsn++;
+    std::string body;
+    ByteWriter w(body);
+    w.u64(lsn);
+    w.u8(op);
+    body.append(payload);
+
+    ByteWriter frame(pending);
+    frame.u32(static_cast<uint32_t>(body.size()));
+    frame.u32(crc32Update(body.data(), body.size()));
+    pending.append(body);
+    pendingLsn = lsn;
+
+    wake.notify_one();
+    return lsn;
+}
+
+/**
+ * Replay re-reads the CSV rather than logging every row, so the record also
+ * keeps the file's size and CRC: recovery refuses a CSV that has changed
+ * instead of silently rebuilding a different list.
+ */
+uint64_t BidLog::LogLoad(const std::string& csvPath, uint64_t sampleSize, uint64_t sampleSeed) {
+    const std::string absolute = std::filesystem::absolute(csvPath).string();
+    uint64_t size;
+    uint32_t crc;
+    if (!Fingerprint(absolute, size, crc)) {
+        throw BidLogError("can't read " + absolute + " to log its load");
+    }
+
+    std::string payload;
+    ByteWriter w(payload);
+    w.str(absolute);
+    w.u64(sampleSize);
+    w.u64(sampleSeed);
+    w.u64(size);
+    w.u32(crc);
+    return enqueue(LogRecord::LOAD, payload);
+}
+
+uint64_t BidLog::LogAppend(const Bid& bid) {
+    std::string payload;
+    ByteWriter(payload).bid(bid);
+    return enqueue(LogRecord::APPEND, payload);
+}
+
+uint64_t BidLog::LogRemove(const std::string& bidId) {
+    std::string payload;
+    ByteWriter(payload).str(bidId);
+    return enqueue(LogRecord::REMOVE, payload);
+}
+
+// The bytes of 'path' from 'offset' to the end
+static std::string readFrom(const std::string& path, size_t offset) {
+    std::ifstream in(path, std::ios::binary);
+    in.seekg(static_cast<std::streamoff>(offset));
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+/**
+ * Rewrite the log without the records a checkpoint already covers.
+ * LSNs only grow, so what survives is one contiguous tail of the file.
+ *
+ * The tail is copied to a temp file without the lock while the flusher
+ * keeps appending. Only the swap takes the lock: once no batch is being
+ * written, whatever was appended since the copy is added, and the temp
+ * file is synced and renamed over the log. Writers stall for that delta,
+ * not for the whole rewrite.
+ */
+void BidLog::TruncateThrough(uint64_t lsn) {
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (durableLsn < lsn) {
+            syncNow = true;
+            wake.notify_all();
+        }
+        durable.wait(lock, [&] { return durableLsn >= lsn || !ioError.empty(); });
+        if (!ioError.empty()) {
+            throw BidLogError(ioError);
+        }
+    }
+
+    // Everything through 'lsn' is in the file; a batch may be half written
+    // at its end, which the scan stops short of
+    std::string bytes = readWholeFile(path);
+    size_t keepFrom = std::string::npos;
+    size_t copied = scanFrames(bytes, [&](const LogRecord& r, size_t offset) {
+        if (r.lsn > lsn && keepFrom == std::string::npos) {
+            keepFrom = offset;
+        }
+    });
+    if (keepFrom == std::string::npos) {
+        keepFrom = copied;
+    }
+
+    const std::string tmp = path + ".tmp";
+    std::FILE* out = std::fopen(tmp.c_str(), "wb");
+    if (out == nullptr) {
+        throw BidLogError("Failed to open " + tmp);
+    }
+    bool ok = std::fwrite(bytes.data() + keepFrom, 1, copied - keepFrom, out) == copied - keepFrom;
+    bytes.clear();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    durable.wait(lock, [&] { return !writing; });
+    if (ok) {
+        std::string delta = readFrom(path, copied);
+        ok = std::fwrite(delta.data(), 1, delta.size(), out) == delta.size() && syncFile(out);
+    }
+    ok = (std::fclose(out) == 0) && ok;
+    if (!ok) {
+        std::error_code ec;
+        std::filesystem::remove(tmp, ec);
+        throw BidLogError("write to " + tmp + " failed");   // the log itself is untouched
+    }
+
+    std::fclose(file);
+    file = nullptr;
+    try {
+        replaceFile(tmp, path);
+        openForAppend();
+    } catch (const BidLogError& e) {
+        ioError = e.what();   // no handle on the log now; refuse further records
+        throw;
+    }
+}
+
+void BidLog::WaitDurable(uint64_t lsn) {
+    std::unique_lock<std::mutex> lock(mutex);
+    durable.wait(lock, [&] { return durableLsn >= lsn || !ioError.empty(); });
+    if (durableLsn < lsn) {
+        throw BidLogError(ioError);
+    }
+}
+
+void BidLog::Sync() {
+    uint64_t target;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        target = pendingLsn;
+        syncNow = true;
+    }
+    wake.notify_all();
+    WaitDurable(target);
+}
+
+void BidLog::ContinueAfter(uint64_t lsn) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (lsn < nextLsn) {
+        return;
+    }
+    if (pendingLsn != nextLsn - 1 || durableLsn != pendingLsn || !pending.empty()) {
+        throw BidLogError("ContinueAfter called with records queued");
+    }
+    nextLsn = lsn + 1;
+    pendingLsn = durableLsn = lsn;
+}
+
+uint64_t BidLog::LastLsn() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return nextLsn - 1;
+}
+
+uint64_t BidLog::DurableLsn() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return durableLsn;
+}
+
+uint64_t BidLog::SyncCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return syncCount;
+}
+
+/**
+ * Background committer.
+ * The first record of a group starts the clock; anything queued before the
+ * window closes rides along in the same write + fsync. Sync() and shutdown
+ * close the window early.
+ */
+void BidLog::flusherLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wake.wait(lock, [&] { return stopping || !pending.empty(); });
+        if (pending.empty()) {
+            break; // stopping with nothing left to write
+        }
+
+        if (commitWindow.count() > 0 && !stopping && !syncNow) {
+            wake.wait_for(lock, commitWindow, [&] { return stopping || syncNow; });
+        }
+
+        std::string batch;
+        batch.swap(pending);
+        uint64_t batchLsn = pendingLsn;
+        syncNow = false;
+
+        // Write without holding the lock so writers can keep queueing;
+        // 'writing' keeps TruncateThrough from swapping the file meanwhile
+        writing = true;
+        lock.unlock();
+        bool ok = file != nullptr
+                  && std::fwrite(batch.data(), 1, batch.size(), file) == batch.size()
+                  && syncFile(file);
+        lock.lock();
+        writing = false;
+
+        if (ok) {
+            durableLsn = batchLsn;
+            syncCount++;
+        } else {
+            ioError = "write to " + path + " failed";
+        }
+        durable.notify_all();
+    }
+}
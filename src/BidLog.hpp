@@ -0,0 +1,138 @@
+//============================================================================
+// Name        : BidLog.hpp
+//
+// Append-only operation log so interactive edits survive a restart.
+//
+// Every Load/Append/Remove is written as one record:
+//
+//   [u32 body length][u32 CRC-32 of body][body: u64 lsn, u8 op, payload]
+//
+// Why a checksum per record? A crash can leave half a record at the end of
+// the file. On open we keep every record whose length and CRC check out
+// and cut the file back to the last good one.
+//
+// Why group commit? An fsync costs milliseconds on most disks. Writers only
+// queue their record; a background thread waits up to 'commitWindow' for
+// more records to arrive, then writes and fsyncs the whole batch at once.
+// Callers that need the record on disk block in WaitDurable().
+//============================================================================
+
+#ifndef BID_LOG_HPP
+#define BID_LOG_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "Bid.hpp"
+
+class BidLogError : public std::runtime_error {
+public:
+    BidLogError(const std::string& msg)
+        : std::runtime_error(std::string("BidLog : ").append(msg)) {}
+};
+
+// One decoded log entry. Which fields are used depends on 'op'.
+struct LogRecord {
+    enum Op : uint8_t {
+        LOAD   = 1,   // key = absolute CSV path that was loaded (+ sample*, file*)
+        APPEND = 2,   // bid = the bid that was appended
+        REMOVE = 3    // key = id of the bid that was removed
+    };
+
+    uint64_t    lsn = 0;   // log sequence number, increases by one per record
+    Op          op  = APPEND;
+    Bid         bid;
+    std::string key;
+    uint64_t    sampleSize = 0;   // LOAD of a random sample: rows kept, 0 = all
+    uint64_t    sampleSeed = 0;   // ... and the seed that picked them
+    bool        hasFingerprint = false;   // LOAD: the CSV as it was loaded (older logs lack it)
+    uint64_t    fileSize = 0;
+    uint32_t    fileCrc  = 0;     // CRC-32 of the whole file
+};
+
+class BidLog {
+public:
+    BidLog(const std::string& path,
+           std::chrono::milliseconds commitWindow = std::chrono::milliseconds(5));
+    ~BidLog();
+
+    BidLog(const BidLog&) = delete;
+    BidLog& operator=(const BidLog&) = delete;
+
+    // Feeds every durable record with lsn > afterLsn to 'apply', oldest first.
+    size_t Replay(const std::function<void(const LogRecord&)>& apply, uint64_t afterLsn = 0) const;
+
+    // Queue a record and return its lsn. Not durable until WaitDurable(lsn).
+    // LogLoad reads the CSV to fingerprint it; throws if it can't.
+    uint64_t LogLoad(const std::string& csvPath, uint64_t sampleSize = 0, uint64_t sampleSeed = 0);
+    uint64_t LogAppend(const Bid& bid);
+    uint64_t LogRemove(const std::string& bidId);
+
+    void WaitDurable(uint64_t lsn);
+    void Sync();                       // commit everything queued so far, now
+
+    // Drop records with lsn <= 'lsn' once a checkpoint holds their effect.
+    // Writers stall only while the file is swapped, not while the tail is
+    // copied. One caller at a time.
+    void TruncateThrough(uint64_t lsn);
+
+    // Number new records after 'lsn' even if the file no longer holds one
+    // that high: a checkpoint may have truncated them all. Call on open,
+    // before logging anything.
+    void ContinueAfter(uint64_t lsn);
+
+    uint64_t LastLsn() const;          // newest lsn handed out
+    uint64_t DurableLsn() const;       // newest lsn known to be on disk
+    uint64_t SyncCount() const;        // fsyncs issued (one per group)
+    const std::string& Path() const { return path; }
+
+    // Shared by the log and its readers: splits a buffer into records and
+    // returns how many leading bytes were valid.
+    static size_t ScanRecords(const std::string& bytes,
+                              const std::function<void(const LogRecord&)>& visit);
+
+    // Size and CRC-32 of a file, so a replayed LOAD can tell whether the
+    // CSV still holds what was loaded. False if it can't be read.
+    static bool Fingerprint(const std::string& path, uint64_t& size, uint32_t& crc);
+
+    // Replace 'path' with 'bytes' via a synced temp file and a rename, so a
+    // crash leaves either the old file or the new one, never a mix. Returns
+    // once the rename itself is durable (the directory is synced too), so
+    // a file replaced after this one can't reach the disk first.
+    static void WriteFileAtomically(const std::string& path, const std::string& bytes);
+
+private:
+    uint64_t enqueue(LogRecord::Op op, const std::string& payload);
+    void recover();
+    void openForAppend();
+    void flusherLoop();
+
+    std::string               path;
+    std::chrono::milliseconds commitWindow;
+    std::FILE*                file = nullptr;
+
+    mutable std::mutex      mutex;
+    std::condition_variable wake;      // flusher: new records or stop
+    std::condition_variable durable;   // waiters: a group reached disk
+
+    std::string pending;               // encoded records not yet written
+    uint64_t    nextLsn      = 1;
+    uint64_t    pendingLsn   = 0;      // lsn of the last record in 'pending'
+    uint64_t    durableLsn   = 0;
+    uint64_t    syncCount    = 0;
+    bool        syncNow      = false;
+    bool        writing      = false;  // flusher is writing a batch without the lock
+    bool        stopping     = false;
+    std::string ioError;
+
+    std::thread flusher;
+};
+
+#endif // BID_LOG_HPP
@@ -0,0 +1,476 @@
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstring>
+
+#include "BidHash.hpp"
+#include "BidMappedList.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define HAVE_MMAP 1
+#endif
+
+static const char     kMagic[8]          = {'B', 'I', 'D', 'M', 'A', 'P', '0', '1'};
+static constexpr uint64_t kHeaderBytes   = 4096;
+static constexpr uint64_t kInitialBytes  = 1 << 20;
+static constexpr uint64_t kMinIndexSlots = 1024;
+static constexpr uint64_t kEmptySlot     = 0;   // index slot values; records start past the header
+static constexpr uint64_t kErasedSlot    = 1;
+static constexpr size_t   kNoSlot        = SIZE_MAX;
+
+/**
+ * File layout:
+ *
+ *   [ Header | padding to 4 KiB ][ records and index tables, 8-aligned ]
+ *                                                          ^ end
+ *
+ * 'head' and the records' 'next' fields are the list. 'end' says how far
+ * the file is in use. The rest is rebuilt from those after a crash.
+ **/
+struct BidMappedList::Header {
+    char     magic[8];
+    uint64_t head;          // first record, 0 if empty
+    uint64_t end;           // bytes in use from the start of the file
+    uint64_t tail;          // derived from here on
+    uint64_t count;
+    uint64_t indexOffset;   // open-addressing table of first-record offsets
+    uint64_t indexSlots;    // a power of two
+    uint64_t indexUsed;     // live plus erased slots
+    uint64_t garbage;       // bytes no longer reachable
+    uint64_t clean;         // 1 only in a file closed by the destructor
+};
+
+struct BidMappedList::Record {
+    uint64_t next;          // the list
+    uint64_t prev;          // derived from here on
+    uint64_t sameId;        // next record with the same ID, in list order
+    double   amount;
+    uint32_t idLength;
+    uint32_t titleLength;
+    uint32_t fundLength;
+    uint32_t unused;
+    // then the ID, title and fund bytes
+
+    const char* bytes() const { return reinterpret_cast<const char*>(this + 1); }
+    char* bytes() { return reinterpret_cast<char*>(this + 1); }
+};
+
+static uint64_t align8(uint64_t n) {
+    return (n + 7) & ~uint64_t{7};
+}
+
+BidMappedList::Header& BidMappedList::header() const {
+    return *reinterpret_cast<Header*>(base);
+}
+
+BidMappedList::Record& BidMappedList::record(uint64_t offset) const {
+    return *reinterpret_cast<Record*>(base + offset);
+}
+
+uint64_t* BidMappedList::indexSlots() const {
+    return reinterpret_cast<uint64_t*>(base + header().indexOffset);
+}
+
+uint64_t BidMappedList::recordBytes(const Record& r) {
+    return align8(sizeof(Record) + uint64_t{r.idLength} + r.titleLength + r.fundLength);
+}
+
+std::string_view BidMappedList::idOf(const Record& r) {
+    return std::string_view(r.bytes(), r.idLength);
+}
+
+Bid BidMappedList::toBid(const Record& r) {
+    Bid bid;
+    bid.bidId.assign(r.bytes(), r.idLength);
+    bid.title.assign(r.bytes() + r.idLength, r.titleLength);
+    bid.fund.assign(r.bytes() + r.idLength + r.titleLength, r.fundLength);
+    bid.amount = r.amount;
+    return bid;
+}
+
+#ifdef HAVE_MMAP
+
+/**
+ * A clean file is used as it is - only the flag is cleared, and synced,
+ * so a crash from here on is noticed next time. Anything else has its
+ * derived parts rebuilt first.
+ **/
+BidMappedList::BidMappedList(const std::string& path, bool durableWrites, const MemoryPolicy& memory)
+    : filePath(path), durable(durableWrites), policy(memory) {
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        throw BidMappedListError("cannot open " + path);
+    }
+    struct stat st{};
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw BidMappedListError("cannot stat " + path);
+    }
+
+    try {
+        if (st.st_size == 0) {
+            create();
+        } else {
+            if (static_cast<uint64_t>(st.st_size) < kHeaderBytes) {
+                throw BidMappedListError(path + " is too short to be a list file");
+            }
+            map(static_cast<uint64_t>(st.st_size));
+        }
+        static const char unwritten[sizeof(kMagic)] = {};
+        if (std::memcmp(header().magic, unwritten, sizeof(kMagic)) == 0) {
+            // create() never finished; nothing in the file was ever linked
+            std::memset(base, 0, kHeaderBytes);
+            create();
+        } else {
+            if (std::memcmp(header().magic, kMagic, sizeof(kMagic)) != 0) {
+                throw BidMappedListError(path + " is not a list file");
+            }
+            if (header().end < kHeaderBytes || header().end > mapped) {
+                throw BidMappedListError(path + " has a bad end offset");
+            }
+            if (header().clean != 1) {
+                recover();
+                recovered = true;
+            }
+        }
+        header().clean = 0;
+        ::msync(base, kHeaderBytes, MS_SYNC);
+    } catch (...) {
+        unmap();
+        ::close(fd);
+        throw;
+    }
+}
+
+/**
+ * Everything reaches the disk before the clean flag does, so a clean
+ * file is never one with half-written derived parts.
+ **/
+BidMappedList::~BidMappedList() {
+    if (base != nullptr) {
+        ::msync(base, mapped, MS_SYNC);
+        header().clean = 1;
+        ::msync(base, kHeaderBytes, MS_SYNC);
+    }
+    unmap();
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+void BidMappedList::create() {
+    if (base == nullptr) {
+        if (::ftruncate(fd, static_cast<off_t>(kInitialBytes)) != 0) {
+            throw BidMappedListError("cannot size " + filePath);
+        }
+        map(kInitialBytes);
+    }
+    header().end = kHeaderBytes;
+    header().clean = 1;
+    rebuildIndex(kMinIndexSlots);
+    std::memcpy(header().magic, kMagic, sizeof(kMagic));   // last: a file without it is started over
+    ::msync(base, mapped, MS_SYNC);
+}
+
+void BidMappedList::map(uint64_t bytes) {
+    void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) {
+        throw BidMappedListError("cannot map " + filePath);
+    }
+    base = static_cast<char*>(p);
+    mapped = bytes;
+    placeMapping(base, mapped, policy);
+}
+
+void BidMappedList::unmap() {
+    if (base != nullptr) {
+        ::munmap(base, mapped);
+        base = nullptr;
+    }
+}
+
+/**
+ * Returns 'end', after growing the file (at least doubling it) if the
+ * bytes don't fit. Growing maps the file again, usually somewhere else:
+ * no Record& may be held across this call.
+ **/
+uint64_t BidMappedList::allocate(uint64_t bytes) {
+    const uint64_t at = header().end;
+    if (at + bytes > mapped) {
+        const uint64_t grown = std::max(mapped * 2, align8(at + bytes));
+        if (::ftruncate(fd, static_cast<off_t>(grown)) != 0) {
+            throw BidMappedListError("cannot grow " + filePath);
+        }
+        unmap();
+        map(grown);
+    }
+    return at;
+}
+
+/**
+ * msync when durable. Either way the compiler may not move stores to the
+ * mapping across this point: a process killed in between must leave the
+ * stores before it in the file and none after.
+ **/
+void BidMappedList::persist(const void* at, size_t bytes) {
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    if (durable) {
+        const uintptr_t page = static_cast<uintptr_t>(::sysconf(_SC_PAGESIZE));
+        const uintptr_t from = reinterpret_cast<uintptr_t>(at) & ~(page - 1);
+        const uintptr_t to = reinterpret_cast<uintptr_t>(at) + bytes;
+        ::msync(reinterpret_cast<void*>(from), to - from, MS_SYNC);
+    }
+}
+
+#else
+
+BidMappedList::BidMappedList(const std::string& path, bool durableWrites, const MemoryPolicy& memory)
+    : filePath(path), durable(durableWrites), policy(memory) {
+    throw BidMappedListError("memory-mapped lists need mmap, which this platform lacks");
+}
+
+BidMappedList::~BidMappedList() {}
+void BidMappedList::create() {}
+void BidMappedList::map(uint64_t) {}
+void BidMappedList::unmap() {}
+uint64_t BidMappedList::allocate(uint64_t) { return 0; }
+void BidMappedList::persist(const void*, size_t) {}
+
+#endif
+
+/**
+ * Steps 1 and 2 of an insert: the record goes past 'end', then 'end'
+ * moves over it. Until the caller links it, it is unreachable.
+ **/
+uint64_t BidMappedList::writeRecord(const Bid& bid, uint64_t next, uint64_t prev) {
+    const std::string title = bid.Title();   // a lazy title lives in the CSV, not in 'title'
+    const uint64_t bytes = align8(sizeof(Record) + bid.bidId.size() + title.size() + bid.fund.size());
+    const uint64_t at = allocate(bytes);
+
+    Record& r = record(at);
+    r.next = next;
+    r.prev = prev;
+    r.sameId = 0;
+    r.amount = bid.amount;
+    r.idLength = static_cast<uint32_t>(bid.bidId.size());
+    r.titleLength = static_cast<uint32_t>(title.size());
+    r.fundLength = static_cast<uint32_t>(bid.fund.size());
+    r.unused = 0;
+    char* out = r.bytes();
+    std::memcpy(out, bid.bidId.data(), bid.bidId.size());
+    std::memcpy(out + r.idLength, title.data(), title.size());
+    std::memcpy(out + r.idLength + r.titleLength, bid.fund.data(), bid.fund.size());
+    persist(&r, bytes);
+
+    header().end = at + bytes;
+    persist(&header().end, sizeof(uint64_t));
+    return at;
+}
+
+/**
+ * Commit point: the old tail's 'next' (or 'head' for the first record)
+ **/
+void BidMappedList::Append(const Bid& bid) {
+    const uint64_t at = writeRecord(bid, 0, header().tail);
+    Header& h = header();
+    uint64_t& link = h.tail != 0 ? record(h.tail).next : h.head;
+    link = at;
+    persist(&link, sizeof(uint64_t));
+
+    h.tail = at;
+    h.count++;
+    indexAddSame(at, false);
+}
+
+/**
+ * Commit point: 'head'
+ **/
+void BidMappedList::Prepend(const Bid& bid) {
+    const uint64_t at = writeRecord(bid, header().head, 0);
+    Header& h = header();
+    const uint64_t oldHead = h.head;
+    h.head = at;
+    persist(&h.head, sizeof(uint64_t));
+
+    if (oldHead != 0) {
+        record(oldHead).prev = at;
+    } else {
+        h.tail = at;
+    }
+    h.count++;
+    indexAddSame(at, true);
+}
+
+/**
+ * Commit point: the predecessor's 'next' (or 'head'). The next record
+ * with the same ID, if any, takes the index slot over.
+ **/
+bool BidMappedList::Remove(const std::string& bidId) {
+    const size_t slot = indexFind(bidId);
+    if (slot == kNoSlot) {
+        return false;
+    }
+    Header& h = header();
+    const uint64_t at = indexSlots()[slot];
+    Record& r = record(at);
+    uint64_t& link = r.prev != 0 ? record(r.prev).next : h.head;
+    link = r.next;
+    persist(&link, sizeof(uint64_t));
+
+    if (r.next != 0) {
+        record(r.next).prev = r.prev;
+    } else {
+        h.tail = r.prev;
+    }
+    indexSlots()[slot] = r.sameId != 0 ? r.sameId : kErasedSlot;
+    h.count--;
+    h.garbage += recordBytes(r);
+    return true;
+}
+
+Bid BidMappedList::Search(const std::string& bidId) const {
+    const size_t slot = indexFind(bidId);
+    return slot == kNoSlot ? Bid{} : toBid(record(indexSlots()[slot]));
+}
+
+int BidMappedList::Size() const {
+    return static_cast<int>(header().count);
+}
+
+uint64_t BidMappedList::GarbageBytes() const {
+    return header().garbage;
+}
+
+void BidMappedList::ForEach(const std::function<void(const Bid&)>& visit) const {
+    for (uint64_t at = header().head; at != 0; at = record(at).next) {
+        visit(toBid(record(at)));
+    }
+}
+
+size_t BidMappedList::indexFind(std::string_view id) const {
+    const Header& h = header();
+    const uint64_t* slots = indexSlots();
+    const uint64_t mask = h.indexSlots - 1;
+    for (uint64_t pos = hash64(id) & mask, step = 0; step < h.indexSlots; step++, pos = (pos + 1) & mask) {
+        if (slots[pos] == kEmptySlot) {
+            return kNoSlot;
+        }
+        if (slots[pos] != kErasedSlot && idOf(record(slots[pos])) == id) {
+            return static_cast<size_t>(pos);
+        }
+    }
+    return kNoSlot;
+}
+
+/**
+ * Grows (or clears out erased slots) at 3/4 full first. The table is
+ * derived data, so it needs no ordering of its own.
+ **/
+void BidMappedList::indexInsert(uint64_t offset) {
+    if ((header().indexUsed + 1) * 4 > header().indexSlots * 3) {
+        rebuildIndex(std::max(kMinIndexSlots, std::bit_ceil(header().count * 2 + 2)));
+    }
+    Header& h = header();
+    uint64_t* slots = indexSlots();
+    const uint64_t mask = h.indexSlots - 1;
+    uint64_t pos = hash64(idOf(record(offset))) & mask;
+    while (slots[pos] != kEmptySlot && slots[pos] != kErasedSlot) {
+        pos = (pos + 1) & mask;
+    }
+    if (slots[pos] == kEmptySlot) {
+        h.indexUsed++;
+    }
+    slots[pos] = offset;
+}
+
+/**
+ * A prepended record becomes the first for its ID; an appended one goes
+ * at the end of its ID's 'sameId' chain (as in LinkedList::LinkId).
+ **/
+void BidMappedList::indexAddSame(uint64_t offset, bool atFront) {
+    const size_t slot = indexFind(idOf(record(offset)));
+    if (slot == kNoSlot) {
+        indexInsert(offset);
+        return;
+    }
+    uint64_t* slots = indexSlots();
+    if (atFront) {
+        record(offset).sameId = slots[slot];
+        slots[slot] = offset;
+        return;
+    }
+    uint64_t last = slots[slot];
+    while (record(last).sameId != 0) {
+        last = record(last).sameId;
+    }
+    record(last).sameId = offset;
+}
+
+/**
+ * A new table past 'end', filled from the old one; the old one becomes
+ * garbage. On a file being created or recovered there is no old one.
+ **/
+void BidMappedList::rebuildIndex(uint64_t slotCount) {
+    const uint64_t bytes = slotCount * sizeof(uint64_t);
+    const uint64_t at = allocate(bytes);
+    std::memset(base + at, 0, bytes);   // may hold an unlinked record from a crash
+
+    Header& h = header();
+    const uint64_t oldOffset = h.indexOffset;
+    const uint64_t oldSlots = h.indexSlots;
+    h.end = at + bytes;
+    h.indexOffset = at;
+    h.indexSlots = slotCount;
+    h.indexUsed = 0;
+    if (oldOffset == 0) {
+        return;
+    }
+
+    const uint64_t* old = reinterpret_cast<const uint64_t*>(base + oldOffset);
+    for (uint64_t i = 0; i < oldSlots; i++) {
+        if (old[i] != kEmptySlot && old[i] != kErasedSlot) {
+            indexInsert(old[i]);
+        }
+    }
+    h.garbage += oldSlots * sizeof(uint64_t);
+}
+
+/**
+ * One walk down the 'next' chain, checking each link before following
+ * it, rebuilds the back links, tail, count and a fresh index.
+ **/
+void BidMappedList::recover() {
+    Header& h = header();
+    const uint64_t end = h.end;
+    auto valid = [&](uint64_t at) {
+        return at >= kHeaderBytes && at % 8 == 0 && at + sizeof(Record) <= end &&
+               at + recordBytes(record(at)) <= end;
+    };
+
+    h.indexOffset = 0;
+    h.count = 0;
+    h.tail = 0;
+    rebuildIndex(kMinIndexSlots);   // may move the mapping: header() from here on
+
+    uint64_t live = 0;
+    uint64_t prev = 0;
+    for (uint64_t at = header().head; at != 0; at = record(at).next) {
+        if (!valid(at) || header().count > end / sizeof(Record)) {
+            throw BidMappedListError(filePath + " has a broken link after offset " + std::to_string(prev));
+        }
+        Record& r = record(at);
+        r.prev = prev;
+        r.sameId = 0;
+        live += recordBytes(r);
+        header().count++;
+        header().tail = at;
+        indexAddSame(at, false);
+        prev = at;
+    }
+    Header& done = header();
+    done.garbage = done.end - kHeaderBytes - live - done.indexSlots * sizeof(uint64_t);
+}
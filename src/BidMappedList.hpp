@@ -0,0 +1,111 @@
+//============================================================================
+// Name        : BidMappedList.hpp
+//
+// Insertion-ordered bid list that lives in a memory-mapped file, so a
+// restart maps the file and is ready: no CSV to parse, no snapshot to
+// decode. Selected with --store=mapped (file from --store-file).
+//
+// Why offsets? The file is mapped at a different address every run (and
+// again whenever it grows), so records link to each other by their byte
+// offset in the file. A record holds its links, the amount and the ID,
+// title and fund bytes inline; Search and ForEach hand out copies.
+//
+// Crash consistency: each edit has one commit point, an aligned 8-byte
+// store into the 'next' chain:
+//
+// - Append/Prepend write the record past the end of the used space, then
+//   move 'end' over it, then link it in. A crash before the link leaves
+//   an unreachable record, nothing more.
+// - Remove unlinks the record from its predecessor (or the head); the
+//   bytes become garbage.
+//
+// Everything else - tail, count, back links, the ID index - is derived
+// from the chain. A file closed cleanly is trusted as it is; one that
+// wasn't (the 'clean' flag is cleared while open) gets those rebuilt by
+// one walk when it is next opened. With 'durable' set, the ordering
+// points also msync, so the same holds after a power loss; without it,
+// a crashed process loses nothing, but the OS decides when pages reach
+// the disk.
+//
+// Space of removed records is not reused; GarbageBytes() says how much
+// there is. One process, one thread at a time, like the list. The mapping
+// is placed per the MemoryPolicy given, again each time the file grows.
+//============================================================================
+
+#ifndef BID_MAPPED_LIST_HPP
+#define BID_MAPPED_LIST_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "BidMemory.hpp"
+#include "BidStore.hpp"
+
+class BidMappedListError : public std::runtime_error {
+public:
+    BidMappedListError(const std::string& msg)
+        : std::runtime_error(std::string("BidMappedList : ").append(msg)) {}
+};
+
+class BidMappedList : public BidStore {
+public:
+    // Opens the file, or creates it if missing or empty
+    explicit BidMappedList(const std::string& path, bool durable = false,
+                           const MemoryPolicy& policy = MemoryPolicy());
+    ~BidMappedList() override;   // flushes and marks the file clean
+
+    BidMappedList(const BidMappedList&) = delete;
+    BidMappedList& operator=(const BidMappedList&) = delete;
+
+    void Append(const Bid& bid) override;
+    void Prepend(const Bid& bid) override;
+    bool Remove(const std::string& bidId) override;        // first bid with that ID
+    Bid Search(const std::string& bidId) const override;   // first bid with that ID
+    int Size() const override;
+    void ForEach(const std::function<void(const Bid&)>& visit) const override;
+
+    // The file was not closed cleanly last time and was repaired on open
+    bool Recovered() const { return recovered; }
+    uint64_t FileBytes() const { return mapped; }
+    uint64_t GarbageBytes() const;
+    const std::string& Path() const { return filePath; }
+    MemoryStats Memory() const { return memoryStats(base, mapped); }
+
+private:
+    struct Header;
+    struct Record;
+
+    Header& header() const;
+    Record& record(uint64_t offset) const;
+    uint64_t* indexSlots() const;
+    static uint64_t recordBytes(const Record& r);
+    static std::string_view idOf(const Record& r);
+    static Bid toBid(const Record& r);
+
+    void create();
+    void map(uint64_t bytes);
+    void unmap();
+    uint64_t allocate(uint64_t bytes);            // room at 'end'; may move the mapping
+    uint64_t writeRecord(const Bid& bid, uint64_t next, uint64_t prev);
+    void persist(const void* at, size_t bytes);   // ordering point
+    void recover();
+
+    size_t indexFind(std::string_view id) const;   // slot holding the ID's first record, or SIZE_MAX
+    void indexInsert(uint64_t offset);             // ID not in the index yet
+    void indexAddSame(uint64_t offset, bool atFront);
+    void rebuildIndex(uint64_t slots);
+
+    std::string filePath;
+    bool        durable;
+    MemoryPolicy policy;
+    bool        recovered = false;
+    int         fd        = -1;
+    char*       base      = nullptr;
+    uint64_t    mapped    = 0;
+};
+
+#endif // BID_MAPPED_LIST_HPP
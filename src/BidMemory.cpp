@@ -0,0 +1,213 @@
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "BidMemory.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define HAVE_MMAP 1
+#endif
+
+#ifdef HAVE_MMAP
+
+static size_t basePageBytes() {
+    static const size_t bytes = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    return bytes;
+}
+
+// The huge page size (Hugepagesize in /proc/meminfo), 2 MiB if unknown
+static size_t hugePageBytes() {
+    static const size_t bytes = [] {
+        // One "Key: value [kB]" per line; some lines (HugePages_Total) have no unit
+        std::ifstream in("/proc/meminfo");
+        std::string line;
+        while (std::getline(in, line)) {
+            std::istringstream fields(line);
+            std::string key;
+            size_t kb = 0;
+            if (fields >> key >> kb && key == "Hugepagesize:" && kb > 0) {
+                return kb * 1024;
+            }
+        }
+        return size_t(2) << 20;
+    }();
+    return bytes;
+}
+
+static size_t roundUp(size_t n, size_t to) {
+    return (n + to - 1) / to * to;
+}
+
+static bool placed(size_t bytes, const MemoryPolicy& policy) {
+    return policy.Any() && bytes >= kPlacedMinBytes;
+}
+
+// Prefault by reading one byte per page, which works on read-only mappings
+static void touchPages(const void* p, size_t bytes) {
+    const volatile char* bytesAt = static_cast<const volatile char*>(p);
+    char sink = 0;
+    for (size_t i = 0; i < bytes; i += basePageBytes()) {
+        sink ^= bytesAt[i];
+    }
+    (void)sink;
+}
+
+// Anonymous memory needs a write: a read only maps the shared zero page
+static void zeroPages(void* p, size_t bytes) {
+    volatile char* bytesAt = static_cast<volatile char*>(p);
+    for (size_t i = 0; i < bytes; i += basePageBytes()) {
+        bytesAt[i] = 0;
+    }
+}
+
+/**
+ * Huge-page sized and aligned, so every part of the block can be a huge
+ * page. MAP_HUGETLB first when asked for explicit pages; without any
+ * reserved that fails, and the block is placed as for thp.
+ **/
+void* placedAllocate(size_t bytes, const MemoryPolicy& policy) {
+    if (!placed(bytes, policy)) {
+        return ::operator new(bytes);
+    }
+    const size_t huge = hugePageBytes();
+    const size_t length = roundUp(bytes, huge);
+
+    void* p = MAP_FAILED;
+#ifdef MAP_HUGETLB
+    if (policy.hugePages == HugePages::Explicit) {
+        p = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    }
+#endif
+    if (p == MAP_FAILED) {
+        // Map a huge page extra and trim, so the block starts on a huge page boundary
+        void* raw = ::mmap(nullptr, length + huge, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        const uintptr_t start = roundUp(reinterpret_cast<uintptr_t>(raw), huge);
+        const size_t head = start - reinterpret_cast<uintptr_t>(raw);
+        if (head > 0) ::munmap(raw, head);
+        if (huge - head > 0) ::munmap(reinterpret_cast<void*>(start + length), huge - head);
+        p = reinterpret_cast<void*>(start);
+#ifdef MADV_HUGEPAGE
+        if (policy.hugePages != HugePages::Off) {
+            ::madvise(p, length, MADV_HUGEPAGE);
+        }
+#endif
+    }
+
+    if (policy.prefault) {
+        zeroPages(p, length);
+    }
+    if (policy.lock) {
+        ::mlock(p, length);   // over the limit: stays unlocked, memoryStats shows it
+    }
+    return p;
+}
+
+void placedFree(void* p, size_t bytes, const MemoryPolicy& policy) {
+    if (!placed(bytes, policy)) {
+        ::operator delete(p);
+        return;
+    }
+    ::munmap(p, roundUp(bytes, hugePageBytes()));
+}
+
+void placeMapping(void* p, size_t bytes, const MemoryPolicy& policy) {
+    if (p == nullptr || bytes == 0) {
+        return;
+    }
+#ifdef MADV_HUGEPAGE
+    if (policy.hugePages != HugePages::Off) {
+        ::madvise(p, bytes, MADV_HUGEPAGE);
+    }
+#endif
+    if (policy.prefault) {
+        ::madvise(p, bytes, MADV_WILLNEED);   // start reading the file in, then wait for it
+        touchPages(p, bytes);
+    }
+    if (policy.lock) {
+        ::mlock(p, bytes);
+    }
+}
+
+#else
+
+void* placedAllocate(size_t bytes, const MemoryPolicy&) {
+    return ::operator new(bytes);
+}
+
+void placedFree(void* p, size_t, const MemoryPolicy&) {
+    ::operator delete(p);
+}
+
+void placeMapping(void*, size_t, const MemoryPolicy&) {}
+
+#endif
+
+/**
+ * Sums the smaps entries of every mapping that overlaps the block. A
+ * mapping can be larger than the block (the kernel merges neighbors with
+ * the same flags), so the sums are capped at the block's size.
+ **/
+MemoryStats memoryStats(const void* p, size_t bytes) {
+    MemoryStats stats;
+    stats.bytes = bytes;
+#ifdef HAVE_MMAP
+    stats.pageSize = basePageBytes();
+    stats.hugePageSize = hugePageBytes();
+#endif
+    if (p == nullptr || bytes == 0) {
+        return stats;
+    }
+
+    std::ifstream in("/proc/self/smaps");
+    const uintptr_t from = reinterpret_cast<uintptr_t>(p);
+    const uintptr_t to = from + bytes;
+    bool inside = false;
+    size_t pageSize = 0;
+    std::string line;
+    while (std::getline(in, line)) {
+        const std::string first = line.substr(0, line.find(' '));
+        if (first.find('-') != std::string::npos && first.find(':') == std::string::npos) {
+            // "start-end perms offset dev inode path" starts each mapping
+            const uintptr_t start = std::strtoull(first.c_str(), nullptr, 16);
+            const uintptr_t end = std::strtoull(first.c_str() + first.find('-') + 1, nullptr, 16);
+            inside = start < to && end > from;
+            continue;
+        }
+        if (!inside) {
+            continue;
+        }
+        std::istringstream fields(line);
+        std::string key;
+        uint64_t kb = 0;
+        if (!(fields >> key >> kb)) {
+            continue;
+        }
+        if (key == "Rss:") {
+            stats.resident += kb * 1024;
+        } else if (key == "AnonHugePages:" || key == "ShmemPmdMapped:" || key == "FilePmdMapped:") {
+            stats.huge += kb * 1024;
+        } else if (key == "Locked:") {
+            stats.locked += kb * 1024;
+        } else if (key == "KernelPageSize:") {
+            pageSize = std::max<size_t>(pageSize, kb * 1024);
+        }
+    }
+    const size_t basePage = stats.pageSize;
+    if (pageSize > 0) {
+        stats.pageSize = pageSize;
+    }
+    if (basePage > 0 && stats.pageSize > basePage) {
+        stats.huge = stats.resident;   // hugetlb pages aren't counted as AnonHugePages
+    }
+    stats.resident = std::min<uint64_t>(stats.resident, bytes);
+    stats.huge = std::min<uint64_t>(stats.huge, stats.resident);
+    stats.locked = std::min<uint64_t>(stats.locked, bytes);
+    return stats;
+}
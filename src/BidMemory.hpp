@@ -0,0 +1,93 @@
+//============================================================================
+// Name        : BidMemory.hpp
+//
+// Where the stores' large blocks of memory come from: the vector list's
+// node array, the mapped list's file mapping and an attached shared image.
+// Chosen with --huge-pages=thp|explicit, --mlock and --prefault.
+//
+// Why? A random lookup across a few GB of bids misses the TLB more often
+// than the cache: with 4 KiB pages the TLB covers a few MB at most, so
+// nearly every lookup also walks the page tables. A 2 MiB page covers
+// 512 times as much.
+//
+// - thp: madvise(MADV_HUGEPAGE), so the kernel backs the block with
+//   transparent huge pages where it can (anonymous memory, and shared
+//   memory if the system allows it there).
+// - explicit: MAP_HUGETLB, from the pages reserved in
+//   /proc/sys/vm/nr_hugepages. Only for new anonymous blocks; if none are
+//   reserved it falls back to thp.
+// - mlock: the block stays in RAM, no page-outs under memory pressure.
+// - prefault: every page is touched when the block is set up (load or
+//   open), so the first lookups don't pay for the page faults.
+//
+// None of these is guaranteed - THP can be disabled, the lock limit can
+// be low - so nothing fails if the kernel says no. Stats() reads what was
+// actually obtained back from /proc/self/smaps.
+//============================================================================
+
+#ifndef BID_MEMORY_HPP
+#define BID_MEMORY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+enum class HugePages { Off, Transparent, Explicit };
+
+struct MemoryPolicy {
+    HugePages hugePages = HugePages::Off;
+    bool      lock      = false;   // mlock
+    bool      prefault  = false;   // touch every page up front
+
+    bool Any() const { return hugePages != HugePages::Off || lock || prefault; }
+    bool operator==(const MemoryPolicy&) const = default;
+};
+
+// What the kernel gave a block (bytes; page size in bytes)
+struct MemoryStats {
+    uint64_t bytes        = 0;   // size of the block
+    uint64_t resident     = 0;   // in RAM now
+    uint64_t huge         = 0;   // of that, in huge pages
+    uint64_t locked       = 0;
+    size_t   pageSize     = 0;   // of the mapping: 4 KiB, or 2 MiB with explicit huge pages
+    size_t   hugePageSize = 0;   // of a transparent huge page
+};
+
+// Blocks smaller than this come from operator new whatever the policy
+constexpr size_t kPlacedMinBytes = size_t(1) << 20;
+
+// A block of memory placed per 'policy'. Free with the same bytes and policy.
+void* placedAllocate(size_t bytes, const MemoryPolicy& policy);
+void placedFree(void* p, size_t bytes, const MemoryPolicy& policy);
+
+// Apply the policy to memory mapped elsewhere (a file, a shared image).
+// 'explicit' can't be applied after the fact and is treated as thp.
+void placeMapping(void* p, size_t bytes, const MemoryPolicy& policy);
+
+// What backs [p, p + bytes) right now; zeros where /proc isn't available
+MemoryStats memoryStats(const void* p, size_t bytes);
+
+// std::allocator stand-in that places large blocks per its policy
+template <typename T>
+class PlacedAllocator {
+public:
+    using value_type = T;
+
+    PlacedAllocator() = default;
+    explicit PlacedAllocator(const MemoryPolicy& policy) : policy(policy) {}
+    template <typename U>
+    PlacedAllocator(const PlacedAllocator<U>& other) : policy(other.policy) {}
+
+    T* allocate(size_t n) {
+        if (n > SIZE_MAX / sizeof(T)) throw std::bad_array_new_length();
+        return static_cast<T*>(placedAllocate(n * sizeof(T), policy));
+    }
+    void deallocate(T* p, size_t n) { placedFree(p, n * sizeof(T), policy); }
+
+    template <typename U>
+    bool operator==(const PlacedAllocator<U>& other) const { return policy == other.policy; }
+
+    MemoryPolicy policy;
+};
+
+#endif // BID_MEMORY_HPP
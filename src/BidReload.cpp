@@ -0,0 +1,141 @@
+#include <stdexcept>
+
+#include "BidReload.hpp"
+
+BidReloader::BidReloader(std::unique_ptr<BidStore> initial)
+    : shared(std::make_shared<Shared>()) {
+    if (initial) {
+        current = publishable(std::move(initial));   // no readers yet
+    }
+    worker = std::thread(&BidReloader::run, this);
+}
+
+/**
+ * A reload still waiting is dropped; one being built is finished first.
+ * Versions readers still hold are freed by whichever reader lets go last.
+ */
+BidReloader::~BidReloader() {
+    {
+        std::lock_guard<std::mutex> lock(shared->mutex);
+        stopping = true;
+    }
+    shared->changed.notify_all();
+    worker.join();
+
+    std::vector<const BidStore*> left;
+    {
+        std::lock_guard<std::mutex> lock(shared->mutex);
+        shared->open = false;
+        left.swap(shared->retired);
+    }
+    for (const BidStore* store : left) {
+        delete store;
+    }
+}
+
+/**
+ * Wrap a new version for publishing. When its last holder lets go, the
+ * deleter only queues it for the worker thread, so no reader ever waits
+ * for a whole store to be freed.
+ */
+std::shared_ptr<const BidStore> BidReloader::publishable(std::unique_ptr<BidStore> store) {
+    std::shared_ptr<Shared> to = shared;
+    return std::shared_ptr<const BidStore>(store.release(), [to](const BidStore* old) {
+        std::unique_lock<std::mutex> lock(to->mutex);
+        if (!to->open) {
+            lock.unlock();
+            delete old;
+            return;
+        }
+        to->retired.push_back(old);
+        lock.unlock();
+        to->changed.notify_all();
+    });
+}
+
+std::shared_ptr<const BidStore> BidReloader::Current() const {
+    return std::atomic_load_explicit(&current, std::memory_order_acquire);
+}
+
+void BidReloader::Reload(Builder build) {
+    {
+        std::lock_guard<std::mutex> lock(shared->mutex);
+        queued = std::move(build);
+    }
+    shared->changed.notify_all();
+}
+
+void BidReloader::Wait() {
+    std::unique_lock<std::mutex> lock(shared->mutex);
+    shared->changed.wait(lock, [&] { return !queued && !busy && shared->retired.empty(); });
+}
+
+uint64_t BidReloader::Generation() const {
+    std::lock_guard<std::mutex> lock(shared->mutex);
+    return generation;
+}
+
+size_t BidReloader::Freed() const {
+    std::lock_guard<std::mutex> lock(shared->mutex);
+    return freed;
+}
+
+std::string BidReloader::LastError() const {
+    std::lock_guard<std::mutex> lock(shared->mutex);
+    return lastError;
+}
+
+/**
+ * Frees retired versions first - the memory may be needed for the next
+ * build - then runs the queued reload, if any. The lock is never held
+ * while building or freeing.
+ */
+void BidReloader::run() {
+    std::unique_lock<std::mutex> lock(shared->mutex);
+    while (true) {
+        shared->changed.wait(lock, [&] { return stopping || queued || !shared->retired.empty(); });
+
+        if (!shared->retired.empty()) {
+            std::vector<const BidStore*> old;
+            old.swap(shared->retired);
+            lock.unlock();
+            for (const BidStore* store : old) {
+                delete store;
+            }
+            lock.lock();
+            freed += old.size();
+            shared->changed.notify_all();
+            continue;
+        }
+        if (stopping) {
+            break;
+        }
+
+        Builder build = std::move(queued);
+        queued = nullptr;
+        busy = true;
+        lock.unlock();
+
+        std::string error;
+        try {
+            std::unique_ptr<BidStore> next = build();
+            if (!next) {
+                throw std::runtime_error("BidReload : builder returned no store");
+            }
+            // The old version goes back through its deleter, to 'retired'
+            std::atomic_store_explicit(&current, publishable(std::move(next)), std::memory_order_release);
+        } catch (const std::exception& e) {
+            error = e.what();
+        } catch (...) {
+            error = "BidReload : builder failed";
+        }
+
+        lock.lock();
+        busy = false;
+        lastError = error;
+        if (error.empty()) {
+            generation++;
+        }
+        shared->changed.notify_all();
+    }
+}
@@ -0,0 +1,94 @@
+//============================================================================
+// Name        : BidReload.hpp
+//
+// Replace the whole bid collection without stopping the threads reading it.
+//
+// Why not load into the live list? loadBids appends row by row, so a
+// reader running at the same time sees a half-built list (and the list
+// isn't safe to read while it changes at all). BidReloader keeps the
+// current store behind one atomic pointer instead:
+//
+// - Readers call Current() and get a shared_ptr to the version published
+//   at that moment. They use it for as long as they like without any lock;
+//   a reload never touches a published version.
+// - Reload() builds a complete new store (bids, indexes, a frozen copy -
+//   whatever the builder does) on the reloader's own thread, then
+//   publishes it with a single atomic store. Readers that started earlier
+//   finish on the old version, later ones see the new one.
+// - An old version is freed once its last reader lets go (RCU-style). The
+//   last reader doesn't pay for that: the version is handed back to the
+//   reloader's thread, which frees it there. Freeing millions of nodes on
+//   a query thread would show up as a latency spike.
+//
+// Like the checkpointer, only the newest waiting reload is kept: a reload
+// requested while another one is still waiting replaces it.
+//============================================================================
+
+#ifndef BID_RELOAD_HPP
+#define BID_RELOAD_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BidStore.hpp"
+
+class BidReloader {
+public:
+    using Builder = std::function<std::unique_ptr<BidStore>()>;
+
+    // 'initial' is published as generation 0; Current() is empty without it
+    explicit BidReloader(std::unique_ptr<BidStore> initial = nullptr);
+    ~BidReloader();                   // finishes a reload in progress
+
+    BidReloader(const BidReloader&) = delete;
+    BidReloader& operator=(const BidReloader&) = delete;
+
+    // The published version; it stays valid while the caller holds it
+    std::shared_ptr<const BidStore> Current() const;
+
+    // Build a new version in the background and publish it. If 'build'
+    // throws, the current version stays and LastError() says why.
+    void Reload(Builder build);
+    void Wait();                      // until no reload is queued or running, and old versions are freed
+
+    uint64_t    Generation() const;   // reloads published so far
+    size_t      Freed() const;        // old versions freed so far
+    std::string LastError() const;    // empty if the last reload succeeded
+
+private:
+    // Shared with the deleters of published versions, which may run after
+    // the reloader is gone
+    struct Shared {
+        std::mutex                   mutex;          // guards this and the reloader's state below
+        std::condition_variable      changed;
+        std::vector<const BidStore*> retired;        // old versions waiting to be freed
+        bool                         open = true;    // false: deleters free in place
+    };
+
+    std::shared_ptr<const BidStore> publishable(std::unique_ptr<BidStore> store);
+    void run();
+
+    // Only read and written through std::atomic_load/atomic_store. Not
+    // std::atomic<shared_ptr>: libstdc++ 12's load releases its internal
+    // lock with relaxed order, which doesn't order it before the next store.
+    std::shared_ptr<Shared> shared;
+    std::shared_ptr<const BidStore> current;
+
+    Builder     queued;
+    bool        busy       = false;
+    bool        stopping   = false;
+    uint64_t    generation = 0;
+    size_t      freed      = 0;
+    std::string lastError;
+
+    std::thread worker;               // last: started once the members above exist
+};
+
+#endif // BID_RELOAD_HPP
@@ -0,0 +1,73 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <utility>
+
+#include "BidSampler.hpp"
+
+// std::uniform_real_distribution may differ between standard libraries;
+// building the double from the top 53 bits of mt19937_64 does not.
+// Never returns 0, so log() below stays finite.
+static double unitRandom(std::mt19937_64& rng) {
+    return (static_cast<double>(rng() >> 11) + 1.0) * 0x1.0p-53;
+}
+
+// Read one row, dropping a trailing '\r' from Windows line endings
+static bool readLine(std::istream& in, std::string& line) {
+    if (!std::getline(in, line)) return false;
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+    return true;
+}
+
+/**
+ * Algorithm L (Li, 1994).
+ * Fill the reservoir with the first N rows. After that, W tracks the
+ * smallest of N random keys; the gap until a row beats it is geometric with
+ * parameter W, so we jump straight there and replace a random slot.
+ */
+SampledLines reservoirSampleLines(std::istream& in, size_t sampleSize, uint64_t seed) {
+    SampledLines result;
+    if (!readLine(in, result.header) || sampleSize == 0) {
+        return result;
+    }
+
+    std::mt19937_64 rng(seed);
+    std::vector<std::pair<uint64_t, std::string>> reservoir;   // (row number, text)
+    reservoir.reserve(sampleSize);
+
+    std::string line;
+    while (reservoir.size() < sampleSize && readLine(in, line)) {
+        if (line.empty()) continue;
+        reservoir.emplace_back(result.rowsSeen++, line);
+    }
+
+    double w = std::exp(std::log(unitRandom(rng)) / static_cast<double>(sampleSize));
+    while (in) {
+        double gap = std::floor(std::log(unitRandom(rng)) / std::log1p(-w));
+        uint64_t skip = gap >= 9.0e18 ? std::numeric_limits<uint64_t>::max()
+                                      : static_cast<uint64_t>(gap);
+
+        // Skipped rows are scanned for '\n' only - no copy, no tokenizing
+        uint64_t skipped = 0;
+        while (skipped < skip && in.peek() != std::char_traits<char>::eof()) {
+            in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            skipped++;
+        }
+        result.rowsSeen += skipped;
+        if (skipped < skip || !readLine(in, line)) {
+            break;
+        }
+
+        reservoir[rng() % sampleSize] = {result.rowsSeen++, line};
+        w *= std::exp(std::log(unitRandom(rng)) / static_cast<double>(sampleSize));
+    }
+
+    // Hand rows back in file order so the sample reads like the original
+    std::sort(reservoir.begin(), reservoir.end());
+    result.lines.reserve(reservoir.size());
+    for (auto& kept : reservoir) {
+        result.lines.push_back(std::move(kept.second));
+    }
+    return result;
+}
@@ -0,0 +1,34 @@
+//============================================================================
+// Name        : BidSampler.hpp
+//
+// Uniform random sample of the rows in a large CSV, without parsing them all.
+//
+// Why reservoir sampling? We don't know how many rows a file has until we
+// reach the end, and we don't want to read it twice. A reservoir of N rows
+// gives every row the same N/total chance of being kept in a single pass.
+//
+// Why Algorithm L rather than "roll a die per row"? It computes how many
+// rows to skip before the next replacement, so skipped rows are only scanned
+// for their newline - never copied into a string, never tokenized. Only the
+// N kept rows reach the CSV parser.
+//============================================================================
+
+#ifndef BID_SAMPLER_HPP
+#define BID_SAMPLER_HPP
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+struct SampledLines {
+    std::string              header;
+    std::vector<std::string> lines;     // kept rows, in file order
+    uint64_t                 rowsSeen = 0;
+};
+
+// Same input + same seed always gives the same sample, on every platform,
+// so a logged sampled load can be replayed exactly.
+SampledLines reservoirSampleLines(std::istream& in, size_t sampleSize, uint64_t seed);
+
+#endif // BID_SAMPLER_HPP
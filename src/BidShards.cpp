@@ -0,0 +1,144 @@
+#include <algorithm>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#include "BidHash.hpp"
+#include "BidShards.hpp"
+
+BidShardedStore::BidShardedStore(size_t count, const ShardFactory& make)
+    : shards(count != 0 ? count : ResolveThreads(0)) {
+    for (Shard& shard : shards) {
+        shard.store = make();
+    }
+}
+
+size_t BidShardedStore::ShardOf(const std::string& bidId) const {
+    return hash64(bidId) % shards.size();
+}
+
+// Every write to an ID holds its shard's lock, so the count can't change between Find and Insert
+void BidShardedStore::counted(const std::string& bidId, int change) {
+    uint64_t count = 0;
+    ids.Find(bidId, count);
+    if (change < 0 && count <= 1) {
+        ids.Erase(bidId);
+    } else {
+        ids.Insert(bidId, count + change);
+    }
+}
+
+void BidShardedStore::Append(const Bid& bid) {
+    Shard& shard = shards[ShardOf(bid.bidId)];
+    std::unique_lock<std::shared_mutex> guard(shard.lock);
+    shard.store->Append(bid);
+    counted(bid.bidId, +1);
+}
+
+void BidShardedStore::Prepend(const Bid& bid) {
+    Shard& shard = shards[ShardOf(bid.bidId)];
+    std::unique_lock<std::shared_mutex> guard(shard.lock);
+    shard.store->Prepend(bid);
+    counted(bid.bidId, +1);
+}
+
+bool BidShardedStore::Remove(const std::string& bidId) {
+    Shard& shard = shards[ShardOf(bidId)];
+    std::unique_lock<std::shared_mutex> guard(shard.lock);
+    if (!shard.store->Remove(bidId)) {
+        return false;
+    }
+    counted(bidId, -1);
+    return true;
+}
+
+/**
+ * A miss in the index answers without locking. A hit still searches the
+ * shard under its read lock: a writer may remove the bid in between.
+ */
+Bid BidShardedStore::Search(const std::string& bidId) const {
+    uint64_t count;
+    if (!ids.Find(bidId, count)) {
+        return Bid();
+    }
+    const Shard& shard = shards[ShardOf(bidId)];
+    std::shared_lock<std::shared_mutex> guard(shard.lock);
+    return shard.store->Search(bidId);
+}
+
+/**
+ * Each shard is counted under its own lock, one after another: with
+ * writers running, the total is a sum of per-shard moments, not one
+ * snapshot of the whole store.
+ */
+int BidShardedStore::Size() const {
+    int total = 0;
+    for (const Shard& shard : shards) {
+        std::shared_lock<std::shared_mutex> guard(shard.lock);
+        total += shard.store->Size();
+    }
+    return total;
+}
+
+void BidShardedStore::ForEach(const std::function<void(const Bid&)>& visit) const {
+    for (const Shard& shard : shards) {
+        std::shared_lock<std::shared_mutex> guard(shard.lock);
+        shard.store->ForEach(visit);
+    }
+}
+
+void BidShardedStore::ForEachInFund(const std::string& fund,
+                                    const std::function<void(const Bid&)>& visit) const {
+    for (const Shard& shard : shards) {
+        std::shared_lock<std::shared_mutex> guard(shard.lock);
+        shard.store->ForEachInFund(fund, visit);
+    }
+}
+
+int BidShardedStore::FundSize(const std::string& fund) const {
+    int total = 0;
+    for (const Shard& shard : shards) {
+        std::shared_lock<std::shared_mutex> guard(shard.lock);
+        total += shard.store->FundSize(fund);
+    }
+    return total;
+}
+
+/**
+ * Part p walks shards [p*S/parts, (p+1)*S/parts), holding each shard's
+ * read lock while in it, so writers to the other shards carry on. The
+ * calling thread runs part 0; an exception from 'visit' is rethrown once
+ * every part has stopped.
+ */
+size_t BidShardedStore::ForEachParallel(unsigned threads,
+                                        const std::function<void(size_t part, const Bid&)>& visit) const {
+    const size_t parts = std::min<size_t>(ResolveThreads(threads), shards.size());
+    if (parts <= 1) {
+        return BidStore::ForEachParallel(threads, visit);
+    }
+
+    std::vector<std::exception_ptr> errors(parts);
+    auto walk = [&](size_t part) {
+        try {
+            for (size_t s = part * shards.size() / parts; s < (part + 1) * shards.size() / parts; s++) {
+                std::shared_lock<std::shared_mutex> guard(shards[s].lock);
+                shards[s].store->ForEach([&](const Bid& b) { visit(part, b); });
+            }
+        } catch (...) {
+            errors[part] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t p = 1; p < parts; p++) {
+        workers.emplace_back(walk, p);
+    }
+    walk(0);
+    for (std::thread& t : workers) {
+        t.join();
+    }
+    for (std::exception_ptr& e : errors) {
+        if (e) std::rethrow_exception(e);
+    }
+    return parts;
+}
@@ -0,0 +1,80 @@
+//============================================================================
+// Name        : BidShards.hpp
+//
+// Bid store split into N shards by a hash of the bid ID, for programs that
+// read and write from many threads. Selected with --store=sharded.
+//
+// Why shards? One store behind one lock lets a single writer stall every
+// reader, and all threads fight over the same lock's cache line even when
+// nobody writes. Here each shard is a complete store of its own (a linked
+// list, with its indexes) behind its own reader-writer lock:
+//
+// - A bid ID always hashes to the same shard, so Search/Remove touch one
+//   shard, and writers to different shards never wait for each other.
+// - Each shard sits on its own cache lines (alignas(64)); taking one
+//   shard's lock doesn't invalidate the line holding its neighbor's.
+// - Scans fan out: ForEachParallel gives each thread a run of whole
+//   shards, so FilterParallel and TotalsParallel use every core.
+// - A concurrent ID index (BidIdIndex) counts the bids holding each ID.
+//   Search checks it first without any lock, so a lookup of an ID that
+//   isn't there never touches a shard lock. Writers update it under their
+//   shard's lock, after the shard itself, so an ID the index shows is in
+//   the shard by the time a reader locks it.
+//
+// Order: ForEach lists shard 0's bids, then shard 1's, and so on, each in
+// its shard's order. Repeated IDs share a shard, so "first match" still
+// means the first one added, as in the list. Fund and range queries come
+// from the BidStore scans on top of that.
+//============================================================================
+
+#ifndef BID_SHARDS_HPP
+#define BID_SHARDS_HPP
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+#include "BidIndex.hpp"
+#include "BidStore.hpp"
+
+class BidShardedStore : public BidStore {
+public:
+    using ShardFactory = std::function<std::unique_ptr<BidStore>()>;
+
+    // 'shards' stores from 'make' (0 shards = one per hardware thread)
+    BidShardedStore(size_t shards, const ShardFactory& make);
+
+    BidShardedStore(const BidShardedStore&) = delete;
+    BidShardedStore& operator=(const BidShardedStore&) = delete;
+
+    void Append(const Bid& bid) override;
+    void Prepend(const Bid& bid) override;
+    bool Remove(const std::string& bidId) override;
+    Bid Search(const std::string& bidId) const override;
+    int Size() const override;
+    void ForEach(const std::function<void(const Bid&)>& visit) const override;
+    void ForEachInFund(const std::string& fund, const std::function<void(const Bid&)>& visit) const override;
+    int FundSize(const std::string& fund) const override;
+    size_t ForEachParallel(unsigned threads,
+                           const std::function<void(size_t part, const Bid&)>& visit) const override;
+
+    size_t Shards() const { return shards.size(); }
+    size_t ShardOf(const std::string& bidId) const;
+    size_t DistinctIds() const { return ids.Size(); }
+
+private:
+    struct alignas(64) Shard {
+        mutable std::shared_mutex  lock;   // shared for reads, exclusive for edits
+        std::unique_ptr<BidStore>  store;
+    };
+
+    void counted(const std::string& bidId, int change);   // under the ID's shard lock
+
+    std::vector<Shard> shards;
+    BidIdIndex         ids;    // bid ID -> how many bids hold it
+};
+
+#endif // BID_SHARDS_HPP
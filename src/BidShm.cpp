@@ -0,0 +1,424 @@
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <thread>
+#include <vector>
+
+#include "BidHash.hpp"
+#include "BidShm.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define HAVE_SHM 1
+#endif
+
+static const char kControlMagic[8] = {'B', 'I', 'D', 'S', 'H', 'M', 'C', '1'};
+static const char kImageMagic[8]   = {'B', 'I', 'D', 'S', 'H', 'M', 'I', '1'};
+
+// The control segment: which generation is current
+struct Control {
+    char                  magic[8];
+    std::atomic<uint64_t> generation;   // 0 until the first publish
+};
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared atomics must not hide a lock");
+
+struct BidSharedView::Header {
+    char     magic[8];
+    uint64_t generation;
+    uint64_t count;
+    uint64_t indexOffset;   // uint32 slots: record number + 1, 0 = empty
+    uint64_t indexSlots;    // a power of two
+    uint64_t textOffset;
+};
+
+struct BidSharedView::Record {
+    uint64_t text;          // ID, then title, then fund, from textOffset
+    double   amount;
+    uint32_t idLength;
+    uint32_t titleLength;
+    uint32_t fundLength;
+    uint32_t unused;
+};
+
+// shm names are "/name"; the images are "/name.g<generation>"
+static std::string controlName(const std::string& name) {
+    return name.starts_with('/') ? name : "/" + name;
+}
+
+static std::string imageName(const std::string& name, uint64_t generation) {
+    return controlName(name) + ".g" + std::to_string(generation);
+}
+
+static uint64_t align8(uint64_t n) {
+    return (n + 7) & ~uint64_t{7};
+}
+
+#ifdef HAVE_SHM
+
+// Maps the control segment read-write, creating it on first use
+static Control* openControl(const std::string& name) {
+    const std::string path = controlName(name);
+    int fd = ::shm_open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        throw BidShmError("cannot open shared memory " + path);
+    }
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 ||
+        (st.st_size < static_cast<off_t>(sizeof(Control)) && ::ftruncate(fd, sizeof(Control)) != 0)) {
+        ::close(fd);
+        throw BidShmError("cannot size shared memory " + path);
+    }
+    void* p = ::mmap(nullptr, sizeof(Control), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) {
+        throw BidShmError("cannot map shared memory " + path);
+    }
+    Control* control = static_cast<Control*>(p);
+    if (control->magic[0] == 0) {
+        std::memcpy(control->magic, kControlMagic, sizeof(kControlMagic));   // fresh: zero-filled
+    } else if (std::memcmp(control->magic, kControlMagic, sizeof(kControlMagic)) != 0) {
+        ::munmap(p, sizeof(Control));
+        throw BidShmError(path + " is not a published bid store");
+    }
+    return control;
+}
+
+/**
+ * Two passes over the store: one to size the image, one to fill it in.
+ * The index points at the first record of each ID in store order, so
+ * Search finds what the store's own Search would.
+ **/
+uint64_t publishShared(const std::string& name, const BidStore& store) {
+    uint64_t count = 0;
+    uint64_t textBytes = 0;
+    store.ForEach([&](const Bid& b) {
+        count++;
+        textBytes += b.bidId.size() + b.Title().size() + b.fund.size();   // a lazy title isn't in 'title'
+    });
+    if (count >= UINT32_MAX) {
+        throw BidShmError("too many bids for one image");
+    }
+
+    using Header = BidSharedView::Header;
+    using Record = BidSharedView::Record;
+    const uint64_t slots = std::bit_ceil(std::max<uint64_t>(16, count * 2));
+    const uint64_t indexOffset = align8(sizeof(Header) + count * sizeof(Record));
+    const uint64_t textOffset = align8(indexOffset + slots * sizeof(uint32_t));
+    const uint64_t bytes = textOffset + textBytes;
+
+    Control* control = openControl(name);
+    const uint64_t previous = control->generation.load(std::memory_order_acquire);
+    const uint64_t next = previous + 1;
+    const std::string path = imageName(name, next);
+
+    ::shm_unlink(path.c_str());   // left over from a publisher that died before switching
+    int fd = ::shm_open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (fd < 0 || ::ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+        if (fd >= 0) ::close(fd);
+        ::munmap(control, sizeof(Control));
+        throw BidShmError("cannot create shared memory " + path);
+    }
+    void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) {
+        ::shm_unlink(path.c_str());
+        ::munmap(control, sizeof(Control));
+        throw BidShmError("cannot map shared memory " + path);
+    }
+
+    char* base = static_cast<char*>(p);   // fresh segments are zero-filled
+    Header& h = *reinterpret_cast<Header*>(base);
+    Record* records = reinterpret_cast<Record*>(base + sizeof(Header));
+    uint32_t* index = reinterpret_cast<uint32_t*>(base + indexOffset);
+    char* text = base + textOffset;
+
+    uint64_t n = 0;
+    uint64_t at = 0;
+    store.ForEach([&](const Bid& b) {
+        const std::string title = b.Title();
+        if (n == count || at + b.bidId.size() + title.size() + b.fund.size() > textBytes) {
+            return;   // the store grew between the passes
+        }
+        Record& r = records[n];
+        r.text = at;
+        r.amount = b.amount;
+        r.idLength = static_cast<uint32_t>(b.bidId.size());
+        r.titleLength = static_cast<uint32_t>(title.size());
+        r.fundLength = static_cast<uint32_t>(b.fund.size());
+        std::memcpy(text + at, b.bidId.data(), b.bidId.size());
+        std::memcpy(text + at + r.idLength, title.data(), title.size());
+        std::memcpy(text + at + r.idLength + r.titleLength, b.fund.data(), b.fund.size());
+        at += r.idLength + r.titleLength + r.fundLength;
+
+        for (uint64_t pos = hash64(b.bidId) & (slots - 1);; pos = (pos + 1) & (slots - 1)) {
+            if (index[pos] == 0) {
+                index[pos] = static_cast<uint32_t>(n + 1);
+                break;
+            }
+            const Record& other = records[index[pos] - 1];
+            if (std::string_view(text + other.text, other.idLength) == b.bidId) {
+                break;   // an earlier bid has this ID
+            }
+        }
+        n++;
+    });
+
+    h.generation = next;
+    h.count = n;
+    h.indexOffset = indexOffset;
+    h.indexSlots = slots;
+    h.textOffset = textOffset;
+    std::memcpy(h.magic, kImageMagic, sizeof(kImageMagic));
+    ::munmap(p, bytes);
+
+    // The switch: attachers from here on map the new image
+    control->generation.store(next, std::memory_order_release);
+    ::munmap(control, sizeof(Control));
+    if (previous != 0) {
+        ::shm_unlink(imageName(name, previous).c_str());
+    }
+    return next;
+}
+
+void unpublishShared(const std::string& name) {
+    const std::string path = controlName(name);
+    int fd = ::shm_open(path.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        return;
+    }
+    void* p = ::mmap(nullptr, sizeof(Control), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p != MAP_FAILED) {
+        const uint64_t current = static_cast<const Control*>(p)->generation.load(std::memory_order_acquire);
+        ::munmap(p, sizeof(Control));
+        if (current != 0) {
+            ::shm_unlink(imageName(name, current).c_str());
+        }
+    }
+    ::shm_unlink(path.c_str());
+}
+
+BidSharedView::BidSharedView(const std::string& storeName, const MemoryPolicy& memory)
+    : name(storeName), policy(memory) {
+    const std::string path = controlName(name);
+    int fd = ::shm_open(path.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        throw BidShmError("nothing published as " + name);
+    }
+    void* p = ::mmap(nullptr, sizeof(Control), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) {
+        throw BidShmError("cannot map shared memory " + path);
+    }
+    control = static_cast<const char*>(p);
+    try {
+        attach();
+    } catch (...) {
+        ::munmap(const_cast<char*>(control), sizeof(Control));
+        throw;
+    }
+}
+
+BidSharedView::~BidSharedView() {
+    detach();
+    if (control != nullptr) {
+        ::munmap(const_cast<char*>(control), sizeof(Control));
+    }
+}
+
+/**
+ * Reads the current generation, then opens its image. A publisher may
+ * switch and unlink that image in between; then the open fails and the
+ * newer generation is tried instead.
+ **/
+void BidSharedView::attach() {
+    const Control& c = *reinterpret_cast<const Control*>(control);
+    for (int attempt = 0; attempt < 100; attempt++) {
+        const uint64_t current = c.generation.load(std::memory_order_acquire);
+        if (current == 0) {
+            throw BidShmError("nothing published as " + name + " yet");
+        }
+        int fd = ::shm_open(imageName(name, current).c_str(), O_RDONLY, 0);
+        if (fd < 0) {
+            if (errno == ENOENT) continue;
+            throw BidShmError("cannot open shared memory " + imageName(name, current));
+        }
+        struct stat st{};
+        if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(Header)) {
+            ::close(fd);
+            throw BidShmError(imageName(name, current) + " is not a bid store image");
+        }
+        void* p = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) {
+            throw BidShmError("cannot map shared memory " + imageName(name, current));
+        }
+        const Header& h = *static_cast<const Header*>(p);
+        if (std::memcmp(h.magic, kImageMagic, sizeof(kImageMagic)) != 0 || h.generation != current) {
+            ::munmap(p, static_cast<size_t>(st.st_size));
+            throw BidShmError(imageName(name, current) + " is not a bid store image");
+        }
+        placeMapping(p, static_cast<size_t>(st.st_size), policy);
+        image = static_cast<const char*>(p);
+        imageBytes = static_cast<size_t>(st.st_size);
+        generation = current;
+        return;
+    }
+    throw BidShmError(name + " keeps being republished; could not attach");
+}
+
+void BidSharedView::detach() {
+    if (image != nullptr) {
+        ::munmap(const_cast<char*>(image), imageBytes);
+        image = nullptr;
+    }
+}
+
+#else
+
+uint64_t publishShared(const std::string&, const BidStore&) {
+    throw BidShmError("shared memory needs a POSIX system");
+}
+
+void unpublishShared(const std::string&) {}
+
+BidSharedView::BidSharedView(const std::string& storeName, const MemoryPolicy& memory)
+    : name(storeName), policy(memory) {
+    throw BidShmError("shared memory needs a POSIX system");
+}
+
+BidSharedView::~BidSharedView() {}
+void BidSharedView::attach() {}
+void BidSharedView::detach() {}
+
+#endif
+
+bool BidSharedView::Stale() const {
+    return reinterpret_cast<const Control*>(control)->generation.load(std::memory_order_acquire) != generation;
+}
+
+/**
+ * The new image is attached before the old one is let go, so a failed
+ * attach leaves the view on the old generation.
+ **/
+bool BidSharedView::Refresh() {
+    if (!Stale()) {
+        return false;
+    }
+    const char* oldImage = image;
+    const size_t oldBytes = imageBytes;
+    const uint64_t oldGeneration = generation;
+    image = nullptr;
+    try {
+        attach();
+    } catch (...) {
+        image = oldImage;
+        imageBytes = oldBytes;
+        generation = oldGeneration;
+        throw;
+    }
+#ifdef HAVE_SHM
+    ::munmap(const_cast<char*>(oldImage), oldBytes);
+#endif
+    return true;
+}
+
+const BidSharedView::Header& BidSharedView::header() const {
+    return *reinterpret_cast<const Header*>(image);
+}
+
+const BidSharedView::Record* BidSharedView::records() const {
+    return reinterpret_cast<const Record*>(image + sizeof(Header));
+}
+
+Bid BidSharedView::toBid(const Record& r) const {
+    const char* text = image + header().textOffset + r.text;
+    Bid bid;
+    bid.bidId.assign(text, r.idLength);
+    bid.title.assign(text + r.idLength, r.titleLength);
+    bid.fund.assign(text + r.idLength + r.titleLength, r.fundLength);
+    bid.amount = r.amount;
+    return bid;
+}
+
+void BidSharedView::Append(const Bid&) {
+    throw BidShmError(name + " is attached read-only");
+}
+
+void BidSharedView::Prepend(const Bid&) {
+    throw BidShmError(name + " is attached read-only");
+}
+
+bool BidSharedView::Remove(const std::string&) {
+    throw BidShmError(name + " is attached read-only");
+}
+
+Bid BidSharedView::Search(const std::string& bidId) const {
+    const Header& h = header();
+    const uint32_t* index = reinterpret_cast<const uint32_t*>(image + h.indexOffset);
+    const char* text = image + h.textOffset;
+    const uint64_t mask = h.indexSlots - 1;
+    for (uint64_t pos = hash64(bidId) & mask;; pos = (pos + 1) & mask) {
+        if (index[pos] == 0) {
+            return Bid{};
+        }
+        const Record& r = records()[index[pos] - 1];
+        if (std::string_view(text + r.text, r.idLength) == bidId) {
+            return toBid(r);
+        }
+    }
+}
+
+int BidSharedView::Size() const {
+    return static_cast<int>(header().count);
+}
+
+void BidSharedView::ForEach(const std::function<void(const Bid&)>& visit) const {
+    const uint64_t count = header().count;
+    for (uint64_t i = 0; i < count; i++) {
+        visit(toBid(records()[i]));
+    }
+}
+
+/**
+ * Part p gets records [p*n/parts, (p+1)*n/parts): the records are an
+ * array in store order, so there is nothing to walk to find a part.
+ **/
+size_t BidSharedView::ForEachParallel(unsigned threads,
+                                      const std::function<void(size_t part, const Bid&)>& visit) const {
+    const size_t n = static_cast<size_t>(header().count);
+    const size_t parts = std::min<size_t>(ResolveThreads(threads), n);
+    if (parts <= 1) {
+        return BidStore::ForEachParallel(threads, visit);
+    }
+
+    std::vector<std::exception_ptr> errors(parts);
+    auto walk = [&](size_t part) {
+        try {
+            for (size_t i = part * n / parts; i < (part + 1) * n / parts; i++) {
+                visit(part, toBid(records()[i]));
+            }
+        } catch (...) {
+            errors[part] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t p = 1; p < parts; p++) {
+        workers.emplace_back(walk, p);
+    }
+    walk(0);
+    for (std::thread& t : workers) {
+        t.join();
+    }
+    for (std::exception_ptr& e : errors) {
+        if (e) std::rethrow_exception(e);
+    }
+    return parts;
+}
@@ -0,0 +1,98 @@
+//============================================================================
+// Name        : BidShm.hpp
+//
+// Publishing a loaded store in POSIX shared memory, so other processes on
+// the host can read it without loading the CSV themselves. The loader runs
+// with --publish=NAME, the others with --attach=NAME.
+//
+// Why? Each tool that parses the same export into its own list pays the
+// parse time and holds its own copy. A published store is one read-only
+// image in RAM that every attached process maps; attaching costs a few
+// system calls, whatever the size.
+//
+// The image is position-independent - every process maps it at its own
+// address - so it holds offsets, never pointers:
+//
+//   [ header ][ records, store order ][ ID index ][ ID/title/fund bytes ]
+//
+// Republishing: each publish writes a fresh segment NAME.g<generation>,
+// and only when it is complete bumps the generation in the small control
+// segment NAME, then unlinks the previous one. A process already attached
+// keeps its mapping (the kernel frees the memory when the last one goes)
+// and sees Stale() turn true; Refresh() moves it to the new generation.
+// One publishing process per name. An attached image is placed per the
+// MemoryPolicy given (huge pages if the system allows them for shared
+// memory, mlock, prefault).
+//============================================================================
+
+#ifndef BID_SHM_HPP
+#define BID_SHM_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+
+#include "BidMemory.hpp"
+#include "BidStore.hpp"
+
+class BidShmError : public std::runtime_error {
+public:
+    BidShmError(const std::string& msg)
+        : std::runtime_error(std::string("BidShm : ").append(msg)) {}
+};
+
+// Write a read-only image of 'store' under 'name' and make it current.
+// @return the new generation (1 for the first publish of a name)
+uint64_t publishShared(const std::string& name, const BidStore& store);
+
+// Remove the name and its current image. Attached processes keep theirs.
+void unpublishShared(const std::string& name);
+
+class BidSharedView : public BidStore {
+public:
+    // Attaches to the current generation
+    explicit BidSharedView(const std::string& name, const MemoryPolicy& policy = MemoryPolicy());
+    ~BidSharedView() override;
+
+    BidSharedView(const BidSharedView&) = delete;
+    BidSharedView& operator=(const BidSharedView&) = delete;
+
+    // The image is read-only: these throw BidShmError
+    void Append(const Bid& bid) override;
+    void Prepend(const Bid& bid) override;
+    bool Remove(const std::string& bidId) override;
+
+    Bid Search(const std::string& bidId) const override;   // first bid with that ID
+    int Size() const override;
+    void ForEach(const std::function<void(const Bid&)>& visit) const override;
+    // Slices of the record array, each thread on its own run
+    size_t ForEachParallel(unsigned threads,
+                           const std::function<void(size_t part, const Bid&)>& visit) const override;
+
+    uint64_t Generation() const { return generation; }
+    bool Stale() const;    // a newer generation has been published
+    bool Refresh();        // attach to the newest one; false if already there
+    MemoryStats Memory() const { return memoryStats(image, imageBytes); }
+
+private:
+    struct Header;
+    struct Record;
+    friend uint64_t publishShared(const std::string& name, const BidStore& store);
+
+    void attach();
+    void detach();
+    const Header& header() const;
+    const Record* records() const;
+    Bid toBid(const Record& r) const;
+
+    std::string name;
+    const char* control      = nullptr;   // mapped control segment
+    const char* image        = nullptr;   // mapped current generation
+    size_t      imageBytes   = 0;
+    uint64_t    generation   = 0;
+    MemoryPolicy policy;
+};
+
+#endif // BID_SHM_HPP
@@ -0,0 +1,240 @@
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+#include "BidHash.hpp"
+#include "BidSketches.hpp"
+
+//----------------------------------------------------------------------------
+// HyperLogLog
+//----------------------------------------------------------------------------
+
+/**
+ * The top PRECISION bits of the hash pick a register; the register keeps the
+ * longest run of leading zeros seen in the remaining bits. Long runs are
+ * rare, so the longest run says roughly how many distinct values went by.
+ */
+void HyperLogLog::Add(const std::string& value) {
+    uint64_t h = hash64(value);
+    size_t index = static_cast<size_t>(h >> (64 - PRECISION));
+    uint64_t rest = h << PRECISION;
+    uint8_t rank = static_cast<uint8_t>(
+        std::min(std::countl_zero(rest), 64 - PRECISION) + 1);
+    if (rank > registers[index]) {
+        registers[index] = rank;
+    }
+}
+
+void HyperLogLog::Merge(const HyperLogLog& other) {
+    for (size_t i = 0; i < REGISTERS; i++) {
+        registers[i] = std::max(registers[i], other.registers[i]);
+    }
+}
+
+double HyperLogLog::Estimate() const {
+    const double m = static_cast<double>(REGISTERS);
+    double sum = 0.0;
+    size_t zeros = 0;
+    for (uint8_t r : registers) {
+        sum += std::ldexp(1.0, -r);
+        if (r == 0) zeros++;
+    }
+
+    double alpha = 0.7213 / (1.0 + 1.079 / m);
+    double estimate = alpha * m * m / sum;
+
+    // Small cardinalities: most registers are still empty, and counting the
+    // empty ones (linear counting) is far more accurate than the raw formula
+    if (estimate <= 2.5 * m && zeros > 0) {
+        estimate = m * std::log(m / static_cast<double>(zeros));
+    }
+    return estimate;
+}
+
+//----------------------------------------------------------------------------
+// TDigest (merging variant)
+//----------------------------------------------------------------------------
+
+void TDigest::Add(double value, double weight) {
+    buffer.push_back({value, weight});
+    totalWeight += weight;
+    if (buffer.size() >= static_cast<size_t>(compression * 5)) {
+        compress();
+    }
+}
+
+void TDigest::Merge(const TDigest& other) {
+    other.compress();
+    for (const Centroid& c : other.centroids) {
+        Add(c.mean, c.weight);
+    }
+}
+
+double TDigest::Count() const {
+    return totalWeight;
+}
+
+/**
+ * Fold the buffer into the centroid list.
+ * Neighbouring centroids are merged while the result stays under a size
+ * limit of 4 * n * q * (1 - q) / compression. The limit shrinks towards
+ * q = 0 and q = 1, which keeps the tails (p99) finely resolved.
+ */
+void TDigest::compress() const {
+    if (buffer.empty()) {
+        return;
+    }
+    std::vector<Centroid> all;
+    all.reserve(centroids.size() + buffer.size());
+    all.insert(all.end(), centroids.begin(), centroids.end());
+    all.insert(all.end(), buffer.begin(), buffer.end());
+    buffer.clear();
+    std::sort(all.begin(), all.end(),
+              [](const Centroid& a, const Centroid& b) { return a.mean < b.mean; });
+
+    std::vector<Centroid> merged;
+    Centroid current = all[0];
+    double weightBefore = 0.0;
+    for (size_t i = 1; i < all.size(); i++) {
+        double proposed = current.weight + all[i].weight;
+        double q = (weightBefore + proposed / 2.0) / totalWeight;
+        double limit = 4.0 * totalWeight * q * (1.0 - q) / compression;
+
+        if (proposed <= std::max(limit, 1.0)) {
+            current.mean += (all[i].mean - current.mean) * all[i].weight / proposed;
+            current.weight = proposed;
+        } else {
+            merged.push_back(current);
+            weightBefore += current.weight;
+            current = all[i];
+        }
+    }
+    merged.push_back(current);
+    centroids.swap(merged);
+}
+
+/**
+ * Each centroid is treated as sitting at the middle of the weight it
+ * covers; between two centres we interpolate linearly.
+ */
+double TDigest::Quantile(double q) const {
+    compress();
+    if (centroids.empty()) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    if (centroids.size() == 1 || q <= 0.0) {
+        return centroids.front().mean;
+    }
+    if (q >= 1.0) {
+        return centroids.back().mean;
+    }
+
+    double target = q * totalWeight;
+    double cumulative = 0.0;
+    for (size_t i = 0; i + 1 < centroids.size(); i++) {
+        double left = cumulative + centroids[i].weight / 2.0;
+        double right = cumulative + centroids[i].weight + centroids[i + 1].weight / 2.0;
+        if (target <= left) {
+            return centroids[i].mean;
+        }
+        if (target <= right) {
+            double fraction = (target - left) / (right - left);
+            return centroids[i].mean + fraction * (centroids[i + 1].mean - centroids[i].mean);
+        }
+        cumulative += centroids[i].weight;
+    }
+    return centroids.back().mean;
+}
+
+//----------------------------------------------------------------------------
+// CountMinSketch
+//----------------------------------------------------------------------------
+
+CountMinSketch::CountMinSketch(size_t width, size_t depth, size_t topK)
+    : width(width), depth(depth), topK(topK), counters(width * depth, 0) {}
+
+// Row r uses hash h1 + r * h2 (double hashing) - one string hash per item
+static size_t cell(uint64_t h1, uint64_t h2, size_t row, size_t width) {
+    return row * width + static_cast<size_t>((h1 + row * h2) % width);
+}
+
+void CountMinSketch::Add(const std::string& item, uint32_t count) {
+    uint64_t h1 = hash64(item);
+    uint64_t h2 = mixHash64(h1 ^ 0x9E3779B97F4A7C15ull) | 1;
+    uint32_t estimate = std::numeric_limits<uint32_t>::max();
+    for (size_t r = 0; r < depth; r++) {
+        uint32_t& c = counters[cell(h1, h2, r, width)];
+        c += count;
+        estimate = std::min(estimate, c);
+    }
+    trackCandidate(item, estimate);
+}
+
+uint32_t CountMinSketch::Estimate(const std::string& item) const {
+    uint64_t h1 = hash64(item);
+    uint64_t h2 = mixHash64(h1 ^ 0x9E3779B97F4A7C15ull) | 1;
+    uint32_t estimate = std::numeric_limits<uint32_t>::max();
+    for (size_t r = 0; r < depth; r++) {
+        estimate = std::min(estimate, counters[cell(h1, h2, r, width)]);
+    }
+    return estimate;
+}
+
+// Keep the k items with the highest estimates seen so far (k is small)
+void CountMinSketch::trackCandidate(const std::string& item, uint32_t estimate) {
+    for (auto& c : candidates) {
+        if (c.first == item) {
+            c.second = estimate;
+            return;
+        }
+    }
+    if (candidates.size() < topK) {
+        candidates.emplace_back(item, estimate);
+        return;
+    }
+    auto weakest = std::min_element(candidates.begin(), candidates.end(),
+        [](const auto& a, const auto& b) { return a.second < b.second; });
+    if (estimate > weakest->second) {
+        *weakest = {item, estimate};
+    }
+}
+
+void CountMinSketch::Merge(const CountMinSketch& other) {
+    for (size_t i = 0; i < counters.size() && i < other.counters.size(); i++) {
+        counters[i] += other.counters[i];
+    }
+    // Re-rank both candidate lists against the combined counters
+    auto previous = candidates;
+    previous.insert(previous.end(), other.candidates.begin(), other.candidates.end());
+    candidates.clear();
+    for (const auto& c : previous) {
+        trackCandidate(c.first, Estimate(c.first));
+    }
+}
+
+std::vector<std::pair<std::string, uint32_t>> CountMinSketch::TopK() const {
+    auto sorted = candidates;
+    std::sort(sorted.begin(), sorted.end(),
+              [](const auto& a, const auto& b) { return a.second > b.second; });
+    return sorted;
+}
+
+//----------------------------------------------------------------------------
+// LoadSketches
+//----------------------------------------------------------------------------
+
+void LoadSketches::Add(const std::string& fund, const std::string& department,
+                       double amount, const std::string& title) {
+    funds.Add(fund);
+    departments.Add(department);
+    amounts.Add(amount);
+    titles.Add(title);
+}
+
+void LoadSketches::Merge(const LoadSketches& other) {
+    funds.Merge(other.funds);
+    departments.Merge(other.departments);
+    amounts.Merge(other.amounts);
+    titles.Merge(other.titles);
+}
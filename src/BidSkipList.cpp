@@ -0,0 +1,243 @@
+#include <new>
+
+#include "BidSkipList.hpp"
+
+/**
+ * Memory layout of one node, lowest address first:
+ *
+ *   [ next[height-1] ... next[1] next[0] ][ value small height ][ bid ]
+ *                                          ^ Node* points here
+ *
+ * next(level) indexes backwards from the node, so next[0] - the link used
+ * most - sits right beside the key.
+ */
+struct BidSkipList::Node {
+    uint64_t value;
+    bool     small;
+    uint8_t  height;
+    Bid      bid;
+
+    std::atomic<Node*>& next(int level) const {
+        return reinterpret_cast<std::atomic<Node*>*>(const_cast<Node*>(this))[-1 - level];
+    }
+    Key key() const { return {small, value, &bid.bidId}; }
+};
+
+BidSkipList::Key BidSkipList::makeKey(const std::string& id) {
+    Key key{false, 0, &id};
+    key.small = bidIdNumber(id, key.value);
+    return key;
+}
+
+bool BidSkipList::keyLess(const Key& a, const Key& b) {
+    if (a.small && b.small) {
+        return a.value < b.value;
+    }
+    return bidIdLess(*a.id, *b.id);
+}
+
+BidSkipList::Node* BidSkipList::allocateNode(const Bid* bid, int height) {
+    const size_t towerBytes = static_cast<size_t>(height) * sizeof(std::atomic<Node*>);
+    char* raw = static_cast<char*>(::operator new(towerBytes + sizeof(Node)));
+    for (int i = 0; i < height; i++) {
+        new (raw + i * sizeof(std::atomic<Node*>)) std::atomic<Node*>(nullptr);
+    }
+    Node* node = new (raw + towerBytes) Node{0, false, static_cast<uint8_t>(height), bid ? *bid : Bid()};
+    Key key = makeKey(node->bid.bidId);
+    node->value = key.value;
+    node->small = key.small;
+    return node;
+}
+
+void BidSkipList::freeNode(Node* node) {
+    char* raw = reinterpret_cast<char*>(node) - node->height * sizeof(std::atomic<Node*>);
+    node->~Node();
+    ::operator delete(raw);
+}
+
+BidSkipList::BidSkipList(uint64_t seed) : head(allocateNode(nullptr, kMaxHeight)), rng(seed | 1) {}
+
+BidSkipList::~BidSkipList() {
+    Node* current = head->next(0).load(std::memory_order_relaxed);
+    while (current != nullptr) {
+        Node* nextNode = current->next(0).load(std::memory_order_relaxed);
+        freeNode(current);
+        current = nextNode;
+    }
+    for (Node* node : retired) {
+        freeNode(node);
+    }
+    freeNode(head);
+}
+
+BidSkipList::ReadGuard::ReadGuard(const BidSkipList& l) : list(l) {
+    list.readers.fetch_add(1, std::memory_order_seq_cst);
+    // Pairs with the fence in reclaim(): either the writer sees us here, or
+    // we only see links written after its node was taken out
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+BidSkipList::ReadGuard::~ReadGuard() {
+    list.readers.fetch_sub(1, std::memory_order_release);
+}
+
+// xorshift64*; each extra level has probability 1/4
+int BidSkipList::randomHeight() {
+    rng ^= rng >> 12;
+    rng ^= rng << 25;
+    rng ^= rng >> 27;
+    uint64_t r = rng * 0x2545F4914F6CDD1Dull;
+    int h = 1;
+    while (h < kMaxHeight && (r & 3) == 0) {
+        h++;
+        r >>= 2;
+    }
+    return h;
+}
+
+void BidSkipList::Append(const Bid& bid) {
+    insert(bid, false);
+}
+
+void BidSkipList::Prepend(const Bid& bid) {
+    insert(bid, true);
+}
+
+/**
+ * Find the last node before the insert position on every level, then link
+ * the new node in from the bottom up. Its own links are set first, so by
+ * the time a reader can reach it, it already leads somewhere valid.
+ */
+void BidSkipList::insert(const Bid& bid, bool beforeEqual) {
+    std::lock_guard<std::mutex> lock(writeLock);
+
+    const int h = randomHeight();
+    Node* node = allocateNode(&bid, h);
+    const Key key = node->key();
+
+    Node* preds[kMaxHeight];
+    Node* x = head;
+    for (int level = kMaxHeight - 1; level >= 0; level--) {
+        Node* nx;
+        while ((nx = x->next(level).load(std::memory_order_relaxed)) != nullptr &&
+               (beforeEqual ? keyLess(nx->key(), key) : !keyLess(key, nx->key()))) {
+            x = nx;
+        }
+        preds[level] = x;
+    }
+
+    for (int level = 0; level < h; level++) {
+        node->next(level).store(preds[level]->next(level).load(std::memory_order_relaxed),
+                                std::memory_order_relaxed);
+    }
+    for (int level = 0; level < h; level++) {
+        preds[level]->next(level).store(node, std::memory_order_release);
+    }
+    if (h > height.load(std::memory_order_relaxed)) {
+        height.store(h, std::memory_order_release);
+    }
+    count.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * Unlink the first node with this exact ID from every level it is on.
+ * Its own links stay intact, so a reader standing on it can still move on.
+ */
+bool BidSkipList::Remove(const std::string& bidId) {
+    std::lock_guard<std::mutex> lock(writeLock);
+    const Key key = makeKey(bidId);
+
+    Node* preds[kMaxHeight];
+    Node* x = head;
+    for (int level = kMaxHeight - 1; level >= 0; level--) {
+        Node* nx;
+        while ((nx = x->next(level).load(std::memory_order_relaxed)) != nullptr && keyLess(nx->key(), key)) {
+            x = nx;
+        }
+        preds[level] = x;
+    }
+
+    // "7" and "007" sort together; step over equal-sorting IDs to the exact one
+    Node* target = preds[0]->next(0).load(std::memory_order_relaxed);
+    while (target != nullptr && !keyLess(key, target->key()) && target->bid.bidId != bidId) {
+        target = target->next(0).load(std::memory_order_relaxed);
+    }
+    if (target == nullptr || target->bid.bidId != bidId) {
+        return false;
+    }
+
+    for (int level = target->height - 1; level >= 0; level--) {
+        Node* p = preds[level];
+        while (p->next(level).load(std::memory_order_relaxed) != target) {
+            p = p->next(level).load(std::memory_order_relaxed);
+        }
+        p->next(level).store(target->next(level).load(std::memory_order_relaxed), std::memory_order_release);
+    }
+    count.fetch_sub(1, std::memory_order_relaxed);
+
+    retired.push_back(target);
+    reclaim();
+    return true;
+}
+
+/**
+ * Free unlinked nodes if no reader is inside the list right now.
+ * Otherwise they wait for a later write (or the destructor).
+ */
+void BidSkipList::reclaim() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (readers.load(std::memory_order_seq_cst) != 0) {
+        return;
+    }
+    for (Node* node : retired) {
+        freeNode(node);
+    }
+    retired.clear();
+}
+
+// First node whose key is not below 'key' (nullptr past the end)
+const BidSkipList::Node* BidSkipList::firstNotBelow(const Key& key) const {
+    const Node* x = head;
+    for (int level = height.load(std::memory_order_acquire) - 1; level >= 0; level--) {
+        const Node* nx;
+        while ((nx = x->next(level).load(std::memory_order_acquire)) != nullptr && keyLess(nx->key(), key)) {
+            x = nx;
+        }
+    }
+    return x->next(0).load(std::memory_order_acquire);
+}
+
+Bid BidSkipList::Search(const std::string& bidId) const {
+    ReadGuard guard(*this);
+    const Key key = makeKey(bidId);
+    for (const Node* n = firstNotBelow(key); n != nullptr && !keyLess(key, n->key());
+         n = n->next(0).load(std::memory_order_acquire)) {
+        if (n->bid.bidId == bidId) {
+            return n->bid;
+        }
+    }
+    return Bid{};
+}
+
+int BidSkipList::Size() const {
+    return count.load(std::memory_order_relaxed);
+}
+
+void BidSkipList::ForEach(const std::function<void(const Bid&)>& visit) const {
+    ReadGuard guard(*this);
+    for (const Node* n = head->next(0).load(std::memory_order_acquire); n != nullptr;
+         n = n->next(0).load(std::memory_order_acquire)) {
+        visit(n->bid);
+    }
+}
+
+void BidSkipList::ForEachInRange(const std::string& first, const std::string& last,
+                                 const std::function<void(const Bid&)>& visit) const {
+    ReadGuard guard(*this);
+    const Key lo = makeKey(first);
+    const Key hi = makeKey(last);
+    for (const Node* n = firstNotBelow(lo); n != nullptr && !keyLess(hi, n->key());
+         n = n->next(0).load(std::memory_order_acquire)) {
+        visit(n->bid);
+    }
+}
@@ -0,0 +1,99 @@
+//============================================================================
+// Name        : BidSkipList.hpp
+//
+// Bid store kept sorted by ID (see bidIdLess) in a skip list: O(log n)
+// Search/Remove, listing in ID order and ID range scans. Selected with
+// --store=skiplist.
+//
+// Why a skip list? It keeps order with nothing but forward links, so
+// inserting touches only the few nodes in front of the new one. That makes
+// it simple to let readers walk it while a writer changes it.
+//
+// Cache-conscious layout: each node's tower of forward links is allocated
+// in the same block, directly in front of the node's sort key. A search
+// compares the key and follows a link on the same cache line, and only
+// touches the Bid itself once it has arrived. Heights are random with
+// p = 1/4, so the average node carries 1.33 links instead of 2.
+//
+// Concurrency: any number of readers (Search, ForEach, ForEachInRange,
+// Size) may run in parallel with each other and with one writer, without
+// locks. Writers take a mutex. A node is published by linking it bottom-up
+// with release stores, so a reader that can see a node can also see its
+// contents. A removed node is only freed once no reader is inside the list,
+// because one might still be standing on it.
+//============================================================================
+
+#ifndef BID_SKIP_LIST_HPP
+#define BID_SKIP_LIST_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "BidStore.hpp"
+
+class BidSkipList : public BidStore {
+public:
+    explicit BidSkipList(uint64_t seed = 0x9E3779B97F4A7C15ull);
+    ~BidSkipList() override;
+
+    BidSkipList(const BidSkipList&) = delete;
+    BidSkipList& operator=(const BidSkipList&) = delete;
+
+    // Both insert in ID order. Among equal IDs, Append goes after the
+    // existing ones and Prepend before them, like the list.
+    void Append(const Bid& bid) override;
+    void Prepend(const Bid& bid) override;
+    bool Remove(const std::string& bidId) override;
+    Bid Search(const std::string& bidId) const override;
+    int Size() const override;
+    void ForEach(const std::function<void(const Bid&)>& visit) const override;
+
+    // Walks only the IDs in range, no sort
+    void ForEachInRange(const std::string& first, const std::string& last,
+                        const std::function<void(const Bid&)>& visit) const override;
+
+    static constexpr int kMaxHeight = 16;   // 4^16 bids before levels run out
+
+private:
+    struct Node;
+
+    // Sort key: short numeric IDs compare as integers, no string work
+    struct Key {
+        bool        small;   // all digits and fits in 64 bits
+        uint64_t    value;
+        const std::string* id;
+    };
+
+    // Counts readers inside the list; removed nodes wait while it's non-zero
+    class ReadGuard {
+    public:
+        explicit ReadGuard(const BidSkipList& list);
+        ~ReadGuard();
+    private:
+        const BidSkipList& list;
+    };
+
+    static Key makeKey(const std::string& id);
+    static bool keyLess(const Key& a, const Key& b);
+    static Node* allocateNode(const Bid* bid, int height);
+    static void freeNode(Node* node);
+
+    int randomHeight();
+    void insert(const Bid& bid, bool beforeEqual);
+    const Node* firstNotBelow(const Key& key) const;
+    void reclaim();
+
+    Node*                    head;
+    std::atomic<int>         height{1};
+    std::atomic<int>         count{0};
+    mutable std::atomic<int> readers{0};
+    std::mutex               writeLock;
+    std::vector<Node*>       retired;   // unlinked, waiting for readers to leave
+    uint64_t                 rng;
+};
+
+#endif // BID_SKIP_LIST_HPP
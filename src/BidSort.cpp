@@ -0,0 +1,129 @@
+#include <algorithm>
+#include <barrier>
+#include <bit>
+#include <cmath>
+#include <memory>
+#include <thread>
+
+#include "BidSort.hpp"
+
+static constexpr unsigned kMaxDigitBits = 11;
+static constexpr size_t   kMaxBuckets = size_t(1) << kMaxDigitBits;
+static constexpr size_t   kMinPerThread = 1 << 16;   // below this a thread costs more than it saves
+
+uint64_t amountSortKey(double amount) {
+    double cents = std::round(amount * 100.0);
+    int64_t value = 0;
+    if (cents >= 9.2e18) {
+        value = INT64_MAX;
+    } else if (cents <= -9.2e18) {
+        value = INT64_MIN;
+    } else if (cents == cents) {   // NaN sorts as 0
+        value = static_cast<int64_t>(cents);
+    }
+    // Flipping the sign bit puts negatives below positives as unsigned
+    return static_cast<uint64_t>(value) ^ (uint64_t(1) << 63);
+}
+
+// One thread's digit counts, later its write offsets; a cache line apart
+struct alignas(64) RadixCounts {
+    size_t at[kMaxBuckets];
+};
+
+/**
+ * Each thread owns slice [t*n/T, (t+1)*n/T) of the source for the whole
+ * sort. Per pass: count the slice's digits, wait, move the slice to the
+ * offsets worked out (once, by the barrier) from everyone's counts, wait.
+ * The first phase finds which key bits vary at all. Only those are sorted
+ * on, in as few passes of up to kMaxDigitBits as cover them: amounts up to
+ * $167k in cents (24 bits) take 3 passes of 8 bits, 8-digit IDs (27 bits)
+ * 3 passes of 9.
+ */
+void radixSort(std::vector<BidSortEntry>& entries, unsigned threads) {
+    const size_t n = entries.size();
+    if (n < 2) {
+        return;
+    }
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = static_cast<unsigned>(std::clamp<size_t>(n / kMinPerThread, 1, threads));
+
+    // Left uninitialized: zeroing it would be one more pass over memory
+    std::unique_ptr<BidSortEntry[]> buffer(new BidSortEntry[n]);
+    BidSortEntry *src = entries.data(), *dst = buffer.get();
+
+    std::vector<RadixCounts> counts(threads);
+    std::vector<uint64_t>    varying(threads, 0);   // per thread: key bits that differ from key 0
+    std::vector<unsigned>    shifts;                // digits to sort on, lowest first
+    unsigned digitBits = 0;
+    size_t pass = 0;
+
+    auto plan = [&]() noexcept {
+        uint64_t bits = 0;
+        for (uint64_t v : varying) bits |= v;
+        if (bits == 0) {
+            return;   // all keys equal
+        }
+        const unsigned low = std::countr_zero(bits), span = 64 - std::countl_zero(bits) - low;
+        const unsigned passes = (span + kMaxDigitBits - 1) / kMaxDigitBits;
+        digitBits = (span + passes - 1) / passes;
+        for (unsigned p = 0; p < passes; p++) {
+            shifts.push_back(low + p * digitBits);
+        }
+    };
+    auto offsets = [&]() noexcept {
+        size_t next = 0;
+        for (size_t d = 0; d < (size_t(1) << digitBits); d++) {
+            for (unsigned t = 0; t < threads; t++) {
+                size_t c = counts[t].at[d];
+                counts[t].at[d] = next;
+                next += c;
+            }
+        }
+    };
+    auto swapBuffers = [&]() noexcept {
+        std::swap(src, dst);
+        pass++;
+    };
+
+    std::barrier planned(threads, plan);
+    std::barrier counted(threads, offsets);
+    std::barrier moved(threads, swapBuffers);
+
+    auto work = [&](unsigned t) {
+        const size_t begin = t * n / threads, end = (t + 1) * n / threads;
+        const uint64_t first = entries[0].key;
+        uint64_t bits = 0;
+        for (size_t i = begin; i < end; i++) bits |= entries[i].key ^ first;
+        varying[t] = bits;
+        planned.arrive_and_wait();
+
+        const uint64_t mask = (uint64_t(1) << digitBits) - 1;
+        for (size_t p = 0; p < shifts.size(); p++) {
+            const unsigned shift = shifts[p];
+            size_t *at = counts[t].at;
+            std::fill(at, at + mask + 1, 0);
+            for (size_t i = begin; i < end; i++) {
+                at[(src[i].key >> shift) & mask]++;
+            }
+            counted.arrive_and_wait();
+            for (size_t i = begin; i < end; i++) {
+                dst[at[(src[i].key >> shift) & mask]++] = src[i];
+            }
+            moved.arrive_and_wait();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threads; t++) {
+        workers.emplace_back(work, t);
+    }
+    work(0);
+    for (std::thread& w : workers) {
+        w.join();
+    }
+    if (pass % 2 == 1) {
+        std::copy(buffer.get(), buffer.get() + n, entries.begin());   // the last pass wrote there
+    }
+}
@@ -0,0 +1,44 @@
+//============================================================================
+// Name        : BidSort.hpp
+//
+// Sorting bids by amount or ID for reports, used by LinkedList::Sort.
+//
+// Why not std::sort? Over millions of bids a comparison sort does
+// n log n comparisons, each a branch the CPU can't predict and, if it
+// compares Bids, a pointer chase into the node. Here the list first copies
+// one integer key per bid (amount in cents, or the ID's number) next to its
+// node pointer into a flat array. An LSD radix sort then orders that array
+// one byte of the key at a time: count the byte values, turn the counts
+// into offsets, move every entry to its offset. That is a few sequential
+// passes with no comparisons at all, and each pass is stable, so bids with
+// equal keys keep their list order.
+//
+// Parallel: every thread counts its own slice of the array, the offsets
+// are handed out per thread (all of thread 0's 'zero' bytes before thread
+// 1's, and so on), and every thread moves its slice. Passes for bytes that
+// are the same in every key (the high bytes of small amounts) are skipped.
+//============================================================================
+
+#ifndef BID_SORT_HPP
+#define BID_SORT_HPP
+
+#include <cstdint>
+#include <vector>
+
+// One bid to sort: its key and whatever the caller needs to find it again
+struct BidSortEntry {
+    uint64_t key;
+    void*    item;
+};
+
+enum class BidSortKey { AMOUNT, ID };
+
+// Amount in whole cents, mapped so unsigned order is amount order
+// (negative amounts first)
+uint64_t amountSortKey(double amount);
+
+// Stable sort by key; 0 threads = one per hardware thread. Small arrays
+// are sorted on the calling thread.
+void radixSort(std::vector<BidSortEntry>& entries, unsigned threads = 0);
+
+#endif // BID_SORT_HPP
@@ -0,0 +1,253 @@
+#include <algorithm>
+#include <cstdio>
+
+#include "BidCodec.hpp"
+#include "BidSpill.hpp"
+
+static constexpr uint64_t kPageAlign = 4096;
+
+// Memory a resident bid takes: the struct, plus string buffers too long
+// to be stored inside it
+static uint64_t bidBytes(const Bid& bid) {
+    auto heap = [](const std::string& s) {
+        return s.capacity() > std::string().capacity() ? s.capacity() + 1 : 0;
+    };
+    return sizeof(Bid) + heap(bid.bidId) + heap(bid.title) + heap(bid.fund);
+}
+
+BidSpillStore::BidSpillStore(const std::string& spillPath, uint64_t budgetBytes, uint32_t bidsPerSegment)
+    : path(spillPath), budget(budgetBytes), segmentBids(std::max<uint32_t>(bidsPerSegment, 1)) {
+    file.open(path, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        throw BidSpillError("cannot create " + path);
+    }
+}
+
+BidSpillStore::~BidSpillStore() {
+    file.close();
+    std::remove(path.c_str());
+}
+
+/**
+ * Segments before 'a's come first; within one, slots count up, or down
+ * for a segment filled by Prepend.
+ **/
+bool BidSpillStore::before(const Location& a, const Location& b) const {
+    const Segment& sa = segments[a.segment];
+    const Segment& sb = segments[b.segment];
+    if (sa.order != sb.order) {
+        return sa.order < sb.order;
+    }
+    return sa.reversed ? a.slot > b.slot : a.slot < b.slot;
+}
+
+uint32_t BidSpillStore::newSegment(bool reversed) {
+    const uint32_t number = static_cast<uint32_t>(segments.size());
+    segments.emplace_back();
+    Segment& s = segments.back();
+    s.reversed = reversed;
+    if (sequence.empty()) {
+        s.order = firstOrder = lastOrder = 0;
+    } else {
+        s.order = reversed ? --firstOrder : ++lastOrder;
+    }
+    if (reversed) {
+        sequence.push_front(number);
+    } else {
+        sequence.push_back(number);
+    }
+    lru.push_front(number);
+    s.lru = lru.begin();
+    return number;
+}
+
+/**
+ * Adds to the segment taking appends (or prepends), starting a new one
+ * when it is full. That segment is pinned, so it is always resident.
+ **/
+void BidSpillStore::add(const Bid& bid, uint32_t& target, bool front) {
+    if (target == kNone || segments[target].slots == segmentBids) {
+        target = newSegment(front);
+    }
+    Segment& s = segments[target];
+    const uint32_t slot = s.slots++;
+    s.bids.push_back(bid);
+    s.removed.push_back(0);
+    s.dirty = true;
+    const uint64_t bytes = bidBytes(s.bids.back());
+    s.bytes += bytes;
+    residentBytes += bytes;
+
+    std::vector<Location>& at = ids[bid.bidId];
+    at.push_back(Location{target, slot});
+    count++;
+    lru.splice(lru.begin(), lru, s.lru);
+    evictOver(target);
+}
+
+void BidSpillStore::Append(const Bid& bid) {
+    add(bid, appendTo, false);
+}
+
+void BidSpillStore::Prepend(const Bid& bid) {
+    add(bid, prependTo, true);
+}
+
+/**
+ * Only the removed flag changes, and that is always in memory: no page is
+ * read or rewritten.
+ **/
+bool BidSpillStore::Remove(const std::string& bidId) {
+    auto it = ids.find(bidId);
+    if (it == ids.end()) {
+        return false;
+    }
+    std::vector<Location>& at = it->second;
+    auto first = std::min_element(at.begin(), at.end(),
+                                  [&](const Location& a, const Location& b) { return before(a, b); });
+    segments[first->segment].removed[first->slot] = 1;
+    at.erase(first);
+    if (at.empty()) {
+        ids.erase(it);
+    }
+    count--;
+    return true;
+}
+
+Bid BidSpillStore::Search(const std::string& bidId) const {
+    auto it = ids.find(bidId);
+    if (it == ids.end()) {
+        return Bid{};
+    }
+    const std::vector<Location>& at = it->second;
+    const Location& first = *std::min_element(at.begin(), at.end(),
+                                              [&](const Location& a, const Location& b) { return before(a, b); });
+    return fault(first.segment, false).bids[first.slot];
+}
+
+void BidSpillStore::ForEach(const std::function<void(const Bid&)>& visit) const {
+    try {
+        for (uint32_t number : sequence) {
+            const Segment& s = fault(number, true);
+            scanning = number;
+            for (uint32_t i = 0; i < s.slots; i++) {
+                const uint32_t slot = s.reversed ? s.slots - 1 - i : i;
+                if (!s.removed[slot]) {
+                    visit(s.bids[slot]);
+                }
+            }
+        }
+    } catch (...) {
+        scanning = kNone;
+        throw;
+    }
+    scanning = kNone;
+}
+
+SpillStats BidSpillStore::Stats() const {
+    SpillStats stats;
+    stats.segments = segments.size();
+    stats.resident = lru.size();
+    stats.residentBytes = residentBytes;
+    stats.budgetBytes = budget;
+    stats.fileBytes = fileEnd;
+    stats.faults = faults;
+    stats.evictions = evictions;
+    return stats;
+}
+
+BidSpillStore::Segment& BidSpillStore::fault(uint32_t number, bool scan) const {
+    Segment& s = segments[number];
+    if (s.resident) {
+        if (!scan) lru.splice(lru.begin(), lru, s.lru);
+        return s;
+    }
+    readPage(number);
+    faults++;
+    s.resident = true;
+    residentBytes += s.bytes;
+    // A scan moves on right away: its segments are the first to go again
+    s.lru = scan ? lru.insert(lru.end(), number) : lru.insert(lru.begin(), number);
+    evictOver(number);
+    return s;
+}
+
+/**
+ * From the least recently used end, skipping the segments taking appends
+ * and prepends, the one being scanned, and 'keep' (just added to or read).
+ **/
+void BidSpillStore::evictOver(uint32_t keep) const {
+    auto it = lru.end();
+    while (residentBytes > budget && it != lru.begin()) {
+        --it;
+        const uint32_t number = *it;
+        if (number == keep || number == appendTo || number == prependTo || number == scanning) {
+            continue;
+        }
+        Segment& s = segments[number];
+        if (s.dirty) {
+            writePage(number);
+        }
+        std::vector<Bid>().swap(s.bids);
+        s.resident = false;
+        residentBytes -= s.bytes;
+        evictions++;
+        it = lru.erase(it);
+    }
+}
+
+/**
+ * Page layout: u32 bid count, the bids (ByteWriter::bid), u32 CRC of
+ * everything before it, zero padding to 4 KiB. Written over its old page
+ * if it still fits there, otherwise at the end of the file.
+ **/
+void BidSpillStore::writePage(uint32_t number) const {
+    Segment& s = segments[number];
+    std::string page;
+    ByteWriter out(page);
+    out.u32(s.slots);
+    for (const Bid& bid : s.bids) {
+        out.bid(bid);
+    }
+    out.u32(crc32Update(page.data(), page.size()));
+    page.resize((page.size() + kPageAlign - 1) / kPageAlign * kPageAlign, '\0');
+
+    if (page.size() > s.pageBytes) {
+        s.pageOffset = fileEnd;
+        fileEnd += page.size();
+    }
+    s.pageBytes = page.size();
+    file.seekp(static_cast<std::streamoff>(s.pageOffset));
+    file.write(page.data(), static_cast<std::streamsize>(page.size()));
+    file.flush();
+    if (!file) {
+        file.clear();
+        throw BidSpillError("cannot write " + path);
+    }
+    s.dirty = false;
+}
+
+void BidSpillStore::readPage(uint32_t number) const {
+    Segment& s = segments[number];
+    std::string page(s.pageBytes, '\0');
+    file.seekg(static_cast<std::streamoff>(s.pageOffset));
+    file.read(page.data(), static_cast<std::streamsize>(page.size()));
+    if (!file) {
+        file.clear();
+        throw BidSpillError("cannot read " + path);
+    }
+
+    ByteReader in(page.data(), page.size());
+    uint32_t slots = 0;
+    bool ok = in.u32(slots) && slots == s.slots;
+    s.bids.resize(slots);
+    for (uint32_t i = 0; ok && i < slots; i++) {
+        ok = in.bid(s.bids[i]);
+    }
+    const size_t used = page.size() - in.remaining();
+    uint32_t crc = 0;
+    if (!ok || !in.u32(crc) || crc != crc32Update(page.data(), used)) {
+        std::vector<Bid>().swap(s.bids);
+        throw BidSpillError("page of segment " + std::to_string(number) + " in " + path + " is damaged");
+    }
+}
@@ -0,0 +1,139 @@
+//============================================================================
+// Name        : BidSpill.hpp
+//
+// Insertion-ordered bid store that stays within a memory budget by moving
+// cold parts of the list to a spill file. Selected with --store=spill
+// (--memory-budget=MB, --spill-file=PATH).
+//
+// Why? A historical dataset can have more bids than fit in RAM as Bid
+// objects. Here the list is cut into segments of consecutive bids (an
+// insertion range: 4096 appends, or 4096 prepends), and only as many
+// segments stay in memory as the budget allows:
+//
+// - The ID index and a removed flag per bid always stay in memory, so
+//   Search knows which segment to read and Remove reads nothing at all.
+// - Over the budget, the least recently used segment is written to the
+//   spill file as one compact page (the bids encoded back to back, padded
+//   to 4 KiB, with a CRC) and dropped from memory. A segment is written
+//   once; after that, evicting it again costs nothing.
+// - Touching a spilled segment reads its page back (a fault) and makes it
+//   the most recently used one.
+// - A full scan reads each spilled segment once, and those segments are
+//   queued to be evicted first, so a scan doesn't push the hot segments
+//   (those being searched) out of memory.
+// - The segments taking appends and prepends are never evicted.
+//
+// So past the budget an operation costs at most one page read for Search,
+// none for Remove, Append and Prepend, and one sequential pass over the
+// file for a scan.
+//
+// The spill file only lives as long as the store. One thread at a time,
+// including the const calls (they can fault segments in).
+//============================================================================
+
+#ifndef BID_SPILL_HPP
+#define BID_SPILL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <list>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "BidStore.hpp"
+
+class BidSpillError : public std::runtime_error {
+public:
+    BidSpillError(const std::string& msg)
+        : std::runtime_error(std::string("BidSpill : ").append(msg)) {}
+};
+
+struct SpillStats {
+    size_t   segments      = 0;
+    size_t   resident      = 0;   // segments in memory
+    uint64_t residentBytes = 0;   // their bids, estimated
+    uint64_t budgetBytes   = 0;
+    uint64_t fileBytes     = 0;   // pages in the spill file
+    uint64_t faults        = 0;   // segments read back
+    uint64_t evictions     = 0;   // segments dropped from memory
+};
+
+class BidSpillStore : public BidStore {
+public:
+    static constexpr uint32_t kSegmentBids = 4096;
+
+    // Creates (or truncates) the spill file; it is removed again on destruction
+    BidSpillStore(const std::string& spillPath, uint64_t budgetBytes, uint32_t segmentBids = kSegmentBids);
+    ~BidSpillStore() override;
+
+    BidSpillStore(const BidSpillStore&) = delete;
+    BidSpillStore& operator=(const BidSpillStore&) = delete;
+
+    void Append(const Bid& bid) override;
+    void Prepend(const Bid& bid) override;
+    bool Remove(const std::string& bidId) override;        // first bid with that ID
+    Bid Search(const std::string& bidId) const override;   // first bid with that ID
+    int Size() const override { return count; }
+    void ForEach(const std::function<void(const Bid&)>& visit) const override;
+
+    SpillStats Stats() const;
+
+private:
+    static constexpr uint32_t kNone = UINT32_MAX;
+
+    struct Location {
+        uint32_t segment;
+        uint32_t slot;
+    };
+    struct Segment {
+        int64_t              order    = 0;       // place in the list among segments
+        bool                 reversed = false;   // filled by Prepend: the last slot comes first
+        uint32_t             slots    = 0;       // bids ever added, removed ones included
+        std::vector<uint8_t> removed;            // per slot, always in memory
+        std::vector<Bid>     bids;               // only while resident
+        bool                 resident = true;
+        bool                 dirty    = true;    // differs from its page (or has none)
+        uint64_t             pageOffset = 0;
+        uint64_t             pageBytes  = 0;     // 0: never written
+        uint64_t             bytes      = 0;     // memory of 'bids', estimated
+        std::list<uint32_t>::iterator lru;       // valid while resident
+    };
+
+    bool before(const Location& a, const Location& b) const;   // list order
+    uint32_t newSegment(bool reversed);
+    void add(const Bid& bid, uint32_t& target, bool front);
+
+    // Make a segment resident; 'scan' queues it for eviction first
+    Segment& fault(uint32_t segment, bool scan) const;
+    void evictOver(uint32_t keep) const;    // down to the budget, never 'keep' or a pinned one
+    void writePage(uint32_t segment) const;
+    void readPage(uint32_t segment) const;
+
+    std::string      path;
+    uint64_t         budget;
+    uint32_t         segmentBids;
+    int              count = 0;
+    mutable std::fstream file;
+    mutable uint64_t fileEnd = 0;
+
+    mutable std::vector<Segment>  segments;
+    std::deque<uint32_t>          sequence;   // segment numbers in list order
+    int64_t                       firstOrder = 0;
+    int64_t                       lastOrder  = 0;
+    uint32_t                      appendTo   = kNone;
+    uint32_t                      prependTo  = kNone;
+    std::unordered_map<std::string, std::vector<Location>> ids;
+
+    mutable std::list<uint32_t> lru;            // resident segments, most recent first
+    mutable uint64_t            residentBytes = 0;
+    mutable uint64_t            faults        = 0;
+    mutable uint64_t            evictions     = 0;
+    mutable uint32_t            scanning      = kNone;   // in use by ForEach, not to be evicted
+};
+
+#endif // BID_SPILL_HPP
@@ -0,0 +1,114 @@
+#include <algorithm>
+#include <thread>
+
+#include "BidStore.hpp"
+
+std::vector<Bid> BidStore::SearchBatch(const std::vector<std::string>& bidIds) const {
+    std::vector<Bid> found;
+    found.reserve(bidIds.size());
+    for (const std::string& id : bidIds) {
+        found.push_back(Search(id));
+    }
+    return found;
+}
+
+std::vector<Bid> BidStore::Snapshot() const {
+    std::vector<Bid> bids;
+    bids.reserve(Size());
+    ForEach([&](const Bid& b) { bids.push_back(b); });
+    return bids;
+}
+
+void BidStore::ForEachInFund(const std::string& fund, const std::function<void(const Bid&)>& visit) const {
+    ForEach([&](const Bid& b) {
+        if (b.fund == fund) visit(b);
+    });
+}
+
+int BidStore::FundSize(const std::string& fund) const {
+    int count = 0;
+    ForEach([&](const Bid& b) {
+        if (b.fund == fund) count++;
+    });
+    return count;
+}
+
+void BidStore::ForEachInRange(const std::string& first, const std::string& last,
+                              const std::function<void(const Bid&)>& visit) const {
+    std::vector<Bid> matches;
+    ForEach([&](const Bid& b) {
+        if (!bidIdLess(b.bidId, first) && !bidIdLess(last, b.bidId)) matches.push_back(b);
+    });
+    std::stable_sort(matches.begin(), matches.end(),
+                     [](const Bid& a, const Bid& b) { return bidIdLess(a.bidId, b.bidId); });
+    for (const Bid& b : matches) visit(b);
+}
+
+void BidStore::ForEachInAmountRange(double low, double high,
+                                    const std::function<void(const Bid&)>& visit) const {
+    std::vector<Bid> matches;
+    ForEach([&](const Bid& b) {
+        if (b.amount >= low && b.amount <= high) matches.push_back(b);
+    });
+    std::stable_sort(matches.begin(), matches.end(),
+                     [](const Bid& a, const Bid& b) { return a.amount < b.amount; });
+    for (const Bid& b : matches) visit(b);
+}
+
+// Per-part results, a cache line each so parts don't slow each other down
+struct alignas(64) BidPartMatches {
+    std::vector<Bid> bids;
+};
+struct alignas(64) BidPartTotals {
+    BidTotals totals;
+};
+
+unsigned BidStore::ResolveThreads(unsigned threads) {
+    return threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+}
+
+size_t BidStore::ForEachParallel(unsigned,
+                                 const std::function<void(size_t part, const Bid&)>& visit) const {
+    ForEach([&](const Bid& b) { visit(0, b); });
+    return 1;
+}
+
+std::vector<Bid> BidStore::FilterParallel(const std::function<bool(const Bid&)>& match,
+                                          unsigned threads) const {
+    threads = ResolveThreads(threads);
+    std::vector<BidPartMatches> found(threads);
+    size_t parts = ForEachParallel(threads, [&](size_t part, const Bid& b) {
+        if (match(b)) found[part].bids.push_back(b);
+    });
+
+    std::vector<Bid> matches;
+    for (size_t p = 0; p < parts; p++) {
+        matches.insert(matches.end(), std::make_move_iterator(found[p].bids.begin()),
+                       std::make_move_iterator(found[p].bids.end()));
+    }
+    return matches;
+}
+
+BidTotals BidStore::TotalsParallel(const std::function<bool(const Bid&)>& match, unsigned threads) const {
+    threads = ResolveThreads(threads);
+    std::vector<BidPartTotals> partial(threads);
+    size_t parts = ForEachParallel(threads, [&](size_t part, const Bid& b) {
+        if (match && !match(b)) return;
+        BidTotals& t = partial[part].totals;
+        t.low = (t.count == 0) ? b.amount : std::min(t.low, b.amount);
+        t.high = (t.count == 0) ? b.amount : std::max(t.high, b.amount);
+        t.total += b.amount;
+        t.count++;
+    });
+
+    BidTotals sum;
+    for (size_t p = 0; p < parts; p++) {
+        const BidTotals& t = partial[p].totals;
+        if (t.count == 0) continue;
+        sum.low = (sum.count == 0) ? t.low : std::min(sum.low, t.low);
+        sum.high = (sum.count == 0) ? t.high : std::max(sum.high, t.high);
+        sum.total += t.total;
+        sum.count += t.count;
+    }
+    return sum;
+}
@@ -0,0 +1,83 @@
+//============================================================================
+// Name        : BidStore.hpp
+//
+// The operations the menu, loader and log replay need from a bid container.
+//
+// Why an interface? There is more than one way to keep bids: the linked
+// list keeps insertion order, while the skip list keeps them sorted by ID
+// for O(log n) search and ordered listing. --store picks one at startup,
+// and nothing else in the program has to know which.
+//
+// Fund and range queries have plain scan implementations here; a backend
+// with a faster way (the list's per-fund chains, the skip list's order,
+// a frozen list's sorted arrays) overrides them.
+//
+// Parallel scans: ForEachParallel splits the bids into runs that threads
+// can walk at the same time. A backend that can't split itself runs one
+// part on the calling thread. FilterParallel and TotalsParallel are built
+// on it and work with any backend.
+//============================================================================
+
+#ifndef BID_STORE_HPP
+#define BID_STORE_HPP
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Bid.hpp"
+
+// Count and amount statistics over a set of bids (low/high are 0 when empty)
+struct BidTotals {
+    size_t count = 0;
+    double total = 0.0;
+    double low   = 0.0;
+    double high  = 0.0;
+};
+
+class BidStore {
+public:
+    virtual ~BidStore() = default;
+
+    virtual void Append(const Bid& bid) = 0;
+    virtual void Prepend(const Bid& bid) = 0;
+    virtual bool Remove(const std::string& bidId) = 0;       // false if not found
+    virtual Bid Search(const std::string& bidId) const = 0;  // empty Bid if not found
+    virtual int Size() const = 0;
+
+    // Search for each ID; result[i] is empty where ids[i] is not found.
+    // A backend may overlap the lookups (see FrozenBids::FindBatch).
+    virtual std::vector<Bid> SearchBatch(const std::vector<std::string>& bidIds) const;
+
+    // Every bid, in the store's own order
+    virtual void ForEach(const std::function<void(const Bid&)>& visit) const = 0;
+
+    virtual std::vector<Bid> Snapshot() const;
+    virtual void ForEachInFund(const std::string& fund, const std::function<void(const Bid&)>& visit) const;
+    virtual int FundSize(const std::string& fund) const;
+
+    // Bids with first <= ID <= last, in ID order (see bidIdLess)
+    virtual void ForEachInRange(const std::string& first, const std::string& last,
+                                const std::function<void(const Bid&)>& visit) const;
+    // Bids with low <= amount <= high, lowest amount first
+    virtual void ForEachInAmountRange(double low, double high,
+                                      const std::function<void(const Bid&)>& visit) const;
+
+    // Visit every bid, split into at most 'threads' runs that follow each
+    // other in store order (0 = one per hardware thread). Runs go on
+    // separate threads; 'part' numbers them from 0, and each run's bids
+    // are visited in order. The store must not change meanwhile.
+    // @return how many parts were used
+    virtual size_t ForEachParallel(unsigned threads,
+                                   const std::function<void(size_t part, const Bid&)>& visit) const;
+
+    // Matching bids in store order
+    std::vector<Bid> FilterParallel(const std::function<bool(const Bid&)>& match, unsigned threads = 0) const;
+    // Totals over the matching bids (all bids if 'match' is empty)
+    BidTotals TotalsParallel(const std::function<bool(const Bid&)>& match = nullptr, unsigned threads = 0) const;
+
+    static unsigned ResolveThreads(unsigned threads);   // 0 -> hardware threads
+};
+
+#endif // BID_STORE_HPP
@@ -0,0 +1,218 @@
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+
+#include "BidVectorList.hpp"
+
+BidVectorList::BidVectorList(const MemoryPolicy& policy) : nodes(PlacedAllocator<Node>(policy)) {}
+
+MemoryStats BidVectorList::Memory() const {
+    return memoryStats(nodes.data(), nodes.capacity() * sizeof(Node));
+}
+
+/**
+ * A free slot if there is one, otherwise a new one at the end. kNil is
+ * the "no node" link, so the vector stops one short of it.
+ **/
+uint32_t BidVectorList::allocate(const Bid& bid) {
+    if (freeHead != kNil) {
+        const uint32_t index = freeHead;
+        freeHead = nodes[index].next;
+        nodes[index] = Node{kNil, kNil, bid};
+        return index;
+    }
+    if (nodes.size() >= kNil) {
+        throw std::length_error("BidVectorList : too many bids for 32-bit links");
+    }
+    nodes.push_back(Node{kNil, kNil, bid});
+    return static_cast<uint32_t>(nodes.size() - 1);
+}
+
+/**
+ * The last slot is simply dropped, so removing from the end of an
+ * appended list keeps it in order; any other slot joins the free list.
+ **/
+void BidVectorList::release(uint32_t index) {
+    if (index == nodes.size() - 1) {
+        nodes.pop_back();
+        return;
+    }
+    nodes[index].bid = Bid();   // let go of the strings now
+    nodes[index].prev = kNil;
+    nodes[index].next = freeHead;
+    freeHead = index;
+    inOrder = false;
+}
+
+void BidVectorList::Append(const Bid& bid) {
+    const bool reused = freeHead != kNil;
+    const uint32_t index = allocate(bid);
+    if (head == kNil) {
+        head = tail = index;
+    } else {
+        nodes[index].prev = tail;
+        nodes[tail].next = index;
+        tail = index;
+    }
+    if (reused) {
+        inOrder = false;
+    }
+    linkId(index, false);
+    count++;
+}
+
+void BidVectorList::Prepend(const Bid& bid) {
+    const uint32_t index = allocate(bid);
+    if (head == kNil) {
+        head = tail = index;
+    } else {
+        nodes[index].next = head;
+        nodes[head].prev = index;
+        head = index;
+        inOrder = false;
+    }
+    linkId(index, true);
+    count++;
+}
+
+bool BidVectorList::Remove(const std::string& bidId) {
+    auto it = ids.find(bidId);
+    if (it == ids.end()) {
+        return false;
+    }
+    const uint32_t index = it->second.first;
+    Node& node = nodes[index];
+    if (node.prev != kNil) {
+        nodes[node.prev].next = node.next;
+    } else {
+        head = node.next;
+    }
+    if (node.next != kNil) {
+        nodes[node.next].prev = node.prev;
+    } else {
+        tail = node.prev;
+    }
+    unlinkId(index);   // walks on from node.next, so before release()
+    release(index);
+    count--;
+    if (count == 0) {
+        // An emptied list has nothing out of order; start the vector over
+        nodes.clear();
+        freeHead = kNil;
+        inOrder = true;
+    }
+    return true;
+}
+
+Bid BidVectorList::Search(const std::string& bidId) const {
+    auto it = ids.find(bidId);
+    return it == ids.end() ? Bid{} : nodes[it->second.first].bid;
+}
+
+void BidVectorList::ForEach(const std::function<void(const Bid&)>& visit) const {
+    for (uint32_t index = head; index != kNil; index = nodes[index].next) {
+        visit(nodes[index].bid);
+    }
+}
+
+/**
+ * In order, part p gets nodes [p*n/parts, (p+1)*n/parts) - no walking to
+ * find where a part starts. Out of order, the scan stays on one thread;
+ * Compact() first to split it.
+ **/
+size_t BidVectorList::ForEachParallel(unsigned threads,
+                                      const std::function<void(size_t part, const Bid&)>& visit) const {
+    const size_t n = nodes.size();
+    const size_t parts = std::min<size_t>(ResolveThreads(threads), n);
+    if (!inOrder || parts <= 1) {
+        return BidStore::ForEachParallel(threads, visit);
+    }
+
+    std::vector<std::exception_ptr> errors(parts);
+    auto walk = [&](size_t part) {
+        try {
+            for (size_t i = part * n / parts; i < (part + 1) * n / parts; i++) {
+                visit(part, nodes[i].bid);
+            }
+        } catch (...) {
+            errors[part] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t p = 1; p < parts; p++) {
+        workers.emplace_back(walk, p);
+    }
+    walk(0);
+    for (std::thread& t : workers) {
+        t.join();
+    }
+    for (std::exception_ptr& e : errors) {
+        if (e) std::rethrow_exception(e);
+    }
+    return parts;
+}
+
+/**
+ * Moves the bids into a new vector in list order, links each to its
+ * neighbors by position, and renumbers the ID index.
+ **/
+void BidVectorList::Compact() {
+    std::vector<uint32_t> renumber(nodes.size(), kNil);
+    std::vector<Node, PlacedAllocator<Node>> ordered(nodes.get_allocator());
+    ordered.reserve(static_cast<size_t>(count));
+    for (uint32_t index = head; index != kNil; index = nodes[index].next) {
+        const uint32_t position = static_cast<uint32_t>(ordered.size());
+        renumber[index] = position;
+        ordered.push_back(Node{position + 1, position == 0 ? kNil : position - 1, std::move(nodes[index].bid)});
+    }
+    if (!ordered.empty()) {
+        ordered.back().next = kNil;
+    }
+    for (auto& entry : ids) {
+        entry.second.first = renumber[entry.second.first];
+    }
+
+    nodes = std::move(ordered);
+    head = nodes.empty() ? kNil : 0;
+    tail = nodes.empty() ? kNil : static_cast<uint32_t>(nodes.size() - 1);
+    freeHead = kNil;
+    inOrder = true;
+}
+
+/**
+ * A prepended duplicate becomes the first node for its ID; an appended
+ * one only bumps the count (as in LinkedList::LinkId).
+ **/
+void BidVectorList::linkId(uint32_t index, bool atFront) {
+    IdEntry& entry = ids[nodes[index].bid.bidId];
+    if (entry.first == kNil || atFront) {
+        entry.first = index;
+    }
+    entry.count++;
+}
+
+/**
+ * If the node was the first of several with its ID, the next one further
+ * down the list takes over.
+ **/
+void BidVectorList::unlinkId(uint32_t index) {
+    const Node& node = nodes[index];
+    auto it = ids.find(node.bid.bidId);
+    if (it == ids.end()) {
+        return;
+    }
+    IdEntry& entry = it->second;
+    if (--entry.count == 0) {
+        ids.erase(it);
+        return;
+    }
+    if (entry.first == index) {
+        uint32_t current = node.next;
+        while (current != kNil && nodes[current].bid.bidId != node.bid.bidId) {
+            current = nodes[current].next;
+        }
+        entry.first = current;
+    }
+}
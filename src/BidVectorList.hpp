@@ -0,0 +1,92 @@
+//============================================================================
+// Name        : BidVectorList.hpp
+//
+// Insertion-ordered bid list whose nodes live in one growable vector and
+// link to each other by 32-bit index instead of by pointer. Selected with
+// --store=vector.
+//
+// Why not a node per allocation? A 64-bit pointer spends 8 bytes per link
+// on an address that is mostly the same high bits, and every node lands
+// wherever the allocator put it. Here:
+//
+// - next/prev are 32-bit indexes into the vector: half the link bytes,
+//   and up to 4 billion bids per list.
+// - Removed slots go on a free list (threaded through their 'next') and
+//   are reused by the next Append/Prepend before the vector grows.
+// - Links hold no addresses, so the vector can move when it grows without
+//   fixing any of them up. Only the indexes are position-independent:
+//   each node keeps its links next to a Bid that owns heap strings, so
+//   the nodes can't be written out or copied byte for byte.
+// - Appending keeps list order equal to vector order, so a walk reads
+//   memory front to back and the prefetcher keeps up. Prepends and
+//   removals in the middle break that; Compact() renumbers the nodes in
+//   list order again, and while the two orders match, ForEachParallel
+//   hands each thread a plain slice of the vector.
+//
+// The node array is one large block, placed per the MemoryPolicy given
+// (huge pages, mlock, prefault).
+//============================================================================
+
+#ifndef BID_VECTOR_LIST_HPP
+#define BID_VECTOR_LIST_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "BidMemory.hpp"
+#include "BidStore.hpp"
+
+class BidVectorList : public BidStore {
+public:
+    explicit BidVectorList(const MemoryPolicy& policy = MemoryPolicy());
+
+    void Append(const Bid& bid) override;
+    void Prepend(const Bid& bid) override;
+    bool Remove(const std::string& bidId) override;        // first bid with that ID
+    Bid Search(const std::string& bidId) const override;   // first bid with that ID
+    int Size() const override { return count; }
+    void ForEach(const std::function<void(const Bid&)>& visit) const override;
+    size_t ForEachParallel(unsigned threads,
+                           const std::function<void(size_t part, const Bid&)>& visit) const override;
+
+    // Renumber the nodes in list order and drop the free slots
+    void Compact();
+
+    size_t Slots() const { return nodes.size(); }   // in use plus free
+    bool InOrder() const { return inOrder; }         // vector order is list order, no gaps
+    MemoryStats Memory() const;                      // what backs the node array
+
+    static constexpr uint32_t kNil = UINT32_MAX;
+
+private:
+    struct Node {
+        uint32_t next = kNil;
+        uint32_t prev = kNil;
+        Bid      bid;
+    };
+
+    // First node (in list order) with an ID, and how many share it
+    struct IdEntry {
+        uint32_t first = kNil;
+        int      count = 0;
+    };
+
+    uint32_t allocate(const Bid& bid);
+    void release(uint32_t index);
+    void linkId(uint32_t index, bool atFront);
+    void unlinkId(uint32_t index);
+
+    std::vector<Node, PlacedAllocator<Node>> nodes;
+    uint32_t                                 head     = kNil;
+    uint32_t                                 tail     = kNil;
+    uint32_t                                 freeHead = kNil;   // removed slots, linked by 'next'
+    int                                      count    = 0;
+    bool                                     inOrder  = true;
+    std::unordered_map<std::string, IdEntry> ids;
+};
+
+#endif // BID_VECTOR_LIST_HPP
@@ -1,6 +1,9 @@
 #include <fstream>
 #include <sstream>
 #include <iomanip>
+#include <memory>
+#include <string_view>
+#include "AsyncFileReader.hpp"
 #include "CSVparser.hpp"
 
 namespace csv {
@@ -12,25 +15,35 @@ namespace csv {
       if (type == eFILE)
       {
         _file = data;
-        std::ifstream ifile(_file.c_str());
-        if (ifile.is_open())
+        std::unique_ptr<AsyncFileReader> reader;
+        try
         {
-            while (ifile.good())
+            reader = std::make_unique<AsyncFileReader>(_file);
+        }
+        catch (const std::runtime_error &)
+        {
+            throw Error(std::string("Failed to open ").append(_file));
+        }
+
+        // Rows are tokenized as their chunk arrives, while the reads
+        // after it are still in flight
+        reader->ReadAll([&](std::string_view chunk)
+        {
+            size_t start = 0;
+            size_t end;
+            while ((end = chunk.find('\n', start)) != std::string_view::npos)
             {
-                getline(ifile, line);
-                if (line != "")
-                    _originalFile.push_back(line);
+                line.append(chunk.substr(start, end - start));
+                takeLine(line);
+                line.clear();
+                start = end + 1;
             }
-            ifile.close();
+            line.append(chunk.substr(start));
+        });
+        takeLine(line);
 
-            if (_originalFile.size() == 0)
-              throw Error(std::string("No Data in ").append(_file));
-            
-            parseHeader();
-            parseContent();
-        }
-        else
-            throw Error(std::string("Failed to open ").append(_file));
+        if (_originalFile.size() == 0)
+          throw Error(std::string("No Data in ").append(_file));
       }
       else
       {
@@ -71,32 +84,53 @@ namespace csv {
      it++; // skip header
 
      for (; it != _originalFile.end(); it++)
+         parseLine(*it);
+  }
+
+  // A file is not kept line by line: the first line becomes the header,
+  // the others rows
+  void Parser::takeLine(const std::string &line)
+  {
+      if (line == "")
+          return;
+      if (_originalFile.size() == 0)
+      {
+          _originalFile.push_back(line);
+          parseHeader();
+      }
+      else
+          parseLine(line);
+  }
+
+  void Parser::parseLine(const std::string &line)
+  {
+     bool quoted = false;
+     int tokenStart = 0;
+     unsigned int i = 0;
+
+     Row *row = new Row(_header);
+
+     for (; i != line.length(); i++)
+     {
+          if (line.at(i) == '"')
+              quoted = ((quoted) ? (false) : (true));
+          else if (line.at(i) == ',' && !quoted)
+          {
+              row->push(line.substr(tokenStart, i - tokenStart));
+              tokenStart = i + 1;
+          }
+     }
+
+     //end
+     row->push(line.substr(tokenStart, line.length() - tokenStart));
+
+     // if value(s) missing
+     if (row->size() != _header.size())
      {
-         bool quoted = false;
-         int tokenStart = 0;
-         unsigned int i = 0;
-
-         Row *row = new Row(_header);
-
-         for (; i != it->length(); i++)
-         {
-              if (it->at(i) == '"')
-                  quoted = ((quoted) ? (false) : (true));
-              else if (it->at(i) == ',' && !quoted)
-              {
-                  row->push(it->substr(tokenStart, i - tokenStart));
-                  tokenStart = i + 1;
-              }
-         }
-
-         //end
-         row->push(it->substr(tokenStart, it->length() - tokenStart));
-
-         // if value(s) missing
-         if (row->size() != _header.size())
-          throw Error("corrupted data !");
-         _content.push_back(row);
+      delete row;
+      throw Error("corrupted data !");
      }
+     _content.push_back(row);
   }
 
   Row &Parser::getRow(unsigned int rowPosition) const
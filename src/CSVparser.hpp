@@ -83,6 +83,8 @@ namespace csv
     protected:
     	void parseHeader(void);
     	void parseContent(void);
+    	void takeLine(const std::string &);
+    	void parseLine(const std::string &);
 
     private:
         std::string _file;
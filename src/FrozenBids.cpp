@@ -0,0 +1,328 @@
+#include <algorithm>
+#include <bit>
+#include <numeric>
+#include <unordered_set>
+
+#include "BidHash.hpp"
+#include "FrozenBids.hpp"
+
+static constexpr size_t   kIdsPerBucket = 2;
+static constexpr uint64_t kDisplaceStep = 0x9E3779B97F4A7C15ull;
+
+#if defined(__GNUC__)
+#define FROZEN_PREFETCH(p) __builtin_prefetch(p)
+#else
+#define FROZEN_PREFETCH(p) ((void)0)
+#endif
+
+// Map a 64-bit hash onto 0..n-1 with a multiply instead of a division
+static size_t reduceHash(uint64_t h, size_t n) {
+#if defined(__SIZEOF_INT128__)
+    return static_cast<size_t>((static_cast<unsigned __int128>(h) * n) >> 64);
+#else
+    return static_cast<size_t>(h % n);
+#endif
+}
+
+static size_t bucketOf(uint64_t h, size_t buckets) {
+    return reduceHash(h, buckets);
+}
+
+// Slot for hash 'h' under displacement 'd', in 0..n-1
+static size_t displacedSlot(uint64_t h, uint32_t d, size_t n) {
+    return reduceHash(mixHash64(h + d * kDisplaceStep), n);
+}
+
+/**
+ * Hash-and-displace: hash every ID into a bucket, then place the buckets
+ * largest first. For each bucket try displacements 0, 1, 2, ... until all
+ * of its IDs land on free slots. Big buckets go while the table is empty;
+ * the many single-ID buckets at the end only need one free slot each.
+ * Two IDs per bucket on average keeps the tries for late, part-full
+ * placements low, at 2 bytes of displacement per ID.
+ * @return false if some bucket found no displacement (try another seed)
+ */
+static bool placeBuckets(const std::vector<uint64_t>& hashes, size_t buckets,
+                         std::vector<uint32_t>& displacement, std::vector<uint32_t>& slotOwner) {
+    const size_t n = hashes.size();
+
+    // Bucket members as one flat array: bucket b is members[start[b], start[b+1])
+    std::vector<uint32_t> start(buckets + 1, 0);
+    for (uint32_t i = 0; i < n; i++) {
+        start[bucketOf(hashes[i], buckets) + 1]++;
+    }
+    size_t largest = 0;
+    for (size_t b = 0; b < buckets; b++) {
+        largest = std::max<size_t>(largest, start[b + 1]);
+        start[b + 1] += start[b];
+    }
+    std::vector<uint32_t> members(n);
+    {
+        std::vector<uint32_t> fill(start.begin(), start.end() - 1);
+        for (uint32_t i = 0; i < n; i++) {
+            members[fill[bucketOf(hashes[i], buckets)]++] = i;
+        }
+    }
+
+    // Largest first; empty buckets are left out
+    std::vector<std::vector<uint32_t>> bySize(largest + 1);
+    for (uint32_t b = 0; b < buckets; b++) {
+        bySize[start[b + 1] - start[b]].push_back(b);
+    }
+
+    const uint32_t maxTries = static_cast<uint32_t>(std::min<uint64_t>(UINT32_MAX, 64 * uint64_t(n) + 1024));
+    std::vector<bool> used(n, false);
+    std::vector<size_t> slots;
+    displacement.assign(buckets, 0);
+    slotOwner.assign(n, 0);
+
+    for (size_t size = largest; size > 0; size--) {
+        for (uint32_t b : bySize[size]) {
+            const uint32_t* ids = &members[start[b]];
+            uint32_t d = 0;
+            for (;; d++) {
+                if (d == maxTries) return false;
+                slots.clear();
+                bool fits = true;
+                for (size_t k = 0; k < size; k++) {
+                    size_t s = displacedSlot(hashes[ids[k]], d, n);
+                    if (used[s] || std::find(slots.begin(), slots.end(), s) != slots.end()) {
+                        fits = false;
+                        break;
+                    }
+                    slots.push_back(s);
+                }
+                if (fits) break;
+            }
+            displacement[b] = d;
+            for (size_t k = 0; k < size; k++) {
+                used[slots[k]] = true;
+                slotOwner[slots[k]] = ids[k];
+            }
+        }
+    }
+    return true;
+}
+
+// Lay sorted[0..n) out in Eytzinger order: tree[k]'s children are 2k, 2k+1
+template <typename T>
+static size_t fillEytzinger(std::vector<T>& tree, const std::vector<T>& sorted, size_t i, size_t k) {
+    if (k < tree.size()) {
+        i = fillEytzinger(tree, sorted, i, 2 * k);
+        tree[k] = sorted[i++];
+        i = fillEytzinger(tree, sorted, i, 2 * k + 1);
+    }
+    return i;
+}
+
+FrozenBids::FrozenBids(const std::vector<Bid>& input) {
+    // First occurrence of each ID is the one lookups must find
+    std::vector<uint32_t> firsts, repeats;
+    {
+        std::unordered_set<std::string> seen;
+        seen.reserve(input.size());
+        for (uint32_t i = 0; i < input.size(); i++) {
+            (seen.insert(input[i].bidId).second ? firsts : repeats).push_back(i);
+        }
+    }
+    distinct = firsts.size();
+
+    // pos[i]: where input[i] ends up in 'bids'
+    std::vector<uint32_t> pos(input.size());
+    bids.reserve(input.size());
+    if (distinct > 0) {
+        const size_t buckets = std::max<size_t>(1, distinct / kIdsPerBucket);
+        std::vector<uint64_t> hashes(distinct);
+        std::vector<uint32_t> slotOwner;
+        for (seed = 0;; seed++) {
+            for (size_t i = 0; i < distinct; i++) {
+                hashes[i] = hash64(input[firsts[i]].bidId, seed);
+            }
+            if (placeBuckets(hashes, buckets, displacement, slotOwner)) break;
+        }
+        for (uint32_t s = 0; s < distinct; s++) {
+            pos[firsts[slotOwner[s]]] = s;
+            bids.push_back(input[firsts[slotOwner[s]]]);
+        }
+    }
+    for (uint32_t i : repeats) {
+        pos[i] = static_cast<uint32_t>(bids.size());
+        bids.push_back(input[i]);
+    }
+
+    // Sort in list order first so equal keys keep it (stable_sort)
+    std::vector<uint32_t> listOrder(input.size());
+    std::iota(listOrder.begin(), listOrder.end(), 0);
+
+    std::vector<uint32_t> sorted = listOrder;
+    std::stable_sort(sorted.begin(), sorted.end(), [&](uint32_t a, uint32_t b) {
+        return bidIdLess(input[a].bidId, input[b].bidId);
+    });
+    byId.resize(sorted.size());
+    std::vector<IdEntry> idKeys(sorted.size());
+    for (uint32_t r = 0; r < sorted.size(); r++) {
+        byId[r] = pos[sorted[r]];
+        uint64_t value = 0;
+        bool numeric = bidIdNumber(input[sorted[r]].bidId, value);
+        idKeys[r] = {value, r, numeric ? 1u : 0u};
+    }
+
+    sorted = listOrder;
+    std::stable_sort(sorted.begin(), sorted.end(), [&](uint32_t a, uint32_t b) {
+        return input[a].amount < input[b].amount;
+    });
+    byAmount.resize(sorted.size());
+    std::vector<AmountEntry> amountKeys(sorted.size());
+    for (uint32_t r = 0; r < sorted.size(); r++) {
+        byAmount[r] = pos[sorted[r]];
+        amountKeys[r] = {input[sorted[r]].amount, r};
+    }
+
+    idTree.resize(input.size() + 1);
+    amountTree.resize(input.size() + 1);
+    fillEytzinger(idTree, idKeys, 0, 1);
+    fillEytzinger(amountTree, amountKeys, 0, 1);
+}
+
+size_t FrozenBids::slotOf(uint64_t hash) const {
+    return displacedSlot(hash, displacement[bucketOf(hash, displacement.size())], distinct);
+}
+
+const Bid* FrozenBids::Find(const std::string& bidId) const {
+    if (distinct == 0) {
+        return nullptr;
+    }
+    // The hash always names some slot; an ID that was never frozen fails here
+    const Bid& candidate = bids[slotOf(hash64(bidId, seed))];
+    return candidate.bidId == bidId ? &candidate : nullptr;
+}
+
+// One lookup in flight in FindBatch; 'stage' is the load it is waiting for
+struct FrozenProbe {
+    enum Stage { DISPLACEMENT, BID, ID_BYTES } stage;
+    size_t   index;   // into ids / out
+    uint64_t hash;
+    size_t   slot;
+};
+
+/**
+ * AMAC: a ring of probes, each advanced one stage per visit. Every stage
+ * ends by prefetching what the next one reads, so the probe steps aside
+ * instead of stalling; the other probes' work hides the miss. A finished
+ * probe's place is refilled with the next ID straight away, so the ring
+ * stays full even though misses (wrong length) finish a stage early.
+ */
+void FrozenBids::FindBatch(const std::vector<std::string>& ids, std::vector<const Bid*>& out,
+                           size_t width) const {
+    out.assign(ids.size(), nullptr);
+    if (distinct == 0 || ids.empty()) {
+        return;
+    }
+    width = std::clamp<size_t>(width, 1, kMaxBatchWidth);
+
+    FrozenProbe ring[kMaxBatchWidth];
+    size_t next = 0;      // next ID to start
+    size_t active = 0;
+    auto start = [&](FrozenProbe& p) {
+        p.index = next++;
+        p.hash = hash64(ids[p.index], seed);
+        p.stage = FrozenProbe::DISPLACEMENT;
+        FROZEN_PREFETCH(&displacement[bucketOf(p.hash, displacement.size())]);
+    };
+    for (; active < width && next < ids.size(); active++) {
+        start(ring[active]);
+    }
+
+    while (active > 0) {
+        for (size_t r = 0; r < active;) {
+            FrozenProbe& p = ring[r];
+            bool done = false;
+            switch (p.stage) {
+                case FrozenProbe::DISPLACEMENT:
+                    p.slot = slotOf(p.hash);
+                    p.stage = FrozenProbe::BID;
+                    FROZEN_PREFETCH(&bids[p.slot]);
+                    break;
+                case FrozenProbe::BID: {
+                    const std::string& id = bids[p.slot].bidId;
+                    if (id.size() != ids[p.index].size()) {
+                        done = true;
+                    } else {
+                        p.stage = FrozenProbe::ID_BYTES;
+                        FROZEN_PREFETCH(id.data());   // same line already, unless the ID is long
+                    }
+                    break;
+                }
+                case FrozenProbe::ID_BYTES:
+                    if (bids[p.slot].bidId == ids[p.index]) {
+                        out[p.index] = &bids[p.slot];
+                    }
+                    done = true;
+                    break;
+            }
+            if (!done) {
+                r++;
+            } else if (next < ids.size()) {
+                start(p);
+                r++;
+            } else {
+                p = ring[--active];   // shrink the ring; revisit the moved probe
+            }
+        }
+    }
+}
+
+bool FrozenBids::idLess(const IdEntry& entry, bool numeric, uint64_t value, const std::string& id) const {
+    if (entry.numeric && numeric) {
+        return entry.value < value;
+    }
+    return bidIdLess(bids[byId[entry.rank]].bidId, id);
+}
+
+/**
+ * Eytzinger lower bound: walk down from the root, going right whenever the
+ * node is below the key. The path taken is the key's position in binary;
+ * stripping the trailing right turns (and one left turn) gives the answer.
+ * Four 16-byte nodes share a cache line, so the grandchildren of k start
+ * at 4k: prefetching that line overlaps the next two levels' memory wait.
+ */
+void FrozenBids::ForEachInRange(const std::string& first, const std::string& last,
+                                const std::function<void(const Bid&)>& visit) const {
+    uint64_t firstValue = 0;
+    const bool firstNumeric = bidIdNumber(first, firstValue);
+    const size_t n = idTree.size();
+
+    size_t k = 1;
+    while (k < n) {
+        FROZEN_PREFETCH(idTree.data() + std::min(4 * k, n - 1));
+        k = 2 * k + idLess(idTree[k], firstNumeric, firstValue, first);
+    }
+    k >>= std::countr_one(k) + 1;
+    if (k == 0) {
+        return;
+    }
+    for (size_t r = idTree[k].rank; r < byId.size(); r++) {
+        const Bid& b = bids[byId[r]];
+        if (bidIdLess(last, b.bidId)) break;
+        visit(b);
+    }
+}
+
+void FrozenBids::ForEachInAmountRange(double low, double high,
+                                      const std::function<void(const Bid&)>& visit) const {
+    const size_t n = amountTree.size();
+    size_t k = 1;
+    while (k < n) {
+        FROZEN_PREFETCH(amountTree.data() + std::min(4 * k, n - 1));
+        k = 2 * k + (amountTree[k].amount < low);
+    }
+    k >>= std::countr_one(k) + 1;
+    if (k == 0) {
+        return;
+    }
+    for (size_t r = amountTree[k].rank; r < byAmount.size(); r++) {
+        const Bid& b = bids[byAmount[r]];
+        if (b.amount > high) break;
+        visit(b);
+    }
+}
@@ -0,0 +1,88 @@
+//============================================================================
+// Name        : FrozenBids.hpp
+//
+// Immutable, read-optimized copy of a bid list, built by LinkedList::Freeze.
+//
+// Why? After a bulk load almost every operation is a read, but each list
+// lookup still chases pointers: hash bucket -> map node -> list node ->
+// strings. Here everything sits in a few flat arrays:
+//
+// - ID lookup: a minimal perfect hash (hash-and-displace). Every distinct
+//   ID maps to its own slot in 0..n-1 with no collisions, using one small
+//   displacement per bucket of ~2 IDs. The bids are stored in slot order,
+//   so a lookup reads one displacement (the table is small enough to stay
+//   cached) and then one bid: one or two cache misses.
+// - Ordered queries (ID range, amount range): sorted keys laid out in
+//   Eytzinger (BFS) order. A binary search then walks down a tree whose
+//   next levels sit in the same or the next cache line, and the line after
+//   that can be prefetched while the current one is compared.
+//
+// Batched lookups: FindBatch resolves many IDs at once. One lookup is a
+// chain of dependent loads (displacement, then bid, then the ID's bytes),
+// so on its own it waits on memory at every step. FindBatch keeps several
+// lookups in flight, each a small state machine: a step issues a prefetch
+// for the lookup's next load and moves on to another lookup, which by the
+// time it comes back around is usually in cache (AMAC, "asynchronous
+// memory access chaining").
+//
+// A frozen copy never changes. The list drops it on the first edit and
+// answers from its own nodes until it is frozen again.
+//============================================================================
+
+#ifndef FROZEN_BIDS_HPP
+#define FROZEN_BIDS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Bid.hpp"
+
+class FrozenBids {
+public:
+    // 'bids' in list order; repeated IDs resolve to the first one, like Search
+    explicit FrozenBids(const std::vector<Bid>& bids);
+
+    const Bid* Find(const std::string& bidId) const;   // nullptr if absent
+    // out[i] = Find(ids[i]), with up to 'width' lookups interleaved
+    void FindBatch(const std::vector<std::string>& ids, std::vector<const Bid*>& out,
+                   size_t width = kBatchWidth) const;
+    size_t Size() const { return bids.size(); }
+
+    void ForEachInRange(const std::string& first, const std::string& last,
+                        const std::function<void(const Bid&)>& visit) const;
+    void ForEachInAmountRange(double low, double high,
+                              const std::function<void(const Bid&)>& visit) const;
+
+    static constexpr size_t kBatchWidth = 16;   // about what a core's miss buffers can track
+    static constexpr size_t kMaxBatchWidth = 64;
+
+private:
+    struct IdEntry {
+        uint64_t value;     // numeric ID (see bidIdNumber) when 'numeric'
+        uint32_t rank;      // position in byId
+        uint32_t numeric;
+    };
+    struct AmountEntry {
+        double   amount;
+        uint32_t rank;      // position in byAmount
+    };
+
+    size_t slotOf(uint64_t hash) const;
+    bool idLess(const IdEntry& entry, bool numeric, uint64_t value, const std::string& id) const;
+
+    // Distinct IDs first, in perfect-hash slot order; repeats after them
+    std::vector<Bid>         bids;
+    size_t                   distinct = 0;
+    std::vector<uint32_t>    displacement;   // one per bucket
+    uint64_t                 seed = 0;
+
+    std::vector<uint32_t>    byId;           // indexes into bids, sorted by ID
+    std::vector<uint32_t>    byAmount;       // indexes into bids, sorted by amount
+    std::vector<IdEntry>     idTree;         // Eytzinger order, 1-based
+    std::vector<AmountEntry> amountTree;     // Eytzinger order, 1-based
+};
+
+#endif // FROZEN_BIDS_HPP
@@ -3,11 +3,12 @@
 // Author      : Justin Guida
 // Version     : 1.1.0
 //
-// Bid management system using a singly linked list.
+// Bid management system using a doubly linked list.
 //
 // Why a linked list instead of vector?
 // - Educational: demonstrates manual memory management and pointer operations
 // - O(1) append/prepend without reallocations
+// - O(1) removal of a node already in hand, through its prev link
 // - Trade-off: O(n) search, but acceptable for ~12k records
 //
 // Why custom CSV parser?
@@ -26,6 +27,13 @@
 #include <sstream>
 #include <limits>
 #include <cstdlib>
+#include <memory>
+#include <functional>
+#include <cmath>
+#include <random>
+#include <unordered_map>
+#include <thread>
+#include <exception>
 
 // Unix-only: for detecting terminal width so output adjusts to fit
 #ifdef __unix__
@@ -34,7 +42,27 @@
 #endif
 
 using namespace std::chrono;
+#include "Bid.hpp"
+#include "BidCheckpoint.hpp"
+#include "BidDiff.hpp"
+#include "BidJoin.hpp"
+#include "BidLinkedList.hpp"
+#include "BidLog.hpp"
+#include "BidMappedList.hpp"
+#include "BidMemory.hpp"
+#include "BidSampler.hpp"
+#include "BidShards.hpp"
+#include "BidShm.hpp"
+#include "BidSketches.hpp"
+#include "BidCompressed.hpp"
+#include "BidSkipList.hpp"
+#include "BidSpill.hpp"
+#include "BidSort.hpp"
+#include "BidStore.hpp"
+#include "BidVectorList.hpp"
 #include "CSVparser.hpp"
+#include "FrozenBids.hpp"
+#include "MappedCsv.hpp"
 using namespace std;
 
 //============================================================================
@@ -188,18 +216,6 @@ static void setColorTheme() {
 double strToDouble(string str, char ch);
 
 
-// Define a structure to hold bid information with unique identifier, title, fund, and amount
-struct Bid {
-    string bidId;
-    string title;
-    string fund;
-    double amount;
-
-    Bid() {
-        amount = 0.0;
-    }
-};
-
 // Helpers for printing, pausing, and cleaning input
 void displayBid(const Bid& bid);        // full-width row output
 void displayBidCompact(const Bid& bid); // compact one-line output
@@ -274,6 +290,9 @@ static void displayMenu() {
     drawBoxLine("[3] Show All", boxWidth, GREEN);
     drawBoxLine("[4] Find Bid", boxWidth, GREEN);
     drawBoxLine("[5] Remove Bid", boxWidth, GREEN);
+    drawBoxLine("[6] Show Fund", boxWidth, GREEN);
+    drawBoxLine("[7] Amount Range", boxWidth, GREEN);
+    drawBoxLine("[8] Export CSV", boxWidth, GREEN);
     drawBoxMiddle(boxWidth);
     drawBoxLine("[9] Exit", boxWidth, RED);
     drawBoxBottom(boxWidth);
@@ -326,184 +345,6 @@ static int getTerminalWidth() {
 
 
 
-
-//============================================================================
-// LinkedList Class
-//
-// Why a singly linked list with both head AND tail pointers?
-// - Head pointer: required for traversal from the start
-// - Tail pointer: makes Append O(1) instead of O(n)
-// - Without tail, we'd have to walk the whole list to add to the end
-//
-// Why track size separately?
-// - Avoids O(n) traversal just to count elements
-// - Used to show "12023 bids loaded" without re-counting
-//
-// Trade-offs:
-// - Extra 8 bytes per list for tail pointer
-// - Must keep tail in sync during Remove (edge case when removing last node)
-//============================================================================
-
-class LinkedList {
-private:
-    struct Node {
-        Bid bid;
-        Node *next;
-        Node() : next(nullptr) {}
-        Node(const Bid& aBid) : bid(aBid), next(nullptr) {}
-    };
-
-    Node *head;
-    Node *tail;
-    int   size;
-
-public:
-    LinkedList();
-    virtual ~LinkedList();
-    void Append(const Bid& bid);
-    void Prepend(const Bid& bid);
-    void PrintList() const;
-    void Remove(const string& bidId);
-    Bid Search(const string& bidId) const;
-    int Size() const;
-};
-
-LinkedList::LinkedList() : head(nullptr), tail(nullptr), size(0) {}
-
-/**
- * Destructor - must manually free all nodes we allocated with 'new'.
- * Save next pointer BEFORE deleting current node, or we lose it.
- */
-LinkedList::~LinkedList() {
-    Node* current = head;
-    while (current != nullptr) {
-        Node* nextNode = current->next;
-        delete current;
-        current = nextNode;
-    }
-}
-
-/**
- * Append - O(1) thanks to tail pointer.
- * This is why we maintain tail - CSV loading adds 12k bids sequentially.
- */
-void LinkedList::Append(const Bid& bid) {
-    Node *newNode = new Node(bid);
-    if (head == nullptr) {
-        head = tail = newNode;
-    } else {
-        tail->next = newNode;
-        tail = newNode;
-    }
-    size++;
-}
-
-/**
-  * Prepend:
-  * Prepend a new bid to the start of the list.
-  * Allocate a new node containing the bid.
-  * If the list is empty, set both head and tail to this node.
-  * Otherwise, link the new node so its next points to the current head,
-  * Update head to the new node
-  * Increment the size counter.
-**/
-void LinkedList::Prepend(const Bid& bid) {
-    Node *newNode = new Node(bid);
-    if (head == nullptr) {
-        head = tail = newNode;
-    } else {
-        newNode->next = head;
-        head = newNode;
-    }
-    size++;
-}
-
-/**
- * Simple output of all bids in the list
- * PrintList walks through the linked list from head to tail.
- * For each node, it calls displayBid to show the bid data,
- * then moves on to the next node until the list ends.
-**/
-void LinkedList::PrintList() const {
-    Node *current = head;
-    while (current != nullptr) {
-        displayBid(current->bid);
-        current = current->next;
-    }
-}
-
-/**
- * Remove a specified bid
- * @param bidId The bid id to remove from the list
- * If list is empty, do nothing.
- * If head matches, hold onto head, move head to next, delete old head,
- * Then shrink size, and if head is now null then tail is null too.
- * Otherwise, walk list until a match, relink previous node to skip the match,
- * delete the match node, and shrink size.
-**/
-void LinkedList::Remove(const string& bidId) {
-    if (head == nullptr) {
-        return;
-    }
-    if (head->bid.bidId == bidId) {
-        Node *temp = head;
-        head = head->next;
-        delete temp; // free node memory
-        size--;
-
-        if (head == nullptr) {
-            tail = nullptr;
-        }
-        return;
-    }
-
-    Node *current = head;
-    while (current ->next != nullptr) {
-        if (current->next->bid.bidId == bidId) {
-            Node* temp = current->next;
-            current->next = temp->next; //bypass the node being removed
-
-            if (temp == tail) {
-                tail = current;
-            }
-            delete temp; // free node memory
-            size--;
-            return;
-        }
-        current = current->next;
-    }
-}
-
-/**
- * Search for the specified bidId
- * @param bidId The bid id to search for
- * if head is not null and matches bidId, return head bid
- * otherwise start at node after head and walk list
- * if a node’s bidId matches, return that bid
- * if end of list reached with no match, return empty Bid
-**/
-Bid LinkedList::Search(const string& bidId) const {
-    if (head != nullptr && head->bid.bidId == bidId) {
-        return head->bid;
-    }
-    Node* current = head ? head->next : nullptr;
-    while (current != nullptr) {
-        if (current->bid.bidId == bidId) {
-            return current->bid;
-        }
-        current = current->next;
-    }
-    return Bid{}; // returns empty bid if no match found
-
-}
-
-/**
- * Returns the current size (number of elements) in the list
- **/
-int LinkedList::Size() const {
-    return size;
-}
-
 //============================================================================
 // Static methods used for testing
 //============================================================================
@@ -567,7 +408,7 @@ void displayBid(const Bid& bid) {
         // Line 1: ID | Title
         const int reserved1 = len_id_lbl + idWidth + sep + len_title_lbl + margin;
         int titleWidth1 = max(5, term - reserved1);
-        string title1 = bid.title;
+        string title1 = bid.Title();
         if ((int)title1.size() > titleWidth1) {
             title1 = (titleWidth1 >= 3) ? title1.substr(0, titleWidth1 - 3) + "..."
                                         : title1.substr(0, titleWidth1);
@@ -589,7 +430,7 @@ void displayBid(const Bid& bid) {
     }
 
     // Prepare possibly truncated title so the line doesn't wrap
-    string title = bid.title;
+    string title = bid.Title();
     if ((int)title.size() > titleWidth) {
         if (titleWidth >= 3) {
             title = title.substr(0, titleWidth - 3) + "...";
@@ -609,7 +450,7 @@ void displayBid(const Bid& bid) {
 
 void displayBidCompact(const Bid& bid) {
     const int titlePreview = 40;          // short preview so the line stays compact
-    string t = bid.title;
+    string t = bid.Title();
     if ((int)t.size() > titlePreview) {
         t = t.substr(0, titlePreview - 3) + "...";
     }
@@ -654,17 +495,89 @@ Bid getBid() {
     return bid;
 }
 
+// How loadBids reads a file. The defaults load every row and nothing else.
+struct LoadOptions {
+    LoadSketches *sketches   = nullptr; // fed every row so stats are ready with no second pass
+    size_t        sampleSize = 0;       // > 0: keep only a uniform random sample of this many rows
+    uint64_t      sampleSeed = 0;       // same seed + same file = same sample (used by log replay)
+    bool          lazyTitles = false;   // titles stay in the mapped CSV until displayed
+};
+
+// Mapped CSVs backing lazy titles. Kept for the whole run because any bid
+// (including copies returned by Search) may still point into one of them.
+static vector<unique_ptr<MappedFile>> titleSources;
+
+/**
+ * Lazy-title load: map the file and scan it in place.
+ * Each bid copies its ID, fund and amount as usual but only records where
+ * its title sits in the mapping - usually the longest field by far.
+ **/
+static void loadBidsMapped(const string& csvPath, BidStore *list, LoadSketches *sketches) {
+    titleSources.push_back(make_unique<MappedFile>(csvPath));
+    const MappedFile &source = *titleSources.back();
+    requireCsvColumns(source, ',', 9);   // the row reads below go up to Fund, column 8
+
+    scanCsvRows(source, ',', [&](const vector<FieldSpan>& f) {
+        Bid bid;
+        bid.bidId = string(source.view(f[1].offset, f[1].length));
+        bid.fund = string(source.view(f[8].offset, f[8].length));
+        bid.amount = strToDouble(string(source.view(f[4].offset, f[4].length)), '$');
+        bid.titleSource = &source;
+        bid.titleOffset = f[0].offset;
+        bid.titleLength = f[0].length;
+
+        if (sketches != nullptr) {
+            sketches->Add(bid.fund, string(source.view(f[2].offset, f[2].length)), bid.amount,
+                          string(source.view(f[0].offset, f[0].length)));
+        }
+        list->Append(bid);
+    });
+}
+
+/**
+ * Pick a random sample of rows and return them as CSV text (header first).
+ * Rows that aren't picked are skipped over without being tokenized, so a
+ * preview of a multi-GB export costs little more than reading it.
+ **/
+static string sampleCsv(const string& csvPath, size_t sampleSize, uint64_t seed) {
+    ifstream in(csvPath, ios::binary);
+    if (!in.is_open()) {
+        throw csv::Error(string("Failed to open ").append(csvPath));
+    }
+    SampledLines sample = reservoirSampleLines(in, sampleSize, seed);
+
+    string data = sample.header + '\n';
+    for (const auto& line : sample.lines) {
+        data += line;
+        data += '\n';
+    }
+    return data;
+}
+
 /**
- * Load a CSV file containing bids into a LinkedList
+ * Load a CSV file containing bids into a bid store
  *
- * @return a LinkedList containing all the bids read
+ * @param options sampling and load statistics, see LoadOptions
+ * @return true if the file was read, false if it couldn't be parsed
  **/
-void loadBids(string csvPath, LinkedList *list) {
+bool loadBids(string csvPath, BidStore *list, const LoadOptions& options = LoadOptions()) {
     cout << "Loading CSV file " << csvPath << endl;
+    LoadSketches *sketches = options.sketches;
 
     try {
+        if (options.lazyTitles && options.sampleSize == 0) {
+            loadBidsMapped(csvPath, list, sketches);
+            return true;
+        }
+
         // Initialize the CSV Parser inside the try so constructor errors are caught
-        csv::Parser file(csvPath);
+        unique_ptr<csv::Parser> parser;
+        if (options.sampleSize > 0) {
+            parser = make_unique<csv::Parser>(sampleCsv(csvPath, options.sampleSize, options.sampleSeed), csv::ePURE);
+        } else {
+            parser = make_unique<csv::Parser>(csvPath);
+        }
+        csv::Parser &file = *parser;
 
         // loop to read rows of a CSV file
         for (int i = 0; i < file.rowCount(); i++) {
@@ -675,12 +588,18 @@ void loadBids(string csvPath, LinkedList *list) {
             bid.fund = file[i][8];
             bid.amount = strToDouble(file[i][4], '$');
 
+            if (sketches != nullptr) {
+                sketches->Add(bid.fund, file[i][2], bid.amount, bid.title);
+            }
+
             // add this bid to the end
             list->Append(bid);
         }
-    } catch (const csv::Error &e) {
+    } catch (const std::runtime_error &e) { // csv::Error, or the file couldn't be mapped
         std::cerr << "Error loading CSV '" << csvPath << "': " << e.what() << std::endl;
+        return false;
     }
+    return true;
 }
 
 /**
@@ -696,11 +615,531 @@ double strToDouble(string str, char ch) {
     return atof(str.c_str());
 }
 
+/**
+ * Approximate stats from the sketches filled during a load.
+ * '~' marks estimates: distinct counts are within a couple of percent,
+ * title counts can only be over, never under.
+ **/
+static void appendLoadSummary(const LoadSketches& sketches, vector<string>& lines) {
+    auto money = [](double v) {
+        stringstream ss;
+        ss << fixed << setprecision(2) << v;
+        return "$" + ss.str();
+    };
+
+    lines.push_back(YELLOW + "Funds:       " + RESET + "~" + to_string(llround(sketches.funds.Estimate())) + " distinct");
+    lines.push_back(YELLOW + "Departments: " + RESET + "~" + to_string(llround(sketches.departments.Estimate())) + " distinct");
+    lines.push_back(MAGENTA + "Amount p50:  " + RESET + money(sketches.amounts.Quantile(0.50)));
+    lines.push_back(MAGENTA + "Amount p95:  " + RESET + money(sketches.amounts.Quantile(0.95)));
+    lines.push_back(MAGENTA + "Amount p99:  " + RESET + money(sketches.amounts.Quantile(0.99)));
+
+    const size_t titlePreview = 40;
+    auto top = sketches.titles.TopK();
+    for (size_t i = 0; i < top.size() && i < 3; i++) {
+        string t = top[i].first;
+        if (t.size() > titlePreview) {
+            t = t.substr(0, titlePreview - 3) + "...";
+        }
+        lines.push_back(GREEN + (i == 0 ? "Top titles:  " : "             ") + RESET
+                        + t + DIM + " (~" + to_string(top[i].second) + ")" + RESET);
+    }
+}
+
+//============================================================================
+// Persistence (operation log + checkpoints)
+//
+// Why both? The log makes each edit durable cheaply, but replaying years of
+// edits (each LOAD re-parses a CSV) gets slow. Every 'checkpointEvery'
+// edits we snapshot the whole list and drop the log records it covers.
+//============================================================================
+
+struct Persistence {
+    unique_ptr<BidLog>       log;
+    unique_ptr<Checkpointer> checkpointer;
+    size_t checkpointEvery      = 1000; // edits (bids added/removed) between snapshots
+    size_t editsSinceCheckpoint = 0;
+};
+
+/**
+ * --sort: put the list in amount or ID order once a load is done.
+ * Only the list is reordered; the skip list keeps its own ID order.
+ * @return a status line for the result box, empty if nothing was sorted
+ **/
+static string sortForReports(BidStore& store, const string& by) {
+    LinkedList *list = dynamic_cast<LinkedList*>(&store);
+    if (by.empty() || list == nullptr || list->Size() < 2) {
+        return "";
+    }
+    auto start = high_resolution_clock::now();
+    list->Sort(by == "amount" ? BidSortKey::AMOUNT : BidSortKey::ID);
+    auto us = duration_cast<microseconds>(high_resolution_clock::now() - start).count();
+
+    stringstream ms;
+    ms << fixed << setprecision(2) << (us / 1000.0);
+    return DIM + "Sorted by " + by + " in " + ms.str() + " ms" + RESET;
+}
+
+/**
+ * Rebuild the list from the latest checkpoint plus the log records after it,
+ * in the order the edits happened. A LOAD record re-reads the CSV it names,
+ * so the log stays small even though one load adds thousands of bids; if
+ * the CSV no longer matches the size and CRC logged with it, recovery stops
+ * rather than rebuild a list the user never had.
+ * With --sort each replayed load is sorted again, as it was when it ran:
+ * a later remove of a repeated ID then takes the same bid it took then.
+ * New records are numbered after the checkpoint even if it emptied the log,
+ * so the next recovery doesn't take them as covered by it.
+ *
+ * @return number of log records replayed
+ **/
+static size_t recoverList(BidLog& log, const string& checkpointPath, BidStore& list,
+                          bool lazyTitles, const string& sortBy) {
+    uint64_t checkpointLsn = 0;
+    BidCheckpoint::Read(checkpointPath, checkpointLsn, [&](const Bid& b) { list.Append(b); });
+    log.ContinueAfter(checkpointLsn);
+
+    return log.Replay([&](const LogRecord& r) {
+        switch (r.op) {
+            case LogRecord::LOAD: {
+                uint64_t size;
+                uint32_t crc;
+                if (r.hasFingerprint &&
+                    (!BidLog::Fingerprint(r.key, size, crc) || size != r.fileSize || crc != r.fileCrc)) {
+                    throw BidLogError(r.key + " is missing or has changed since it was loaded "
+                                      "(log record " + to_string(r.lsn) + "); restore it to replay the log");
+                }
+                LoadOptions load;
+                load.sampleSize = r.sampleSize;
+                load.sampleSeed = r.sampleSeed;
+                load.lazyTitles = lazyTitles;
+                if (loadBids(r.key, &list, load)) sortForReports(list, sortBy);
+                break;
+            }
+            case LogRecord::APPEND: list.Append(r.bid);     break;
+            case LogRecord::REMOVE: list.Remove(r.key);     break;
+        }
+    }, checkpointLsn);
+}
+
+/**
+ * Write one edit to the log (if logging is on) and wait until it is on disk,
+ * then start a background checkpoint if enough edits have piled up.
+ * A failing disk is reported rather than fatal - the in-memory edit has
+ * already happened and the user should know it won't survive a restart.
+ *
+ * @param edits how many bids the change touched (a load counts every row)
+ **/
+static void commitToLog(Persistence& p, const BidStore& list, size_t edits,
+                        const function<uint64_t(BidLog&)>& write) {
+    if (!p.log) {
+        return;
+    }
+    try {
+        p.log->WaitDurable(write(*p.log));
+    } catch (const BidLogError& e) {
+        displayResult("LOG ERROR", {
+            RED + string(e.what()) + RESET,
+            DIM + "This change will be lost on exit." + RESET
+        }, BOLD + RED);
+        return;
+    }
+
+    p.editsSinceCheckpoint += edits;
+    if (p.checkpointEvery > 0 && p.editsSinceCheckpoint >= p.checkpointEvery) {
+        p.checkpointer->Submit(p.log->LastLsn(), list.Snapshot());
+        p.editsSinceCheckpoint = 0;
+    }
+}
+
+// Quote a CSV field if it needs it, doubling any quotes inside
+static string csvField(const string& text) {
+    if (text.find_first_of(",\"\r\n") == string::npos &&
+        (text.empty() || (text.front() != ' ' && text.back() != ' '))) {
+        return text;
+    }
+    string quoted = "\"";
+    for (char c : text) {
+        quoted += c;
+        if (c == '"') quoted += '"';
+    }
+    return quoted + "\"";
+}
+
+// Each part's CSV text, a cache line apart so the threads don't collide
+struct alignas(64) ExportPart {
+    string text;
+    size_t rows = 0;
+};
+
+/**
+ * Write every bid to a CSV that [2] Load Bids and --diff read back: the
+ * eBid column layout up to Fund, with the columns we don't keep left
+ * empty. Rows are formatted in parallel, one buffer per part, and the
+ * buffers written in order, so the file matches the store's order.
+ * @return the number of bids written
+ **/
+static size_t exportCsv(const BidStore& store, const string& path) {
+    vector<ExportPart> parts(BidStore::ResolveThreads(0));
+    size_t used = store.ForEachParallel(static_cast<unsigned>(parts.size()), [&](size_t part, const Bid& b) {
+        char amount[32];
+        snprintf(amount, sizeof(amount), "$%.2f", b.amount);
+        string &out = parts[part].text;
+        // The CSV parser keeps quoted titles exactly as they were in the
+        // file, quotes included; those are valid fields already
+        const string title = b.Title();
+        bool quoted = title.size() >= 2 && title.front() == '"' && title.back() == '"';
+        out += quoted ? title : csvField(title);
+        out += ',';
+        out += csvField(b.bidId);
+        out += ",,,";
+        out += amount;
+        out += ",,,,";
+        out += csvField(b.fund);
+        out += '\n';
+        parts[part].rows++;
+    });
+
+    ofstream file(path, ios::binary | ios::trunc);
+    if (!file) {
+        throw runtime_error("can't open " + path + " for writing");
+    }
+    file << "Auction Title,Auction ID,Department,Close Date,Winning Bid,CC Fee,Fee Percent,"
+            "Auction Fee Subtotal,Fund\n";
+    size_t rows = 0;
+    for (size_t p = 0; p < used; p++) {
+        file << parts[p].text;
+        rows += parts[p].rows;
+    }
+    file.flush();
+    if (!file) {
+        throw runtime_error("write to " + path + " failed");
+    }
+    return rows;
+}
+
+/**
+ * --freeze: build the list's read-optimized copy once a load is done.
+ * Only the list has one; the skip list is already ordered.
+ * @return a status line for the result box, empty if nothing was frozen
+ **/
+static string freezeForReads(BidStore& store) {
+    LinkedList *list = dynamic_cast<LinkedList*>(&store);
+    if (list == nullptr || list->Size() == 0) {
+        return "";
+    }
+    auto start = high_resolution_clock::now();
+    list->Freeze();
+    auto us = duration_cast<microseconds>(high_resolution_clock::now() - start).count();
+
+    stringstream ms;
+    ms << fixed << setprecision(2) << (us / 1000.0);
+    return DIM + "Frozen for reads in " + ms.str() + " ms" + RESET;
+}
+
+/**
+ * --huge-pages, --mlock, --prefault: what the store's large block of
+ * memory actually got, which may be less than asked for.
+ * @return a status line for the result box, empty if no policy was given
+ **/
+static string memoryReport(const BidStore& store, const MemoryPolicy& policy) {
+    if (!policy.Any()) {
+        return "";
+    }
+    MemoryStats stats;
+    if (auto vector = dynamic_cast<const BidVectorList*>(&store)) {
+        stats = vector->Memory();
+    } else if (auto mapped = dynamic_cast<const BidMappedList*>(&store)) {
+        stats = mapped->Memory();
+    } else if (auto shared = dynamic_cast<const BidSharedView*>(&store)) {
+        stats = shared->Memory();
+    } else {
+        return DIM + string("Memory policy applies to --store=vector|mapped and --attach") + RESET;
+    }
+
+    auto mib = [](uint64_t bytes) {
+        stringstream ss;
+        ss << fixed << setprecision(1) << (bytes / 1048576.0);
+        return ss.str() + " MiB";
+    };
+    auto pages = [](size_t bytes) {
+        return bytes >= 1048576 ? to_string(bytes / 1048576) + " MiB pages" : to_string(bytes / 1024) + " KiB pages";
+    };
+    // With explicit huge pages the mapping's own page size is the large one
+    string line = "Memory: ";
+    if (stats.hugePageSize > 0 && stats.pageSize >= stats.hugePageSize) {
+        line += mib(stats.resident) + " in " + pages(stats.pageSize);
+    } else {
+        line += mib(stats.huge) + " in " + pages(stats.hugePageSize) + ", "
+                + mib(stats.resident - stats.huge) + " in " + pages(stats.pageSize);
+    }
+    if (stats.resident < stats.bytes) {
+        line += ", " + mib(stats.bytes - stats.resident) + " not in RAM";
+    }
+    if (policy.lock) {
+        line += ", " + mib(stats.locked) + " locked";
+    }
+    return DIM + line + RESET;
+}
+
+/**
+ * --store=spill: how much of the store is in memory and how much on disk.
+ * @return a status line for the result box, empty for other stores
+ **/
+static string spillReport(const BidStore& store) {
+    auto spill = dynamic_cast<const BidSpillStore*>(&store);
+    if (spill == nullptr) {
+        return "";
+    }
+    SpillStats stats = spill->Stats();
+    auto mib = [](uint64_t bytes) {
+        stringstream ss;
+        ss << fixed << setprecision(1) << (bytes / 1048576.0);
+        return ss.str() + " MiB";
+    };
+    return DIM + to_string(stats.resident) + " of " + to_string(stats.segments) + " segments in memory ("
+           + mib(stats.residentBytes) + " of " + mib(stats.budgetBytes) + "), " + mib(stats.fileBytes)
+           + " spilled, " + to_string(stats.faults) + " read back" + RESET;
+}
+
+/**
+ * --store=compressed: memory per bid, against the same bids as Bid objects.
+ * @return a status line for the result box, empty for other stores
+ **/
+static string compressedReport(const BidStore& store) {
+    auto compressed = dynamic_cast<const BidCompressedStore*>(&store);
+    if (compressed == nullptr) {
+        return "";
+    }
+    CompressedStats stats = compressed->Stats();
+    if (stats.bids == 0) {
+        return "";
+    }
+    stringstream ss;
+    ss << fixed << setprecision(1) << (stats.bytes / 1048576.0) << " MiB compressed, "
+       << (double(stats.bytes) / stats.bids) << " bytes per bid ("
+       << (double(stats.plainBytes) / stats.bytes) << "x smaller)";
+    return DIM + ss.str() + RESET;
+}
+
+/**
+ * --publish: put the store, as it is now, in shared memory for processes
+ * started with --attach. Each call is a new generation.
+ * @return a status line for the result box, empty if not publishing
+ **/
+static string publishForReaders(const string& name, const BidStore& store) {
+    if (name.empty()) {
+        return "";
+    }
+    try {
+        auto start = high_resolution_clock::now();
+        uint64_t generation = publishShared(name, store);
+        auto us = duration_cast<microseconds>(high_resolution_clock::now() - start).count();
+
+        stringstream ms;
+        ms << fixed << setprecision(2) << (us / 1000.0);
+        return DIM + "Published as " + name + " (generation " + to_string(generation) + ") in "
+               + ms.str() + " ms" + RESET;
+    } catch (const BidShmError& e) {
+        return RED + string(e.what()) + RESET;
+    }
+}
+
+//============================================================================
+// Diff (--diff)
+//
+// Reconciles two exports without the menu: loads both (titles stay in the
+// mapped files until printed), prints a summary, then one line per
+// difference: '+' added, '-' removed, '~' changed.
+//============================================================================
+
+static int runDiff(const string& beforePath, const string& afterPath) {
+    LoadOptions load;
+    load.lazyTitles = true;
+
+    LinkedList beforeList, afterList;
+    if (!loadBids(beforePath, &beforeList, load) || !loadBids(afterPath, &afterList, load)) {
+        return 1;
+    }
+
+    auto start = steady_clock::now();
+    BidDiffResult diff = diffBids(beforeList.Snapshot(), afterList.Snapshot());
+    double ms = duration<double, milli>(steady_clock::now() - start).count();
+
+    stringstream time;
+    time << fixed << setprecision(2) << ms;
+    displayResult("DIFF", {
+        DIM + beforePath + " -> " + afterPath + RESET,
+        GREEN + "Added:   " + RESET + to_string(diff.added.size()),
+        RED + "Removed: " + RESET + to_string(diff.removed.size()),
+        YELLOW + "Changed: " + RESET + to_string(diff.changed.size()),
+        DIM + "Time: " + time.str() + " ms (" + (diff.usedMergeJoin ? "merge join" : "hash join") + ")" + RESET
+    }, BOLD + CYAN);
+    cout << '\n';
+
+    for (const Bid& b : diff.added) {
+        cout << GREEN << "+ " << RESET;
+        displayBidCompact(b);
+    }
+    for (const Bid& b : diff.removed) {
+        cout << RED << "- " << RESET;
+        displayBidCompact(b);
+    }
+    for (const BidChange& c : diff.changed) {
+        cout << YELLOW << "~ " << RESET << CYAN << "ID: " << RESET << c.after.bidId;
+        if (c.fields & BidChange::TITLE) {
+            cout << " | " << GREEN << "Title: " << RESET << c.before.Title() << " -> " << c.after.Title();
+        }
+        if (c.fields & BidChange::FUND) {
+            cout << " | " << YELLOW << "Fund: " << RESET << c.before.fund << " -> " << c.after.fund;
+        }
+        if (c.fields & BidChange::AMOUNT) {
+            cout << " | " << MAGENTA << "Amount: " << RESET << fixed << setprecision(2)
+                 << "$" << c.before.amount << " -> $" << c.after.amount;
+        }
+        cout << '\n';
+    }
+    return 0;
+}
+
+//============================================================================
+// Join (--join)
+//
+// Enriches one export with the columns of another by auction ID, e.g. the
+// main export with the December file's InventoryID and ReceiptNumber. The
+// merged CSV goes to stdout so it can be redirected; the summary goes to
+// stderr. Both files keep their ID in column 1, as loadBids expects.
+//============================================================================
+
+static int runJoin(const string& leftPath, const string& rightPath) {
+    const size_t idColumn = 1;
+    try {
+        MappedFile left(leftPath), right(rightPath);
+
+        auto start = steady_clock::now();
+        CsvJoinResult r = joinCsvFiles(left, idColumn, right, idColumn, cout);
+        cout.flush();
+        double ms = duration<double, milli>(steady_clock::now() - start).count();
+
+        cerr << "Joined " << r.joinedRows << " rows (" << r.leftRows << " x " << r.rightRows << "), "
+             << "table built on " << (r.stats.builtOnLeft ? leftPath : rightPath) << ", "
+             << r.stats.partitions << (r.stats.partitions == 1 ? " partition, " : " partitions, ")
+             << fixed << setprecision(2) << ms << " ms" << endl;
+    } catch (const std::runtime_error &e) {
+        cerr << "Error joining '" << leftPath << "' and '" << rightPath << "': " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
+
+//============================================================================
+// Command line options
+//
+// Positional arguments keep their original meaning (csv_path, bid_key).
+// Anything starting with "--" is an option; values follow an '='.
+//============================================================================
+
+struct Options {
+    vector<string> positional;
+    string logPath;            // --log=PATH: durable operation log (off if empty)
+    int    commitWindowMs = 5; // --commit-window=MS: group commit window
+    int    checkpointEvery = 1000; // --checkpoint-every=N: edits between snapshots, 0 = never
+    size_t sampleSize = 0;     // --sample=N: [2] loads a random sample of N rows
+    uint64_t sampleSeed = 0;   // --sample-seed=S: repeatable sample (random if not given)
+    bool   sampleSeedSet = false;
+    bool   lazyTitles = false; // --lazy-titles: keep titles in the mapped CSV
+    bool   diff = false;       // --diff: compare the two positional CSVs and exit
+    bool   join = false;       // --join: merge the two positional CSVs on ID and exit
+    string store = "list";     // --store=list|skiplist|sharded|vector|mapped|spill|compressed: which BidStore holds the bids
+    size_t shards = 0;         // --shards=N: lists in the sharded store, 0 = one per hardware thread
+    string storeFile = "bids.map"; // --store-file=PATH: file behind --store=mapped
+    bool   durable = false;    // --durable: --store=mapped syncs each edit to disk
+    uint64_t memoryBudgetMb = 256; // --memory-budget=MB: bids --store=spill keeps in memory
+    string spillFile = "bids.spill"; // --spill-file=PATH: where --store=spill puts the rest
+    bool   freeze = false;     // --freeze: build the list's read-optimized copy after loading
+    string sortBy;             // --sort=amount|id: reorder the list after loading (off if empty)
+    string publishName;        // --publish=NAME: share the store read-only after each change
+    string attachName;         // --attach=NAME: use a store another process published, read-only
+    MemoryPolicy memory;       // --huge-pages=off|thp|explicit, --mlock, --prefault: placement of the
+                               // vector, mapped and attached stores' memory
+};
+
+static bool parseOptions(int argc, char *argv[], Options& opts) {
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg.rfind("--", 0) != 0) {
+            opts.positional.push_back(arg);
+            continue;
+        }
+
+        size_t eq = arg.find('=');
+        string name = arg.substr(0, eq);
+        string value = (eq == string::npos) ? "" : arg.substr(eq + 1);
+
+        if (name == "--lazy-titles" && eq == string::npos) {
+            opts.lazyTitles = true;
+        } else if (name == "--diff" && eq == string::npos) {
+            opts.diff = true;
+        } else if (name == "--join" && eq == string::npos) {
+            opts.join = true;
+        } else if (name == "--freeze" && eq == string::npos) {
+            opts.freeze = true;
+        } else if (name == "--sort" && (value == "amount" || value == "id")) {
+            opts.sortBy = value;
+        } else if (name == "--store" && (value == "list" || value == "skiplist" || value == "sharded" ||
+                                          value == "vector" || value == "mapped" || value == "spill" ||
+                                          value == "compressed")) {
+            opts.store = value;
+        } else if (name == "--store-file" && !value.empty()) {
+            opts.storeFile = value;
+        } else if (name == "--memory-budget" && !value.empty()) {
+            opts.memoryBudgetMb = max<uint64_t>(1, strtoull(value.c_str(), nullptr, 10));
+        } else if (name == "--spill-file" && !value.empty()) {
+            opts.spillFile = value;
+        } else if (name == "--publish" && !value.empty()) {
+            opts.publishName = value;
+        } else if (name == "--attach" && !value.empty()) {
+            opts.attachName = value;
+        } else if (name == "--huge-pages" && (value == "off" || value == "thp" || value == "explicit")) {
+            opts.memory.hugePages = value == "thp"      ? HugePages::Transparent
+                                  : value == "explicit" ? HugePages::Explicit
+                                                        : HugePages::Off;
+        } else if (name == "--mlock" && eq == string::npos) {
+            opts.memory.lock = true;
+        } else if (name == "--prefault" && eq == string::npos) {
+            opts.memory.prefault = true;
+        } else if (name == "--durable" && eq == string::npos) {
+            opts.durable = true;
+        } else if (name == "--shards" && !value.empty()) {
+            opts.shards = strtoull(value.c_str(), nullptr, 10);
+        } else if (name == "--log" && !value.empty()) {
+            opts.logPath = value;
+        } else if (name == "--commit-window" && !value.empty()) {
+            opts.commitWindowMs = max(0, atoi(value.c_str()));
+        } else if (name == "--checkpoint-every" && !value.empty()) {
+            opts.checkpointEvery = max(0, atoi(value.c_str()));
+        } else if (name == "--sample" && !value.empty()) {
+            opts.sampleSize = strtoull(value.c_str(), nullptr, 10);
+        } else if (name == "--sample-seed" && !value.empty()) {
+            opts.sampleSeed = strtoull(value.c_str(), nullptr, 10);
+            opts.sampleSeedSet = true;
+        } else {
+            cerr << "Unknown or incomplete option: " << arg << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
 /**
  * The one and only main() method
  *
  * @param arg[1] path to CSV file to load from (optional)
  * @param arg[2] the bid Id to use when searching the list (optional)
+ * @param --log=PATH, --commit-window=MS, --checkpoint-every=N,
+ *        --sample=N, --sample-seed=S, --lazy-titles, --diff, --join, --store,
+ *        --freeze, --sort, --shards, --store-file, --durable, --publish,
+ *        --attach, --huge-pages, --mlock, --prefault, --memory-budget,
+ *        --spill-file see Options
  */
 // Helper to check if a file exists
 static bool fileExists(const string& path) {
@@ -729,22 +1168,143 @@ static string findCsvFile(const string& filename) {
 int main(int argc, char *argv[]) {
     setColorTheme();
     // process command line arguments
+    Options opts;
+    if (!parseOptions(argc, argv, opts)) {
+        return 1;
+    }
+
+    if (opts.diff) {
+        if (opts.positional.size() != 2) {
+            cerr << "--diff needs two CSV files: before.csv after.csv" << endl;
+            return 1;
+        }
+        return runDiff(opts.positional[0], opts.positional[1]);
+    }
+    if (opts.join) {
+        if (opts.positional.size() != 2) {
+            cerr << "--join needs two CSV files: main.csv extra.csv" << endl;
+            return 1;
+        }
+        return runJoin(opts.positional[0], opts.positional[1]);
+    }
+
     string csvPath, bidKey;
-    switch (argc) {
-        case 2:
-            csvPath = argv[1];
+    switch (opts.positional.size()) {
+        case 1:
+            csvPath = opts.positional[0];
             bidKey = "98109";
             break;
-        case 3:
-            csvPath = argv[1];
-            bidKey = argv[2];
+        case 2:
+            csvPath = opts.positional[0];
+            bidKey = opts.positional[1];
             break;
         default:
             csvPath = findCsvFile("eBid_Monthly_Sales.csv");
             bidKey = "98109";
     }
 
-    LinkedList bidList;
+    if (!opts.attachName.empty() && (!opts.publishName.empty() || !opts.logPath.empty())) {
+        cerr << "--attach is read-only; it can't be combined with --publish or --log" << endl;
+        return 1;
+    }
+    // The mapped file already keeps the list; replaying a log into it would add everything again
+    if (opts.store == "mapped" && !opts.logPath.empty()) {
+        cerr << "--store=mapped keeps the list in its file; it can't be combined with --log" << endl;
+        return 1;
+    }
+
+    if (opts.sampleSize > 0 && !opts.sampleSeedSet) {
+        opts.sampleSeed = (uint64_t(random_device{}()) << 32) ^ random_device{}();
+    }
+
+    // Insertion-ordered list (default), ID-ordered skip list, lists
+    // sharded by ID hash, a list kept in one vector with 32-bit links, or
+    // one kept in a mapped file from run to run, one that spills to disk
+    // past a memory budget, or an ID-ordered one in compressed blocks.
+    // --attach replaces them all with the image another process published.
+    unique_ptr<BidStore> store;
+    BidSharedView *shared = nullptr;
+    if (!opts.attachName.empty()) {
+        try {
+            auto view = make_unique<BidSharedView>(opts.attachName, opts.memory);
+            vector<string> lines = {
+                GREEN + to_string(view->Size()) + " bids shared as " + opts.attachName + RESET,
+                DIM + "Generation " + to_string(view->Generation()) + ", read-only" + RESET
+            };
+            string memory = memoryReport(*view, opts.memory);
+            if (!memory.empty()) lines.push_back(memory);
+            displayResult("STORE ATTACHED", lines, BOLD + GREEN);
+            shared = view.get();
+            store = move(view);
+        } catch (const BidShmError& e) {
+            cerr << e.what() << endl;
+            return 1;
+        }
+    } else if (opts.store == "skiplist") {
+        store = make_unique<BidSkipList>();
+    } else if (opts.store == "mapped") {
+        try {
+            auto mapped = make_unique<BidMappedList>(opts.storeFile, opts.durable, opts.memory);
+            if (mapped->Size() > 0 || mapped->Recovered()) {
+                vector<string> lines = {
+                    GREEN + to_string(mapped->Size()) + " bids mapped from " + opts.storeFile + RESET
+                };
+                if (mapped->Recovered()) {
+                    lines.push_back(DIM + string("Not closed cleanly last time; links rebuilt") + RESET);
+                }
+                string memory = memoryReport(*mapped, opts.memory);
+                if (!memory.empty()) lines.push_back(memory);
+                displayResult("STORE OPENED", lines, BOLD + GREEN);
+            }
+            store = move(mapped);
+        } catch (const BidMappedListError& e) {
+            cerr << e.what() << endl;
+            return 1;
+        }
+    } else if (opts.store == "spill") {
+        try {
+            store = make_unique<BidSpillStore>(opts.spillFile, opts.memoryBudgetMb << 20);
+        } catch (const BidSpillError& e) {
+            cerr << e.what() << endl;
+            return 1;
+        }
+    } else if (opts.store == "compressed") {
+        store = make_unique<BidCompressedStore>();
+    } else if (opts.store == "vector") {
+        store = make_unique<BidVectorList>(opts.memory);
+    } else if (opts.store == "sharded") {
+        store = make_unique<BidShardedStore>(opts.shards, [] { return make_unique<LinkedList>(); });
+    } else {
+        store = make_unique<LinkedList>();
+    }
+    BidStore &bidList = *store;
+
+    // Bring back everything saved by earlier sessions before showing the menu
+    Persistence persist;
+    if (!opts.logPath.empty()) {
+        try {
+            const string checkpointPath = opts.logPath + ".ckpt";
+            persist.log = make_unique<BidLog>(opts.logPath, milliseconds(opts.commitWindowMs));
+            persist.checkpointer = make_unique<Checkpointer>(*persist.log, checkpointPath);
+            persist.checkpointEvery = opts.checkpointEvery;
+
+            size_t replayed = recoverList(*persist.log, checkpointPath, bidList, opts.lazyTitles, opts.sortBy);
+            if (bidList.Size() > 0 || replayed > 0) {
+                vector<string> lines = {
+                    GREEN + to_string(replayed) + " operations from " + opts.logPath + RESET,
+                    DIM + to_string(bidList.Size()) + " bids restored" + RESET
+                };
+                string frozen = opts.freeze ? freezeForReads(bidList) : "";
+                if (!frozen.empty()) lines.push_back(frozen);
+                string published = publishForReaders(opts.publishName, bidList);
+                if (!published.empty()) lines.push_back(published);
+                displayResult("LOG REPLAYED", lines, BOLD + GREEN);
+            }
+        } catch (const BidLogError& e) {
+            cerr << e.what() << endl;
+            return 1;
+        }
+    }
 
     Bid bid;
 
@@ -764,6 +1324,27 @@ int main(int argc, char *argv[]) {
         // success path: eat the trailing newline once
         cin.ignore(numeric_limits<streamsize>::max(), '\n');
 
+        // An attached store only reads, and reads the newest generation
+        if (shared != nullptr) {
+            if (choice == 1 || choice == 2 || choice == 5) {
+                displayResult("ERROR", {
+                    RED + "The store is attached read-only." + RESET,
+                    DIM + "Add, load and remove in the process that publishes " + opts.attachName + "." + RESET
+                }, BOLD + RED);
+                cout << '\n';
+                waitForEnter();
+                continue;
+            }
+            try {
+                shared->Refresh();
+            } catch (const BidShmError& e) {
+                displayResult("ERROR", {RED + string(e.what()) + RESET,
+                                        DIM + "Still showing generation " + to_string(shared->Generation()) + RESET},
+                              BOLD + RED);
+                waitForEnter();
+            }
+        }
+
         switch (choice) {
             case 1: {
                 // Get bid info from user
@@ -784,33 +1365,72 @@ int main(int argc, char *argv[]) {
 
                 // Add the new bid
                 bidList.Append(b);
+                commitToLog(persist, bidList, 1, [&](BidLog& log) { return log.LogAppend(b); });
 
                 stringstream ss;
                 ss << fixed << setprecision(2) << b.amount;
 
-                displayResult("BID ADDED", {
+                vector<string> lines = {
                     CYAN + "ID:      " + RESET + b.bidId,
                     GREEN + "Title:   " + RESET + b.title,
                     YELLOW + "Fund:    " + RESET + b.fund,
                     MAGENTA + "Amount:  " + RESET + "$" + ss.str()
-                }, BOLD + GREEN);
+                };
+                string published = publishForReaders(opts.publishName, bidList);
+                if (!published.empty()) lines.push_back(published);
+                displayResult("BID ADDED", lines, BOLD + GREEN);
                 cout << '\n';
                 waitForEnter();
                 break;
             }
             case 2: {
+                int sizeBefore = bidList.Size();
+                LoadSketches sketches;
+                LoadOptions load;
+                load.sketches = &sketches;
+                load.sampleSize = opts.sampleSize;
+                load.sampleSeed = opts.sampleSeed;
+                load.lazyTitles = opts.lazyTitles;
+
                 clock_t ticks = clock();
-                loadBids(csvPath, &bidList);
+                bool loaded = loadBids(csvPath, &bidList, load);
                 ticks = clock() - ticks;
+                // Before the log: a checkpoint taken for this load must hold the sorted order
+                string sorted = loaded ? sortForReports(bidList, opts.sortBy) : "";
+                if (loaded) {
+                    commitToLog(persist, bidList, bidList.Size() - sizeBefore, [&](BidLog& log) {
+                        return log.LogLoad(csvPath, load.sampleSize, load.sampleSeed);
+                    });
+                }
 
                 stringstream ms, sec;
                 ms << fixed << setprecision(2) << (ticks * 1000.0 / CLOCKS_PER_SEC);
                 sec << fixed << setprecision(4) << (ticks * 1.0 / CLOCKS_PER_SEC);
 
-                displayResult("BIDS LOADED", {
+                vector<string> lines = {
                     GREEN + to_string(bidList.Size()) + " bids read" + RESET,
                     DIM + "Time: " + ms.str() + " ms (" + sec.str() + " s)" + RESET
-                }, BOLD + GREEN);
+                };
+                if (opts.sampleSize > 0) {
+                    lines.insert(lines.begin() + 1, DIM + "Random sample of up to "
+                                 + to_string(opts.sampleSize) + " rows" + RESET);
+                }
+                if (!sorted.empty()) lines.push_back(sorted);
+                string frozen = (loaded && opts.freeze) ? freezeForReads(bidList) : "";
+                if (!frozen.empty()) lines.push_back(frozen);
+                string published = loaded ? publishForReaders(opts.publishName, bidList) : "";
+                if (!published.empty()) lines.push_back(published);
+                string memory = loaded ? memoryReport(bidList, opts.memory) : "";
+                if (!memory.empty()) lines.push_back(memory);
+                string spill = loaded ? spillReport(bidList) : "";
+                if (!spill.empty()) lines.push_back(spill);
+                string compressed = loaded ? compressedReport(bidList) : "";
+                if (!compressed.empty()) lines.push_back(compressed);
+                if (loaded && sketches.amounts.Count() > 0) {
+                    lines.push_back("");
+                    appendLoadSummary(sketches, lines);
+                }
+                displayResult("BIDS LOADED", lines, BOLD + GREEN);
                 cout << '\n';
                 waitForEnter();
                 break;
@@ -827,17 +1447,61 @@ int main(int argc, char *argv[]) {
                     drawBoxLineCenter("ALL BIDS (" + to_string(bidList.Size()) + " total)", getTerminalWidth() - 2, BOLD + CYAN);
                     drawBoxBottom(getTerminalWidth() - 2);
                     cout << '\n';
-                    bidList.PrintList();
+                    bidList.ForEach(displayBid);
                     cout << '\n';
                 }
                 waitForEnter();
                 break;
             }
             case 4: {
-                cout << '\n' << CYAN << "Enter Bid ID to find: " << RESET;
+                cout << '\n' << CYAN << "Enter Bid ID(s) to find: " << RESET;
                 string searchId;
                 getline(cin, searchId);
 
+                // Several IDs (space or comma separated) are looked up as one batch
+                vector<string> batchIds;
+                {
+                    string id;
+                    stringstream in(searchId);
+                    while (in >> id) {
+                        stringstream parts(id);
+                        string part;
+                        while (getline(parts, part, ',')) {
+                            if (!part.empty()) batchIds.push_back(part);
+                        }
+                    }
+                }
+                if (batchIds.size() > 1) {
+                    auto startTime = high_resolution_clock::now();
+                    vector<Bid> results = bidList.SearchBatch(batchIds);
+                    auto us = duration_cast<microseconds>(high_resolution_clock::now() - startTime).count();
+
+                    cout << '\n';
+                    size_t found = 0;
+                    string missing;
+                    for (size_t i = 0; i < results.size(); i++) {
+                        if (results[i].bidId.empty()) {
+                            missing += (missing.empty() ? "" : ", ") + batchIds[i];
+                        } else {
+                            displayBidCompact(results[i]);
+                            found++;
+                        }
+                    }
+
+                    vector<string> lines = {
+                        CYAN + "Found:   " + RESET + to_string(found) + " of " + to_string(batchIds.size())
+                    };
+                    if (!missing.empty()) {
+                        lines.push_back(RED + "Missing: " + RESET + missing);
+                    }
+                    lines.push_back("");
+                    lines.push_back(DIM + "Search time: " + to_string(us) + " us" + RESET);
+                    displayResult("BATCH FIND", lines, found == batchIds.size() ? BOLD + GREEN : BOLD + YELLOW);
+                    cout << '\n';
+                    waitForEnter();
+                    break;
+                }
+
                 // Trim whitespace
                 size_t startPos = searchId.find_first_not_of(" \t");
                 size_t endPos = searchId.find_last_not_of(" \t");
@@ -869,7 +1533,7 @@ int main(int argc, char *argv[]) {
                     // Don't truncate - let the box grow to fit content
                     displayResult("BID FOUND", {
                         CYAN + "ID:      " + RESET + result.bidId,
-                        GREEN + "Title:   " + RESET + result.title,
+                        GREEN + "Title:   " + RESET + result.Title(),
                         YELLOW + "Fund:    " + RESET + result.fund,
                         MAGENTA + "Amount:  " + RESET + "$" + ss.str(),
                         "",
@@ -905,12 +1569,14 @@ int main(int argc, char *argv[]) {
                     break;
                 }
 
-                Bid check = bidList.Search(removeId);
-                if (!check.bidId.empty()) {
-                    bidList.Remove(removeId);
-                    displayResult("BID REMOVED", {
+                if (bidList.Remove(removeId)) {
+                    commitToLog(persist, bidList, 1, [&](BidLog& log) { return log.LogRemove(removeId); });
+                    vector<string> lines = {
                         GREEN + "Successfully removed bid ID: " + removeId + RESET
-                    }, BOLD + GREEN);
+                    };
+                    string published = publishForReaders(opts.publishName, bidList);
+                    if (!published.empty()) lines.push_back(published);
+                    displayResult("BID REMOVED", lines, BOLD + GREEN);
                 } else {
                     displayResult("NOT FOUND", {
                         RED + "Bid ID " + removeId + " was not in the list." + RESET
@@ -920,6 +1586,123 @@ int main(int argc, char *argv[]) {
                 waitForEnter();
                 break;
             }
+            case 6: {
+                cout << '\n' << CYAN << "Enter fund name: " << RESET;
+                string fund;
+                getline(cin, fund);
+
+                // Trim whitespace
+                size_t startPos = fund.find_first_not_of(" \t");
+                size_t endPos = fund.find_last_not_of(" \t");
+                if (startPos != string::npos) {
+                    fund = fund.substr(startPos, endPos - startPos + 1);
+                } else {
+                    fund = "";
+                }
+
+                int count = bidList.FundSize(fund);
+                if (count == 0) {
+                    displayResult("NOT FOUND", {
+                        RED + "No bids for fund '" + fund + "'." + RESET
+                    }, BOLD + RED);
+                } else {
+                    cout << '\n';
+                    drawBoxTop(getTerminalWidth() - 2);
+                    drawBoxLineCenter(fund + " (" + to_string(count) + " bids)", getTerminalWidth() - 2, BOLD + CYAN);
+                    drawBoxBottom(getTerminalWidth() - 2);
+                    cout << '\n';
+
+                    double total = 0.0;
+                    bidList.ForEachInFund(fund, [&](const Bid& b) {
+                        displayBidCompact(b);
+                        total += b.amount;
+                    });
+
+                    stringstream ss;
+                    ss << fixed << setprecision(2) << total;
+                    displayResult("FUND TOTAL", {
+                        YELLOW + "Fund:    " + RESET + fund,
+                        CYAN + "Bids:    " + RESET + to_string(count),
+                        MAGENTA + "Total:   " + RESET + "$" + ss.str()
+                    }, BOLD + GREEN);
+                }
+                cout << '\n';
+                waitForEnter();
+                break;
+            }
+            case 7: {
+                cout << '\n' << CYAN << "Enter amount range (low high): " << RESET;
+                string line;
+                getline(cin, line);
+
+                double low = 0.0, high = 0.0;
+                stringstream in(line);
+                if (!(in >> low >> high) || low > high) {
+                    displayResult("ERROR", {RED + "Enter two amounts, lowest first." + RESET}, BOLD + RED);
+                    cout << '\n';
+                    waitForEnter();
+                    break;
+                }
+
+                cout << '\n';
+                int count = 0;
+                double total = 0.0;
+                bidList.ForEachInAmountRange(low, high, [&](const Bid& b) {
+                    displayBidCompact(b);
+                    count++;
+                    total += b.amount;
+                });
+
+                stringstream range, ss;
+                range << fixed << setprecision(2) << "$" << low << " - $" << high;
+                ss << fixed << setprecision(2) << total;
+                displayResult(count == 0 ? "NOT FOUND" : "AMOUNT RANGE", {
+                    CYAN + "Range:   " + RESET + range.str(),
+                    CYAN + "Bids:    " + RESET + to_string(count),
+                    MAGENTA + "Total:   " + RESET + "$" + ss.str()
+                }, count == 0 ? BOLD + RED : BOLD + GREEN);
+                cout << '\n';
+                waitForEnter();
+                break;
+            }
+            case 8: {
+                cout << '\n' << CYAN << "Enter file to write: " << RESET;
+                string path;
+                getline(cin, path);
+
+                // Trim whitespace
+                size_t startPos = path.find_first_not_of(" \t");
+                size_t endPos = path.find_last_not_of(" \t");
+                path = (startPos == string::npos) ? "" : path.substr(startPos, endPos - startPos + 1);
+
+                if (path.empty()) {
+                    displayResult("ERROR", {RED + "No file name entered." + RESET}, BOLD + RED);
+                    cout << '\n';
+                    waitForEnter();
+                    break;
+                }
+
+                try {
+                    auto startTime = high_resolution_clock::now();
+                    size_t rows = exportCsv(bidList, path);
+                    auto us = duration_cast<microseconds>(high_resolution_clock::now() - startTime).count();
+                    BidTotals totals = bidList.TotalsParallel();
+
+                    stringstream ms, total;
+                    ms << fixed << setprecision(2) << (us / 1000.0);
+                    total << fixed << setprecision(2) << totals.total;
+                    displayResult("BIDS EXPORTED", {
+                        GREEN + to_string(rows) + " bids written to " + path + RESET,
+                        MAGENTA + "Total:   " + RESET + "$" + total.str(),
+                        DIM + "Time: " + ms.str() + " ms" + RESET
+                    }, BOLD + GREEN);
+                } catch (const runtime_error& e) {
+                    displayResult("ERROR", {RED + string(e.what()) + RESET}, BOLD + RED);
+                }
+                cout << '\n';
+                waitForEnter();
+                break;
+            }
             case 9: {
                 cout << '\n';
                 drawBoxTop(20);
@@ -0,0 +1,146 @@
+#include <fstream>
+#include <iterator>
+
+#include "MappedCsv.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define HAVE_MMAP 1
+#endif
+
+MappedFile::MappedFile(const std::string& path) : filePath(path) {
+#ifdef HAVE_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open " + path);
+    }
+    struct stat st{};
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Failed to stat " + path);
+    }
+    length = static_cast<size_t>(st.st_size);
+    if (length > 0) {
+        void* p = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) {
+            ::close(fd);
+            throw std::runtime_error("Failed to map " + path);
+        }
+        bytes = static_cast<const char*>(p);
+    }
+    ::close(fd); // the mapping keeps its own reference to the file
+#else
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        throw std::runtime_error("Failed to open " + path);
+    }
+    fallback.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    bytes = fallback.data();
+    length = fallback.size();
+#endif
+}
+
+MappedFile::~MappedFile() {
+#ifdef HAVE_MMAP
+    if (bytes != nullptr) {
+        ::munmap(const_cast<char*>(bytes), length);
+    }
+#endif
+}
+
+// Split one line [start, end) into fields; separators inside quotes don't count
+static void splitCsvLine(const char* data, size_t start, size_t end, char sep,
+                         std::vector<FieldSpan>& fields) {
+    fields.clear();
+    bool quoted = false;
+    size_t tokenStart = start;
+    for (size_t i = start; i < end; i++) {
+        if (data[i] == '"') {
+            quoted = !quoted;
+        } else if (data[i] == sep && !quoted) {
+            fields.push_back({tokenStart, static_cast<uint32_t>(i - tokenStart)});
+            tokenStart = i + 1;
+        }
+    }
+    fields.push_back({tokenStart, static_cast<uint32_t>(end - tokenStart)});
+}
+
+// Visit every non-empty line (without its line ending) until 'line' returns false
+template <typename Visit>
+static void forEachCsvLine(const MappedFile& file, Visit line) {
+    const char* data = file.data();
+    const size_t size = file.size();
+
+    size_t lineStart = 0;
+    while (lineStart < size) {
+        size_t lineEnd = lineStart;
+        while (lineEnd < size && data[lineEnd] != '\n') lineEnd++;
+        size_t next = lineEnd + 1;
+        if (lineEnd > lineStart && data[lineEnd - 1] == '\r') lineEnd--;
+
+        if (lineEnd > lineStart && !line(lineStart, lineEnd)) {
+            return;
+        }
+        lineStart = next;
+    }
+}
+
+/**
+ * Same splitting rules as csv::Parser::parseContent, but on the mapped
+ * bytes: remember where each field starts instead of copying it out.
+ */
+void scanCsvRows(const MappedFile& file, char sep,
+                 const std::function<void(const std::vector<FieldSpan>&)>& row) {
+    std::vector<FieldSpan> fields;
+    size_t headerColumns = 0;
+    bool isHeader = true;
+
+    forEachCsvLine(file, [&](size_t start, size_t end) {
+        splitCsvLine(file.data(), start, end, sep, fields);
+        if (isHeader) {
+            headerColumns = fields.size();
+            isHeader = false;
+        } else {
+            if (fields.size() != headerColumns) {
+                throw std::runtime_error("corrupted data in " + file.path());
+            }
+            row(fields);
+        }
+        return true;
+    });
+}
+
+std::vector<FieldSpan> scanCsvHeader(const MappedFile& file, char sep) {
+    std::vector<FieldSpan> fields;
+    forEachCsvLine(file, [&](size_t start, size_t end) {
+        splitCsvLine(file.data(), start, end, sep, fields);
+        return false;
+    });
+    return fields;
+}
+
+void requireCsvColumns(const MappedFile& file, char sep, size_t columns) {
+    size_t found = scanCsvHeader(file, sep).size();
+    if (found < columns) {
+        throw std::runtime_error(file.path() + " has " + std::to_string(found) + " columns, expected at least "
+                                 + std::to_string(columns));
+    }
+}
+
+std::string unquoteCsvField(std::string_view raw) {
+    if (raw.size() < 2 || raw.front() != '"' || raw.back() != '"') {
+        return std::string(raw);
+    }
+    std::string out;
+    out.reserve(raw.size() - 2);
+    for (size_t i = 1; i + 1 < raw.size(); i++) {
+        out.push_back(raw[i]);
+        if (raw[i] == '"' && raw[i + 1] == '"' && i + 2 < raw.size()) {
+            i++; // "" inside quotes is one literal quote
+        }
+    }
+    return out;
+}
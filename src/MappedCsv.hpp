@@ -0,0 +1,71 @@
+//============================================================================
+// Name        : MappedCsv.hpp
+//
+// Read-only memory mapping of a CSV file plus a scanner that reports where
+// each field starts and ends, without copying anything.
+//
+// Why? In lazy-title mode a bid keeps only the offset and length of its
+// title inside the mapped file. The OS pages the bytes in when a title is
+// actually shown and can drop them again under memory pressure, so the
+// largest field costs no heap memory per bid.
+//
+// Rows follow the same rules as csv::Parser: one row per line, commas inside
+// double quotes don't split, and quotes are left in the raw field.
+//============================================================================
+
+#ifndef MAPPED_CSV_HPP
+#define MAPPED_CSV_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path);   // throws std::runtime_error
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return bytes; }
+    size_t size() const { return length; }
+    std::string_view view(uint64_t offset, uint32_t count) const {
+        return std::string_view(bytes + offset, count);
+    }
+    const std::string& path() const { return filePath; }
+
+private:
+    std::string filePath;
+    const char* bytes  = nullptr;
+    size_t      length = 0;
+    std::string fallback;   // whole file in memory where mmap isn't available
+};
+
+struct FieldSpan {
+    uint64_t offset;
+    uint32_t length;
+};
+
+// Calls 'row' for every non-empty line after the header. The spans point
+// into file.data(); the vector is reused between calls. Like csv::Parser,
+// throws if a row's field count differs from the header's.
+void scanCsvRows(const MappedFile& file, char sep,
+                 const std::function<void(const std::vector<FieldSpan>&)>& row);
+
+// The header line's fields (empty for an empty file)
+std::vector<FieldSpan> scanCsvHeader(const MappedFile& file, char sep);
+
+// Throws std::runtime_error naming the file if its header has fewer than
+// 'columns' fields. Rows only have to match the header, so a caller that
+// reads fixed column numbers checks this once before scanning.
+void requireCsvColumns(const MappedFile& file, char sep, size_t columns);
+
+// "\"\"\"ASE\"\" File Cabinet\"" -> "\"ASE\" File Cabinet"
+std::string unquoteCsvField(std::string_view raw);
+
+#endif // MAPPED_CSV_HPP
@@ -0,0 +1,32 @@
+//============================================================================
+// Name        : TestBids.hpp
+//
+// Helpers shared by the store tests: a bid built from its ID, and the IDs
+// of a store in the order it walks them.
+//============================================================================
+
+#ifndef TEST_BIDS_HPP
+#define TEST_BIDS_HPP
+
+#include <string>
+#include <vector>
+
+#include "BidStore.hpp"
+
+// Titled "Bid <id>"; tests that need other titles set them afterwards
+inline Bid makeBid(const std::string& id, const std::string& fund = "General Fund", double amount = 1.0) {
+    Bid b;
+    b.bidId = id;
+    b.title = "Bid " + id;
+    b.fund = fund;
+    b.amount = amount;
+    return b;
+}
+
+inline std::vector<std::string> idsOf(const BidStore& store) {
+    std::vector<std::string> ids;
+    store.ForEach([&](const Bid& b) { ids.push_back(b.bidId); });
+    return ids;
+}
+
+#endif // TEST_BIDS_HPP
@@ -0,0 +1,214 @@
+//============================================================================
+// Unit Tests for BidAsync
+//
+// Tests futures and callbacks for Search and Filter, merging of identical
+// in-flight lookups, both queue-limit policies, stealing from a worker
+// stuck on a long task, and failures reaching completion callbacks.
+//============================================================================
+
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BidAsync.hpp"
+#include "BidSkipList.hpp"
+#include "TestBids.hpp"
+
+using namespace std;
+
+// Store whose Search waits until released, so lookups stay in flight
+class GatedStore : public BidStore {
+public:
+    shared_future<void> gate;
+    mutable atomic<int> searches{0};
+
+    void Append(const Bid&) override {}
+    void Prepend(const Bid&) override {}
+    bool Remove(const string&) override { return false; }
+    Bid Search(const string& bidId) const override {
+        searches++;
+        gate.wait();
+        if (bidId == "bad") throw runtime_error("unreadable bid");
+        return makeBid(bidId);
+    }
+    int Size() const override { return 0; }
+    void ForEach(const function<void(const Bid&)>&) const override {}
+};
+
+TEST_CASE("Async search and filter answer through futures and callbacks", "[async]") {
+    BidSkipList list;
+    for (int i = 0; i < 100; i++) list.Append(makeBid(to_string(i), i % 2 ? "Odd" : "Even"));
+    BidAsyncQueries queries(list, {2, 64, true});
+
+    shared_future<Bid> hit = queries.Search("42");
+    shared_future<Bid> miss = queries.Search("420");
+    REQUIRE(hit.get().title == "Bid 42");
+    REQUIRE(miss.get().bidId.empty());
+
+    promise<string> called;
+    queries.Search("7", [&](const Bid& b, exception_ptr) { called.set_value(b.bidId); });
+    REQUIRE(called.get_future().get() == "7");
+
+    future<vector<Bid>> odd = queries.Filter([](const Bid& b) { return b.fund == "Odd"; });
+    REQUIRE(odd.get().size() == 50);
+
+    promise<size_t> filtered;
+    queries.Filter([](const Bid& b) { return b.bidId.size() == 1; },
+                   [&](vector<Bid> found, exception_ptr) { filtered.set_value(found.size()); });
+    REQUIRE(filtered.get_future().get() == 10);
+}
+
+TEST_CASE("Async searches for one ID share a single lookup", "[async]") {
+    promise<void> release;
+    GatedStore store;
+    store.gate = release.get_future().share();
+    BidAsyncQueries queries(store, {2, 64, true});
+
+    vector<shared_future<Bid>> futures;
+    atomic<int> callbacks{0};
+    for (int i = 0; i < 10; i++) futures.push_back(queries.Search("5"));
+    queries.Search("5", [&](const Bid&, exception_ptr) { callbacks++; });
+    futures.push_back(queries.Search("6"));
+
+    release.set_value();
+    for (auto& f : futures) f.wait();
+    REQUIRE(futures[0].get().bidId == "5");
+    REQUIRE(futures[10].get().bidId == "6");
+    REQUIRE(store.searches == 2);
+    REQUIRE(queries.MergedSearches() == 10);
+
+    // Once answered, a new request looks the ID up again
+    REQUIRE(queries.Search("5").get().bidId == "5");
+    REQUIRE(store.searches == 3);
+    REQUIRE(callbacks == 1);
+}
+
+TEST_CASE("Worker pool rejects or waits when its queue is full", "[async]") {
+    SECTION("reject") {
+        promise<void> release;
+        shared_future<void> gate = release.get_future().share();
+        BidWorkerPool pool({1, 2, false});
+        promise<void> started;
+        pool.Submit([&] { started.set_value(); gate.wait(); });
+        started.get_future().wait();   // the worker is busy, the queue empty
+
+        pool.Submit([] {});
+        pool.Submit([] {});
+        size_t queued = pool.Queued();
+        bool rejected = false;
+        try {
+            pool.Submit([] {});
+        } catch (const BidQueueFull&) {
+            rejected = true;
+        }
+        release.set_value();   // before any REQUIRE, or a failure leaves the pool stuck
+        REQUIRE(queued == 2);
+        REQUIRE(rejected);
+    }
+    SECTION("block") {
+        promise<void> release;
+        shared_future<void> gate = release.get_future().share();
+        BidWorkerPool pool({1, 1, true});
+        promise<void> started;
+        pool.Submit([&] { started.set_value(); gate.wait(); });
+        started.get_future().wait();
+        pool.Submit([] {});
+
+        atomic<bool> submitted{false};
+        thread producer([&] { pool.Submit([] {}); submitted = true; });
+        this_thread::sleep_for(chrono::milliseconds(50));
+        bool submittedWhileFull = submitted;
+        release.set_value();
+        producer.join();
+        REQUIRE_FALSE(submittedWhileFull);
+        REQUIRE(submitted);
+    }
+}
+
+TEST_CASE("Idle workers steal tasks queued behind a long one", "[async]") {
+    promise<void> release;
+    shared_future<void> gate = release.get_future().share();
+    BidWorkerPool pool({2, 64, true});
+
+    atomic<int> done{0};
+    promise<void> started;
+    pool.Submit([&] { started.set_value(); gate.wait(); });
+    started.get_future().wait();
+    for (int i = 0; i < 10; i++) pool.Submit([&] { done++; });
+
+    // Half of these sit in the blocked worker's deque; only stealing runs them
+    for (int spins = 0; done < 10 && spins < 5000; spins++) {
+        this_thread::sleep_for(chrono::milliseconds(1));
+    }
+    int finished = done;
+    release.set_value();
+    REQUIRE(finished == 10);
+    REQUIRE(pool.Steals() > 0);
+}
+
+TEST_CASE("Failed queries reach their completion callbacks", "[async]") {
+    SECTION("lookup and filter errors") {
+        promise<void> open;
+        open.set_value();
+        GatedStore store;
+        store.gate = open.get_future().share();
+        BidSkipList list;
+        list.Append(makeBid("1"));
+        BidAsyncQueries storeQueries(store, {2, 64, true});
+        BidAsyncQueries listQueries(list, {2, 64, true});
+
+        promise<bool> searched;
+        storeQueries.Search("bad", [&](const Bid& b, exception_ptr error) {
+            searched.set_value(error && b.bidId.empty());
+        });
+        REQUIRE(searched.get_future().get());
+
+        promise<bool> filtered;
+        listQueries.Filter([](const Bid&) -> bool { throw runtime_error("bad filter"); },
+                           [&](vector<Bid> found, exception_ptr error) {
+                               filtered.set_value(error && found.empty());
+                           });
+        REQUIRE(filtered.get_future().get());
+    }
+    SECTION("a request joined to a lookup the pool refused") {
+        promise<void> release;
+        GatedStore store;
+        store.gate = release.get_future().share();
+        auto queries = make_unique<BidAsyncQueries>(store, BidPoolOptions{1, 1, true});
+        shared_future<Bid> busy = queries->Search("A");
+        while (store.searches == 0) this_thread::yield();   // the worker is busy
+        shared_future<Bid> waiting = queries->Search("B");  // the queue is full
+
+        // One of these waits in Submit for room, the other joins its lookup
+        atomic<int> told{0};
+        atomic<int> thrown{0};
+        BidAsyncQueries* q = queries.get();
+        auto request = [&] {
+            try {
+                q->Search("C", [&](const Bid&, exception_ptr error) {
+                    if (error && told++ == 0) release.set_value();
+                });
+            } catch (const BidQueueFull&) {
+                thrown++;
+            }
+        };
+        thread first(request);
+        thread second(request);
+        while (q->MergedSearches() == 0) this_thread::yield();
+
+        // Shutting down fails the waiting Submit; the joined callback releases the store
+        queries.reset();
+        first.join();
+        second.join();
+        REQUIRE(thrown == 1);
+        REQUIRE(told == 1);
+        REQUIRE(busy.get().bidId == "A");
+        REQUIRE(waiting.get().bidId == "B");
+    }
+}
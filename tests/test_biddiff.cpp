@@ -0,0 +1,149 @@
+//============================================================================
+// Unit Tests for BidDiff
+//
+// Tests added/removed/changed detection through both join strategies,
+// numeric ID ordering, and that both joins match IDs the same way.
+//============================================================================
+
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <vector>
+
+#include "Bid.hpp"
+#include "BidDiff.hpp"
+
+using namespace std;
+
+static Bid makeBid(const string& id, const string& title, const string& fund, double amount) {
+    Bid b;
+    b.bidId = id;
+    b.title = title;
+    b.fund = fund;
+    b.amount = amount;
+    return b;
+}
+
+static vector<string> ids(const vector<Bid>& bids) {
+    vector<string> out;
+    for (const auto& b : bids) out.push_back(b.bidId);
+    return out;
+}
+
+TEST_CASE("Numeric IDs order by value, others as text", "[biddiff]") {
+    REQUIRE(bidIdLess("99", "100"));
+    REQUIRE_FALSE(bidIdLess("100", "99"));
+    REQUIRE_FALSE(bidIdLess("007", "7"));
+    REQUIRE_FALSE(bidIdLess("7", "007"));
+    REQUIRE(bidIdLess("A10", "A9"));
+    REQUIRE(bidIdLess("10", "1a"));        // numbers before text, always
+    REQUIRE(bidIdLess("2", "1a"));
+    REQUIRE_FALSE(bidIdLess("1a", "2"));
+}
+
+TEST_CASE("Sorted inputs are diffed with a merge join", "[biddiff]") {
+    vector<Bid> before = {
+        makeBid("9", "Desk", "General", 5.0),
+        makeBid("10", "Chair", "General", 1.0),
+        makeBid("11", "Lamp", "Enterprise", 2.0),
+    };
+    vector<Bid> after = {
+        makeBid("10", "Chair", "General", 1.5),
+        makeBid("11", "Lamp", "Enterprise", 2.0),
+        makeBid("12", "Couch", "General", 9.0),
+    };
+
+    BidDiffResult d = diffBids(before, after);
+    REQUIRE(d.usedMergeJoin);
+    REQUIRE(ids(d.added) == vector<string>{"12"});
+    REQUIRE(ids(d.removed) == vector<string>{"9"});
+    REQUIRE(d.changed.size() == 1);
+    REQUIRE(d.changed[0].after.bidId == "10");
+    REQUIRE(d.changed[0].fields == BidChange::AMOUNT);
+    REQUIRE(d.changed[0].before.amount == 1.0);
+}
+
+TEST_CASE("Unsorted inputs use the partitioned hash join", "[biddiff]") {
+    vector<Bid> before, after;
+    for (int i = 1000; i > 0; i--) {
+        before.push_back(makeBid(to_string(i), "T" + to_string(i), "F", i));
+    }
+    for (int i = 1; i <= 1100; i++) {
+        if (i % 100 == 0) continue;                 // 10 removed (100..1000)
+        Bid b = makeBid(to_string(i), "T" + to_string(i), "F", i);
+        if (i == 7) b.title = "Renamed";
+        if (i == 8) { b.fund = "G"; b.amount = 1.0; }
+        after.push_back(b);                          // 1001..1099 added
+    }
+
+    BidDiffResult d = diffBids(before, after, 4);
+    REQUIRE_FALSE(d.usedMergeJoin);
+    REQUIRE(d.added.size() == 99);
+    REQUIRE(d.added.front().bidId == "1001");
+    REQUIRE(d.removed.size() == 10);
+    REQUIRE(d.removed.front().bidId == "100");
+    REQUIRE(d.removed.back().bidId == "1000");
+    REQUIRE(d.changed.size() == 2);
+    REQUIRE(d.changed[0].fields == BidChange::TITLE);
+    REQUIRE(d.changed[1].fields == (BidChange::FUND | BidChange::AMOUNT));
+
+    // Same answer with one thread
+    BidDiffResult single = diffBids(before, after, 1);
+    REQUIRE(ids(single.added) == ids(d.added));
+    REQUIRE(ids(single.removed) == ids(d.removed));
+    REQUIRE(single.changed.size() == 2);
+}
+
+TEST_CASE("Identical or empty exports produce no differences", "[biddiff]") {
+    vector<Bid> bids = {makeBid("2", "B", "F", 2.0), makeBid("1", "A", "F", 1.0)};
+    BidDiffResult same = diffBids(bids, bids);
+    REQUIRE(same.added.empty());
+    REQUIRE(same.removed.empty());
+    REQUIRE(same.changed.empty());
+
+    BidDiffResult fromEmpty = diffBids({}, bids);
+    REQUIRE(ids(fromEmpty.added) == vector<string>{"1", "2"});
+}
+
+TEST_CASE("Repeated IDs are paired in file order by both joins", "[biddiff]") {
+    vector<Bid> before = {makeBid("5", "A", "F", 1.0), makeBid("5", "B", "F", 2.0)};
+    vector<Bid> after = {makeBid("5", "A", "F", 1.0), makeBid("5", "B", "F", 3.0), makeBid("5", "C", "F", 4.0)};
+
+    BidDiffResult merged = diffBids(before, after);
+    REQUIRE(merged.usedMergeJoin);
+
+    before.insert(before.begin(), makeBid("9", "Z", "F", 1.0));  // unsorted now
+    after.insert(after.begin(), makeBid("9", "Z", "F", 1.0));
+    BidDiffResult hashed = diffBids(before, after, 2);
+    REQUIRE_FALSE(hashed.usedMergeJoin);
+
+    for (const auto& d : {merged, hashed}) {
+        REQUIRE(d.removed.empty());
+        REQUIRE(d.added.size() == 1);
+        REQUIRE(d.added[0].title == "C");
+        REQUIRE(d.changed.size() == 1);
+        REQUIRE(d.changed[0].before.title == "B");
+        REQUIRE(d.changed[0].fields == BidChange::AMOUNT);
+    }
+}
+
+TEST_CASE("Leading zeros don't split a numeric ID in either join", "[biddiff]") {
+    vector<Bid> before = {makeBid("000", "Z", "F", 1.0), makeBid("007", "A", "F", 1.0), makeBid("A7", "T", "F", 1.0)};
+    vector<Bid> after = {makeBid("0", "Z", "F", 1.0), makeBid("7", "A", "F", 2.0), makeBid("A07", "T", "F", 1.0)};
+
+    BidDiffResult merged = diffBids(before, after);
+    REQUIRE(merged.usedMergeJoin);
+
+    before.insert(before.begin(), makeBid("9", "N", "F", 1.0));  // unsorted now
+    after.insert(after.begin(), makeBid("9", "N", "F", 1.0));
+    BidDiffResult hashed = diffBids(before, after, 2);
+    REQUIRE_FALSE(hashed.usedMergeJoin);
+
+    for (const auto& d : {merged, hashed}) {
+        REQUIRE(ids(d.removed) == vector<string>{"A7"});   // text IDs still compare as text
+        REQUIRE(ids(d.added) == vector<string>{"A07"});
+        REQUIRE(d.changed.size() == 1);
+        REQUIRE(d.changed[0].before.bidId == "007");
+        REQUIRE(d.changed[0].after.bidId == "7");
+        REQUIRE(d.changed[0].fields == BidChange::AMOUNT);
+    }
+}
@@ -0,0 +1,99 @@
+//============================================================================
+// Unit Tests for BidJoin
+//
+// Tests the key join with and without radix partitioning, duplicate keys,
+// and merged CSV output from two differently laid out files.
+//============================================================================
+
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "BidJoin.hpp"
+#include "MappedCsv.hpp"
+
+using namespace std;
+namespace fs = std::filesystem;
+
+static string writeTempCsv(const string& name, const string& content) {
+    fs::path p = fs::temp_directory_path() / ("bidjoin_test_" + name + ".csv");
+    ofstream(p, ios::binary) << content;
+    return p.string();
+}
+
+static vector<pair<uint32_t, uint32_t>> asPairs(const vector<JoinPair>& joined) {
+    vector<pair<uint32_t, uint32_t>> out;
+    for (const auto& p : joined) out.emplace_back(p.left, p.right);
+    return out;
+}
+
+TEST_CASE("Join matches equal keys, including duplicates", "[bidjoin]") {
+    vector<string_view> left = {"1", "2", "3", "2"};
+    vector<string_view> right = {"2", "4", "1", "1", "5", "6"};
+
+    JoinStats stats;
+    auto joined = asPairs(hashJoinKeys(left, right, &stats));
+    REQUIRE(stats.builtOnLeft);          // left is smaller
+    REQUIRE(stats.partitions == 1);
+    REQUIRE(joined == vector<pair<uint32_t, uint32_t>>{{0, 2}, {0, 3}, {1, 0}, {3, 0}});
+
+    // Building on the right gives the same answer
+    JoinStats swapped;
+    auto reversed = asPairs(hashJoinKeys(right, left, &swapped));
+    REQUIRE_FALSE(swapped.builtOnLeft);
+    REQUIRE(reversed == vector<pair<uint32_t, uint32_t>>{{0, 1}, {0, 3}, {2, 0}, {3, 0}});
+}
+
+TEST_CASE("Partitioned join gives the same pairs as the unpartitioned one", "[bidjoin]") {
+    vector<string> leftKeys, rightKeys;
+    for (int i = 0; i < 20000; i++) leftKeys.push_back(to_string(i * 3));
+    for (int i = 0; i < 30000; i++) rightKeys.push_back(to_string(i * 2));
+    vector<string_view> left(leftKeys.begin(), leftKeys.end());
+    vector<string_view> right(rightKeys.begin(), rightKeys.end());
+
+    JoinStats whole, small, tiny;
+    auto expected = hashJoinKeys(left, right, &whole, SIZE_MAX);
+    auto onePass = hashJoinKeys(left, right, &small, 16 * 1024);  // < 2^8 partitions
+    auto twoPass = hashJoinKeys(left, right, &tiny, 256);         // needs a second pass
+
+    REQUIRE(whole.partitions == 1);
+    REQUIRE(small.partitions > 1);
+    REQUIRE(small.partitions <= 256);
+    REQUIRE(tiny.partitions > 256);
+    REQUIRE(expected.size() == 10000);   // multiples of 6 below 60000
+    REQUIRE(asPairs(onePass) == asPairs(expected));
+    REQUIRE(asPairs(twoPass) == asPairs(expected));
+}
+
+TEST_CASE("CSV join merges columns from both layouts", "[bidjoin]") {
+    string mainCsv = writeTempCsv("main",
+        "Auction Title ,Auction ID,Fund\n"
+        "\"Desk, oak\",101,General Fund\n"
+        "Chair,102,Enterprise\n"
+        "Lamp,103,General Fund\n");
+    string decCsv = writeTempCsv("dec",
+        "ArticleID,InventoryID,ReceiptNumber \n"
+        "103 ,\"109973, 109977\",3690961483\n"
+        "101,109887,Cashiers Check\n"
+        "999,1,2\n");
+    MappedFile left(mainCsv), right(decCsv);
+
+    stringstream out;
+    CsvJoinResult r = joinCsvFiles(left, 1, right, 0, out);
+    REQUIRE(r.leftRows == 3);
+    REQUIRE(r.rightRows == 3);
+    REQUIRE(r.joinedRows == 2);
+    REQUIRE(out.str() ==
+        "Auction Title ,Auction ID,Fund,InventoryID,ReceiptNumber \n"
+        "\"Desk, oak\",101,General Fund,109887,Cashiers Check\n"
+        "Lamp,103,General Fund,\"109973, 109977\",3690961483\n");
+
+    REQUIRE_THROWS_AS(joinCsvFiles(left, 7, right, 0, out), runtime_error);
+    fs::remove(mainCsv);
+    fs::remove(decCsv);
+}
@@ -0,0 +1,339 @@
+//============================================================================
+// Unit Tests for BidLog
+//
+// Tests record round-trips, replay order, torn-tail recovery, that group
+// commit batches several edits into one fsync, that a LOAD record carries
+// the CSV's fingerprint, and checkpoint + tail replay, including trims
+// made while other threads keep logging.
+//============================================================================
+
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BidCheckpoint.hpp"
+#include "BidCodec.hpp"
+#include "BidLog.hpp"
+
+using namespace std;
+namespace fs = std::filesystem;
+
+// Fresh log path per test so runs don't see each other's records
+static string tempLogPath(const string& name) {
+    fs::path p = fs::temp_directory_path() / ("bidlog_test_" + name + ".log");
+    fs::remove(p);
+    return p.string();
+}
+
+static Bid makeBid(const string& id, const string& title, double amount) {
+    Bid b;
+    b.bidId = id;
+    b.title = title;
+    b.fund = "General Fund";
+    b.amount = amount;
+    return b;
+}
+
+static vector<LogRecord> replayAll(const string& path) {
+    vector<LogRecord> records;
+    BidLog log(path);
+    log.Replay([&](const LogRecord& r) { records.push_back(r); });
+    return records;
+}
+
+TEST_CASE("CRC-32 matches the standard check value", "[bidlog]") {
+    // "123456789" is the reference input for every CRC-32 implementation
+    REQUIRE(crc32Update("123456789", 9) == 0xCBF43926u);
+}
+
+static void writeFile(const string& path, const string& text) {
+    ofstream(path, ios::binary) << text;
+}
+
+TEST_CASE("Log replays records in order with all fields", "[bidlog]") {
+    string path = tempLogPath("order");
+    string csv = tempLogPath("order_data");
+    writeFile(csv, "id,title\n");
+    {
+        BidLog log(path, chrono::milliseconds(0));
+        log.LogLoad(csv);
+        log.LogAppend(makeBid("100", "Desk, \"oak\"\nwith drawers", 12.5));
+        log.LogRemove("100");
+        log.Sync();
+    }
+
+    vector<LogRecord> records = replayAll(path);
+    REQUIRE(records.size() == 3);
+    REQUIRE(records[0].op == LogRecord::LOAD);
+    REQUIRE(records[0].key == fs::absolute(csv).string());
+    REQUIRE(records[1].op == LogRecord::APPEND);
+    REQUIRE(records[1].bid.title == "Desk, \"oak\"\nwith drawers");
+    REQUIRE(records[1].bid.amount == 12.5);
+    REQUIRE(records[2].op == LogRecord::REMOVE);
+    REQUIRE(records[2].key == "100");
+    REQUIRE(records[0].lsn + 2 == records[2].lsn);
+    fs::remove(path);
+    fs::remove(csv);
+}
+
+TEST_CASE("Destructor commits records nobody waited for", "[bidlog]") {
+    string path = tempLogPath("close");
+    {
+        BidLog log(path, chrono::milliseconds(1000));
+        log.LogAppend(makeBid("1", "Chair", 1.0));
+    }
+    REQUIRE(replayAll(path).size() == 1);
+    fs::remove(path);
+}
+
+TEST_CASE("Torn tail is dropped and numbering continues", "[bidlog]") {
+    string path = tempLogPath("torn");
+    {
+        BidLog log(path, chrono::milliseconds(0));
+        log.LogAppend(makeBid("1", "Chair", 1.0));
+        log.LogAppend(makeBid("2", "Table", 2.0));
+        log.Sync();
+    }
+    // Simulate a crash halfway through writing the second record
+    fs::resize_file(path, fs::file_size(path) - 5);
+
+    {
+        BidLog log(path, chrono::milliseconds(0));
+        REQUIRE(log.LastLsn() == 1);
+        log.WaitDurable(log.LogAppend(makeBid("3", "Lamp", 3.0)));
+    }
+
+    vector<LogRecord> records = replayAll(path);
+    REQUIRE(records.size() == 2);
+    REQUIRE(records[0].bid.bidId == "1");
+    REQUIRE(records[1].bid.bidId == "3");
+    REQUIRE(records[1].lsn == 2);
+    fs::remove(path);
+}
+
+TEST_CASE("Corrupted record stops replay", "[bidlog]") {
+    string path = tempLogPath("corrupt");
+    {
+        BidLog log(path, chrono::milliseconds(0));
+        log.LogAppend(makeBid("1", "Chair", 1.0));
+        log.LogAppend(makeBid("2", "Table", 2.0));
+        log.Sync();
+    }
+    // Flip one byte inside the last record's body
+    {
+        fstream f(path, ios::in | ios::out | ios::binary);
+        f.seekp(-3, ios::end);
+        f.put('X');
+    }
+    REQUIRE(replayAll(path).size() == 1);
+    fs::remove(path);
+}
+
+TEST_CASE("Group commit shares one fsync across concurrent edits", "[bidlog]") {
+    string path = tempLogPath("group");
+    const int writers = 8;
+    {
+        BidLog log(path, chrono::milliseconds(50));
+        vector<thread> threads;
+        for (int i = 0; i < writers; i++) {
+            threads.emplace_back([&log, i] {
+                log.WaitDurable(log.LogAppend(makeBid(to_string(i), "Item", i)));
+            });
+        }
+        for (auto& t : threads) t.join();
+
+        REQUIRE(log.DurableLsn() == writers);
+        REQUIRE(log.SyncCount() < writers);
+    }
+    REQUIRE(replayAll(path).size() == writers);
+    fs::remove(path);
+}
+
+TEST_CASE("Replay skips records at or before a given lsn", "[bidlog]") {
+    string path = tempLogPath("after");
+    BidLog log(path, chrono::milliseconds(0));
+    log.LogAppend(makeBid("1", "Chair", 1.0));
+    log.LogAppend(makeBid("2", "Table", 2.0));
+    log.Sync();
+
+    vector<string> ids;
+    log.Replay([&](const LogRecord& r) { ids.push_back(r.bid.bidId); }, 1);
+    REQUIRE(ids == vector<string>{"2"});
+    fs::remove(path);
+}
+
+TEST_CASE("A LOAD record keeps the fingerprint of the CSV it loaded", "[bidlog]") {
+    string path = tempLogPath("fingerprint");
+    string csv = tempLogPath("fingerprint_data");
+    writeFile(csv, "1,Chair\n2,Table\n");
+    {
+        BidLog log(path, chrono::milliseconds(0));
+        log.LogLoad(csv, 5, 42);
+        REQUIRE_THROWS_AS(log.LogLoad(csv + ".missing"), BidLogError);
+    }
+
+    vector<LogRecord> records = replayAll(path);
+    REQUIRE(records.size() == 1);
+    REQUIRE(records[0].sampleSize == 5);
+    REQUIRE(records[0].sampleSeed == 42);
+    REQUIRE(records[0].hasFingerprint);
+    REQUIRE(records[0].fileSize == 16);
+
+    uint64_t size;
+    uint32_t crc;
+    REQUIRE(BidLog::Fingerprint(csv, size, crc));
+    REQUIRE(size == records[0].fileSize);
+    REQUIRE(crc == records[0].fileCrc);
+
+    writeFile(csv, "1,Chair\n2,Tabel\n");   // same size, different bytes
+    REQUIRE(BidLog::Fingerprint(csv, size, crc));
+    REQUIRE(size == records[0].fileSize);
+    REQUIRE(crc != records[0].fileCrc);
+    fs::remove(csv);
+    REQUIRE_FALSE(BidLog::Fingerprint(csv, size, crc));
+    fs::remove(path);
+}
+
+//============================================================================
+// CHECKPOINT TESTS
+//============================================================================
+
+TEST_CASE("Checkpoint round-trips bids and lsn", "[checkpoint]") {
+    string path = tempLogPath("ckpt_roundtrip");
+    vector<Bid> bids = {makeBid("1", "Chair", 1.0), makeBid("2", "Table, round", 2.25)};
+    BidCheckpoint::Write(path, 42, bids);
+
+    uint64_t lsn = 0;
+    vector<Bid> loaded;
+    REQUIRE(BidCheckpoint::Read(path, lsn, [&](const Bid& b) { loaded.push_back(b); }));
+    REQUIRE(lsn == 42);
+    REQUIRE(loaded.size() == 2);
+    REQUIRE(loaded[1].title == "Table, round");
+    REQUIRE(loaded[1].amount == 2.25);
+    fs::remove(path);
+}
+
+TEST_CASE("Missing checkpoint is not an error, damaged one is", "[checkpoint]") {
+    string path = tempLogPath("ckpt_damaged");
+    uint64_t lsn = 0;
+    auto ignore = [](const Bid&) {};
+    REQUIRE(BidCheckpoint::Read(path, lsn, ignore) == false);
+
+    BidCheckpoint::Write(path, 7, {makeBid("1", "Chair", 1.0)});
+    {
+        fstream f(path, ios::in | ios::out | ios::binary);
+        f.seekp(30);
+        f.put('X');
+    }
+    REQUIRE_THROWS_AS(BidCheckpoint::Read(path, lsn, ignore), BidLogError);
+    fs::remove(path);
+}
+
+TEST_CASE("Checkpointer trims the log but keeps newer records", "[checkpoint]") {
+    string logPath = tempLogPath("ckpt_trim");
+    string ckptPath = logPath + ".ckpt";
+    fs::remove(ckptPath);
+
+    BidLog log(logPath, chrono::milliseconds(0));
+    log.LogAppend(makeBid("1", "Chair", 1.0));
+    uint64_t covered = log.LogAppend(makeBid("2", "Table", 2.0));
+    log.Sync();
+    {
+        Checkpointer checkpointer(log, ckptPath);
+        checkpointer.Submit(covered, {makeBid("1", "Chair", 1.0), makeBid("2", "Table", 2.0)});
+
+        // An edit made while the checkpoint is being written must survive
+        log.WaitDurable(log.LogRemove("1"));
+        checkpointer.Wait();
+        REQUIRE(checkpointer.LastError().empty());
+        REQUIRE(checkpointer.LastLsn() == covered);
+    }
+
+    uint64_t lsn = 0;
+    size_t restored = 0;
+    BidCheckpoint::Read(ckptPath, lsn, [&](const Bid&) { restored++; });
+    vector<LogRecord> tail;
+    log.Replay([&](const LogRecord& r) { tail.push_back(r); }, lsn);
+
+    REQUIRE(restored == 2);
+    REQUIRE(tail.size() == 1);
+    REQUIRE(tail[0].op == LogRecord::REMOVE);
+
+    // New records still append after the rewrite
+    log.WaitDurable(log.LogAppend(makeBid("3", "Lamp", 3.0)));
+    size_t all = log.Replay([](const LogRecord&) {});
+    REQUIRE(all == 2);
+    fs::remove(logPath);
+    fs::remove(ckptPath);
+}
+
+TEST_CASE("Truncating while writers append keeps every newer record", "[checkpoint]") {
+    string path = tempLogPath("trim_live");
+    BidLog log(path, chrono::milliseconds(1));
+    const int edits = 400;
+    thread writer([&] {
+        for (int i = 0; i < edits; i++) {
+            log.WaitDurable(log.LogAppend(makeBid(to_string(i), "Item", i)));
+        }
+    });
+    uint64_t trimmed = 0;
+    for (int k = 0; k < 40; k++) {
+        trimmed = log.DurableLsn();
+        log.TruncateThrough(trimmed);
+        this_thread::sleep_for(chrono::milliseconds(1));
+    }
+    writer.join();
+
+    // What is left is exactly the records after the last trim, in order
+    vector<uint64_t> lsns;
+    log.Replay([&](const LogRecord& r) { lsns.push_back(r.lsn); });
+    REQUIRE(lsns.size() == edits - trimmed);
+    for (size_t i = 0; i < lsns.size(); i++) {
+        REQUIRE(lsns[i] == trimmed + 1 + i);
+    }
+    fs::remove(path);
+}
+
+TEST_CASE("Records logged after a checkpoint emptied the log survive restarts", "[checkpoint]") {
+    string logPath = tempLogPath("ckpt_restart");
+    string ckptPath = logPath + ".ckpt";
+    fs::remove(ckptPath);
+
+    // What recoverList does on startup: the checkpoint, then the log after it
+    auto restart = [&](BidLog& log) {
+        vector<string> ids;
+        uint64_t lsn = 0;
+        BidCheckpoint::Read(ckptPath, lsn, [&](const Bid& b) { ids.push_back(b.bidId); });
+        log.ContinueAfter(lsn);
+        log.Replay([&](const LogRecord& r) { ids.push_back(r.bid.bidId); }, lsn);
+        return ids;
+    };
+
+    {
+        BidLog log(logPath, chrono::milliseconds(0));
+        log.LogAppend(makeBid("1", "Chair", 1.0));
+        uint64_t covered = log.LogAppend(makeBid("2", "Table", 2.0));
+        log.Sync();
+        Checkpointer checkpointer(log, ckptPath);
+        checkpointer.Submit(covered, {makeBid("1", "Chair", 1.0), makeBid("2", "Table", 2.0)});
+        checkpointer.Wait();
+        REQUIRE(checkpointer.LastError().empty());
+    }
+    REQUIRE(fs::file_size(logPath) == 0);
+
+    {
+        BidLog log(logPath, chrono::milliseconds(0));
+        REQUIRE(restart(log) == vector<string>{"1", "2"});
+        REQUIRE(log.LogAppend(makeBid("ZZZ1", "Lamp", 3.0)) == 3);
+        log.Sync();
+    }
+    {
+        BidLog log(logPath, chrono::milliseconds(0));
+        REQUIRE(restart(log) == vector<string>{"1", "2", "ZZZ1"});
+    }
+    fs::remove(logPath);
+    fs::remove(ckptPath);
+}
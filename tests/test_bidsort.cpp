@@ -0,0 +1,80 @@
+//============================================================================
+// Unit Tests for BidSort
+//
+// Tests that the radix sort gives exactly what a stable comparison sort
+// gives, on one thread and several, and that amount keys keep amount order.
+//============================================================================
+
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "BidSort.hpp"
+
+using namespace std;
+
+// Entries numbered in their original order, so stability can be checked
+static vector<BidSortEntry> numbered(const vector<uint64_t>& keys) {
+    vector<BidSortEntry> entries;
+    for (size_t i = 0; i < keys.size(); i++) {
+        entries.push_back({keys[i], reinterpret_cast<void*>(i)});
+    }
+    return entries;
+}
+
+static vector<BidSortEntry> stableSorted(vector<BidSortEntry> entries) {
+    stable_sort(entries.begin(), entries.end(),
+                [](const BidSortEntry& a, const BidSortEntry& b) { return a.key < b.key; });
+    return entries;
+}
+
+static bool sameOrder(const vector<BidSortEntry>& a, const vector<BidSortEntry>& b) {
+    return equal(a.begin(), a.end(), b.begin(), b.end(), [](const BidSortEntry& x, const BidSortEntry& y) {
+        return x.key == y.key && x.item == y.item;
+    });
+}
+
+TEST_CASE("Radix sort matches a stable sort", "[bidsort]") {
+    mt19937_64 rng(7);
+    vector<uint64_t> keys(300000);
+    for (uint64_t& k : keys) k = rng() % 5000;                    // many repeats, two varying bytes
+    keys[123] = ~uint64_t(0);                                     // and one key using every byte
+
+    vector<BidSortEntry> expected = stableSorted(numbered(keys));
+    for (unsigned threads : {1u, 2u, 3u, 4u, 0u}) {
+        INFO(threads << " threads");
+        vector<BidSortEntry> entries = numbered(keys);
+        radixSort(entries, threads);
+        REQUIRE(sameOrder(entries, expected));
+    }
+}
+
+TEST_CASE("Radix sort handles tiny and uniform inputs", "[bidsort]") {
+    vector<BidSortEntry> empty;
+    radixSort(empty);
+    REQUIRE(empty.empty());
+
+    vector<BidSortEntry> one = numbered({42});
+    radixSort(one);
+    REQUIRE(sameOrder(one, numbered({42})));
+
+    vector<BidSortEntry> same = numbered(vector<uint64_t>(1000, 9));   // no byte varies: no pass
+    radixSort(same, 4);
+    REQUIRE(sameOrder(same, numbered(vector<uint64_t>(1000, 9))));
+
+    vector<BidSortEntry> three = numbered({300, 2, 300});
+    radixSort(three);
+    REQUIRE(sameOrder(three, stableSorted(numbered({300, 2, 300}))));
+}
+
+TEST_CASE("Amount keys sort like the amounts", "[bidsort]") {
+    vector<double> amounts = {-1e300, -12.5, -0.01, 0.0, 0.01, 9.99, 10.0, 1234567.89, 1e300};
+    for (size_t i = 1; i < amounts.size(); i++) {
+        INFO(amounts[i - 1] << " < " << amounts[i]);
+        REQUIRE(amountSortKey(amounts[i - 1]) < amountSortKey(amounts[i]));
+    }
+    REQUIRE(amountSortKey(32.001) == amountSortKey(32.0));   // whole cents
+    REQUIRE(amountSortKey(0.004) == amountSortKey(0.0));
+    REQUIRE(amountSortKey(-0.0) == amountSortKey(0.0));
+}
@@ -0,0 +1,143 @@
+//============================================================================
+// Unit Tests for BidCompressedStore
+//
+// Tests that every field comes back exactly as stored (text IDs, leading
+// zeros, odd amounts and escaped title bytes included), that ID order and
+// equal-ID rules match the skip list, that fund queries and range scans
+// agree with a plain walk, and that the store is several times smaller
+// than the same bids as Bid objects.
+//============================================================================
+
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <vector>
+
+#include "BidCompressed.hpp"
+#include "BidSkipList.hpp"
+#include "TestBids.hpp"
+
+using namespace std;
+
+static bool sameBid(const Bid& a, const Bid& b) {
+    return a.bidId == b.bidId && a.Title() == b.Title() && a.fund == b.fund && a.amount == b.amount;
+}
+
+TEST_CASE("Compressed store gives back every field exactly", "[compressed]") {
+    vector<Bid> bids = {
+        makeBid("98001", "General Fund", 1234.56),
+        makeBid("98002", "Enterprise", 0.0),
+        makeBid("0042", "General Fund", 10.0),              // leading zeros stay
+        makeBid("18446744073709551615", "General Fund", 3),  // largest 64-bit number
+        makeBid("AB-7", "Trust \xe2\x82\xac", -12.5),       // text ID, UTF-8 fund
+        makeBid("98003", "General Fund", 0.1 + 0.2),          // not whole cents
+        makeBid("98004", "", 1e300),
+    };
+    bids[1].title = "";
+    bids[4].title = string("Odd \x01\xff bytes \0 in a title", 26);
+
+    BidCompressedStore store;
+    for (const Bid& b : bids) {
+        store.Append(b);
+    }
+    REQUIRE(store.Size() == static_cast<int>(bids.size()));
+    for (const Bid& b : bids) {
+        REQUIRE(sameBid(store.Search(b.bidId), b));
+    }
+    REQUIRE(store.Search("42").bidId.empty());   // sorts with "0042" but isn't it
+    REQUIRE(store.Search("98005").bidId.empty());
+
+    int seen = 0;
+    store.ForEach([&](const Bid& got) {
+        for (const Bid& b : bids) {
+            if (b.bidId == got.bidId) {
+                REQUIRE(sameBid(got, b));
+                seen++;
+            }
+        }
+    });
+    REQUIRE(seen == static_cast<int>(bids.size()));
+}
+
+TEST_CASE("Compressed store keeps the skip list's order", "[compressed]") {
+    BidCompressedStore store;
+    BidSkipList expected;
+    uint64_t x = 12345;
+    for (int i = 0; i < 3000; i++) {
+        x = x * 6364136223846793005ull + 1442695040888963407ull;
+        string id = (x >> 60) == 0 ? "X" + to_string(x % 500) : to_string(x % 5000);
+        Bid b = makeBid(id, "F" + to_string(i));
+        if (i % 7 == 0) {
+            store.Prepend(b);
+            expected.Prepend(b);
+        } else {
+            store.Append(b);
+            expected.Append(b);
+        }
+        if (i % 500 == 0) {
+            REQUIRE(store.Search(id).fund == expected.Search(id).fund);   // merge part way
+        }
+    }
+
+    vector<string> funds, expectedFunds;
+    store.ForEach([&](const Bid& b) { funds.push_back(b.fund); });
+    expected.ForEach([&](const Bid& b) { expectedFunds.push_back(b.fund); });
+    REQUIRE(funds == expectedFunds);   // funds are unique, so this checks equal IDs too
+
+    for (int i = 0; i < 5000; i += 3) {
+        const string id = to_string(i);
+        REQUIRE(store.Remove(id) == expected.Remove(id));
+    }
+    REQUIRE(idsOf(store) == idsOf(expected));
+    REQUIRE(store.Size() == expected.Size());
+}
+
+TEST_CASE("Compressed store answers fund, range and parallel queries", "[compressed]") {
+    BidCompressedStore store;
+    for (int i = 0; i < 2000; i++) {
+        store.Append(makeBid(to_string(i * 2), "F" + to_string(i % 5), i * 0.25));
+    }
+
+    int inFund = 0;
+    store.ForEachInFund("F3", [&](const Bid& b) {
+        REQUIRE(b.fund == "F3");
+        REQUIRE(b.title == "Bid " + b.bidId);
+        inFund++;
+    });
+    REQUIRE(inFund == 400);
+    REQUIRE(store.FundSize("F3") == 400);
+    REQUIRE(store.FundSize("nope") == 0);
+
+    vector<string> range;
+    store.ForEachInRange("101", "140", [&](const Bid& b) { range.push_back(b.bidId); });
+    REQUIRE(range.size() == 20);
+    REQUIRE(range.front() == "102");
+    REQUIRE(range.back() == "140");
+
+    BidTotals totals = store.TotalsParallel(nullptr, 4);
+    REQUIRE(totals.count == 2000);
+    REQUIRE(totals.total == 0.25 * 1999 * 2000 / 2);
+    REQUIRE(store.FilterParallel([](const Bid& b) { return b.fund == "F1"; }, 4).size() == 400);
+}
+
+TEST_CASE("Compressed store is several times smaller than Bid objects", "[compressed]") {
+    const vector<string> words = {"Dell", "Laptop", "Server", "Office", "Chair", "Desk", "Lenovo",
+                                  "Monitor", "Printer", "Toner", "Cabinet", "Projector"};
+    BidCompressedStore store;
+    uint64_t x = 7;
+    for (int i = 0; i < 20000; i++) {
+        x = x * 6364136223846793005ull + 1442695040888963407ull;
+        Bid b = makeBid(to_string(80000 + i), (x >> 62) ? "General Fund" : "Enterprise",
+                        static_cast<double>((x >> 20) % 500000) / 100.0);
+        b.title = words[(x >> 30) % words.size()] + " " + words[(x >> 40) % words.size()] + " " +
+                  to_string((x >> 50) % 100);
+        store.Append(b);
+    }
+
+    CompressedStats stats = store.Stats();
+    REQUIRE(stats.bids == 20000);
+    REQUIRE(stats.blocks == (20000 + BidCompressedStore::kBlockBids - 1) / BidCompressedStore::kBlockBids);
+    REQUIRE(stats.symbols > 0);
+    REQUIRE(stats.funds == 2);
+    REQUIRE(stats.bytes * 4 < stats.plainBytes);
+    REQUIRE(store.Search("95000").title.find(' ') != string::npos);
+}
@@ -0,0 +1,152 @@
+//============================================================================
+// Unit Tests for FrozenBids
+//
+// Tests perfect-hash lookups (hits, misses, repeated IDs, batches), and
+// that the Eytzinger range queries return exactly what BidStore's
+// scan-and-sort fallback returns for the same bids.
+//============================================================================
+
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <vector>
+
+#include "BidSkipList.hpp"
+#include "FrozenBids.hpp"
+#include "TestBids.hpp"
+
+using namespace std;
+
+// A plain vector-backed store: BidStore's default range queries run on it
+class VectorStore : public BidStore {
+public:
+    vector<Bid> bids;
+    void Append(const Bid& bid) override { bids.push_back(bid); }
+    void Prepend(const Bid& bid) override { bids.insert(bids.begin(), bid); }
+    bool Remove(const string&) override { return false; }
+    Bid Search(const string&) const override { return Bid{}; }
+    int Size() const override { return static_cast<int>(bids.size()); }
+    void ForEach(const function<void(const Bid&)>& visit) const override {
+        for (const Bid& b : bids) visit(b);
+    }
+};
+
+static vector<string> idRange(const FrozenBids& frozen, const string& first, const string& last) {
+    vector<string> ids;
+    frozen.ForEachInRange(first, last, [&](const Bid& b) { ids.push_back(b.bidId + "/" + b.fund); });
+    return ids;
+}
+
+static vector<string> idRange(const BidStore& store, const string& first, const string& last) {
+    vector<string> ids;
+    store.ForEachInRange(first, last, [&](const Bid& b) { ids.push_back(b.bidId + "/" + b.fund); });
+    return ids;
+}
+
+static vector<string> amountRange(const FrozenBids& frozen, double low, double high) {
+    vector<string> ids;
+    frozen.ForEachInAmountRange(low, high, [&](const Bid& b) { ids.push_back(b.bidId + "/" + b.fund); });
+    return ids;
+}
+
+static vector<string> amountRange(const BidStore& store, double low, double high) {
+    vector<string> ids;
+    store.ForEachInAmountRange(low, high, [&](const Bid& b) { ids.push_back(b.bidId + "/" + b.fund); });
+    return ids;
+}
+
+TEST_CASE("Frozen bids find every ID through the perfect hash", "[frozen]") {
+    vector<Bid> bids;
+    for (int i = 0; i < 20000; i++) bids.push_back(makeBid(to_string(i * 13 % 20000), "General Fund", i));
+    bids.push_back(makeBid("A-17", "General Fund", 1.0));
+    bids.push_back(makeBid("007", "General Fund", 2.0));
+    FrozenBids frozen(bids);
+
+    REQUIRE(frozen.Size() == bids.size());
+    for (const Bid& b : bids) {
+        const Bid* found = frozen.Find(b.bidId);
+        REQUIRE(found != nullptr);
+        REQUIRE(found->bidId == b.bidId);
+    }
+    REQUIRE(frozen.Find("20000") == nullptr);
+    REQUIRE(frozen.Find("B-17") == nullptr);
+    REQUIRE(frozen.Find("") == nullptr);
+    REQUIRE(frozen.Find("7")->amount == 1539.0);   // 1539 * 13 % 20000 == 7
+}
+
+TEST_CASE("Frozen bids resolve repeated IDs to the first one", "[frozen]") {
+    FrozenBids frozen({makeBid("5", "A", 1), makeBid("6", "General Fund", 2), makeBid("5", "B", 3)});
+    REQUIRE(frozen.Find("5")->fund == "A");
+    REQUIRE(idRange(frozen, "5", "5") == vector<string>{"5/A", "5/B"});
+}
+
+TEST_CASE("Frozen bids handle empty and single-bid lists", "[frozen]") {
+    FrozenBids empty({});
+    REQUIRE(empty.Find("1") == nullptr);
+    REQUIRE(idRange(empty, "0", "9").empty());
+    REQUIRE(amountRange(empty, 0, 100).empty());
+
+    FrozenBids one({makeBid("1", "General Fund", 10)});
+    REQUIRE(one.Find("1") != nullptr);
+    REQUIRE(idRange(one, "2", "9").empty());
+    REQUIRE(amountRange(one, 10, 10) == vector<string>{"1/General Fund"});
+}
+
+TEST_CASE("Frozen range queries match the scan-and-sort fallback", "[frozen]") {
+    VectorStore store;
+    for (int i = 0; i < 3000; i++) {
+        string id = (i % 10 == 0) ? "T" + to_string(i) : to_string(i * 31 % 2500);
+        store.Append(makeBid(id, i % 3 == 0 ? "A" : "B", (i * 37) % 500 + 0.25));
+    }
+    store.Append(makeBid("0042", "C", 7.25));
+    FrozenBids frozen(store.bids);
+
+    for (auto [first, last] : vector<pair<string, string>>{
+             {"0", "99"}, {"42", "42"}, {"100", "2499"}, {"2400", "T5"}, {"T1000", "Z"},
+             {"3000", "3001"}, {"500", "400"}}) {
+        INFO(first << ".." << last);
+        REQUIRE(idRange(frozen, first, last) == idRange(store, first, last));
+    }
+    for (auto [low, high] : vector<pair<double, double>>{
+             {0, 1}, {7.25, 7.25}, {100, 250.5}, {499.25, 1e9}, {-5, -1}, {600, 700}}) {
+        INFO(low << ".." << high);
+        REQUIRE(amountRange(frozen, low, high) == amountRange(store, low, high));
+    }
+    REQUIRE(idRange(frozen, "0", "Z").size() == store.bids.size());
+}
+
+TEST_CASE("Skip list amount ranges use the BidStore fallback", "[frozen]") {
+    BidSkipList list;
+    list.Append(makeBid("3", "General Fund", 30));
+    list.Append(makeBid("1", "General Fund", 10));
+    list.Append(makeBid("2", "General Fund", 10));
+    REQUIRE(amountRange(list, 10, 20) == vector<string>{"1/General Fund", "2/General Fund"});
+}
+
+TEST_CASE("Frozen batch lookups match one-at-a-time Find", "[frozen]") {
+    vector<Bid> bids;
+    for (int i = 0; i < 5000; i++) bids.push_back(makeBid(to_string(i * 3), "General Fund", i));
+    bids.push_back(makeBid("a-very-long-id-that-does-not-fit-inline", "General Fund", 1));
+    FrozenBids frozen(bids);
+
+    vector<string> ids;
+    for (int i = 0; i < 2000; i++) ids.push_back(to_string(i * 7));   // two in three are missing
+    ids.push_back("a-very-long-id-that-does-not-fit-inline");
+    ids.push_back("a-very-long-id-that-does-not-fit-inline!");
+    ids.push_back("");
+
+    for (size_t width : {size_t(1), size_t(3), FrozenBids::kBatchWidth, size_t(1000)}) {
+        INFO("width " << width);
+        vector<const Bid*> out;
+        frozen.FindBatch(ids, out, width);
+        REQUIRE(out.size() == ids.size());
+        for (size_t i = 0; i < ids.size(); i++) {
+            REQUIRE(out[i] == frozen.Find(ids[i]));
+        }
+    }
+
+    vector<const Bid*> out{nullptr};
+    frozen.FindBatch({}, out);
+    REQUIRE(out.empty());
+    FrozenBids({}).FindBatch({"1", "2"}, out);
+    REQUIRE(out == vector<const Bid*>{nullptr, nullptr});
+}
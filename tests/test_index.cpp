@@ -0,0 +1,196 @@
+//============================================================================
+// Unit Tests for BidIndex
+//
+// Tests insert/replace/erase, long IDs, growing and cleaning up through
+// incremental resizes, and readers that must never miss an ID while
+// writers add, erase and resize around them.
+//============================================================================
+
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BidIndex.hpp"
+
+using namespace std;
+
+TEST_CASE("Index adds, replaces and erases IDs", "[index]") {
+    BidIdIndex index;
+    uint64_t value = 0;
+
+    REQUIRE(index.Insert("81517", 1));
+    REQUIRE_FALSE(index.Insert("81517", 2));   // replaced, not added
+    REQUIRE(index.Find("81517", value));
+    REQUIRE(value == 2);
+    REQUIRE(index.Size() == 1);
+
+    REQUIRE_FALSE(index.Find("8151", value));
+    REQUIRE_FALSE(index.Find("815170", value));
+    REQUIRE_FALSE(index.Find("", value));
+
+    REQUIRE(index.Erase("81517"));
+    REQUIRE_FALSE(index.Erase("81517"));
+    REQUIRE_FALSE(index.Find("81517", value));
+    REQUIRE(index.Size() == 0);
+
+    REQUIRE(index.Insert("81517", 3));         // reuses the erased slot
+    REQUIRE(index.Find("81517", value));
+    REQUIRE(value == 3);
+}
+
+TEST_CASE("Index keeps IDs longer than a slot", "[index]") {
+    BidIdIndex index;
+    const string exact(BidIdIndex::kInlineKey, 'x');
+    const string longer = exact + "y";
+    const string other = exact + "z";
+    uint64_t value = 0;
+
+    REQUIRE(index.Insert(exact, 16));
+    REQUIRE(index.Insert(longer, 17));
+    REQUIRE(index.Insert(other, 18));
+    REQUIRE(index.Find(exact, value));
+    REQUIRE(value == 16);
+    REQUIRE(index.Find(longer, value));
+    REQUIRE(value == 17);
+    REQUIRE(index.Find(other, value));
+    REQUIRE(value == 18);
+
+    REQUIRE(index.Erase(longer));
+    REQUIRE_FALSE(index.Find(longer, value));
+    REQUIRE(index.Find(other, value));
+}
+
+TEST_CASE("Index grows and cleans up through resizes", "[index]") {
+    BidIdIndex index;
+    const size_t first = index.Capacity();
+    for (uint64_t i = 0; i < 20000; i++) {
+        REQUIRE(index.Insert(to_string(i), i * 10));
+    }
+    REQUIRE(index.Size() == 20000);
+    REQUIRE(index.Capacity() > first);
+    for (uint64_t i = 0; i < 20000; i++) {
+        uint64_t value = 0;
+        REQUIRE(index.Find(to_string(i), value));
+        REQUIRE(value == i * 10);
+    }
+
+    // Erasing leaves erased slots behind; churning through new IDs has to
+    // clear them out rather than run the table full
+    for (uint64_t i = 0; i < 19900; i++) {
+        REQUIRE(index.Erase(to_string(i)));
+    }
+    for (uint64_t i = 0; i < 200000; i++) {
+        index.Insert("churn" + to_string(i), i);
+        index.Erase("churn" + to_string(i));
+    }
+    REQUIRE(index.Size() == 100);
+    REQUIRE(index.Capacity() <= 20000 * 4);
+    uint64_t value = 0;
+    REQUIRE(index.Find("19950", value));
+    REQUIRE(value == 199500);
+    REQUIRE_FALSE(index.Find("100", value));
+}
+
+TEST_CASE("Index readers never miss an ID while writers resize", "[index]") {
+    BidIdIndex index;
+    for (uint64_t i = 0; i < 500; i++) index.Insert("keep" + to_string(i), i);
+
+    atomic<bool> done{false};
+    atomic<int> missed{0};
+    atomic<int> wrong{0};
+    vector<thread> readers;
+    for (int r = 0; r < 4; r++) {
+        readers.emplace_back([&, r] {
+            uint64_t i = r;
+            while (!done.load()) {
+                uint64_t value = 0;
+                if (!index.Find("keep" + to_string(i % 500), value)) missed++;
+                else if (value != i % 500) wrong++;
+                i += 7;
+            }
+        });
+    }
+
+    // Two writers on disjoint IDs; 40000 new IDs force several resizes
+    vector<thread> writers;
+    for (int w = 0; w < 2; w++) {
+        writers.emplace_back([&index, w] {
+            for (uint64_t i = 0; i < 20000; i++) {
+                string id = "w" + to_string(w) + "-" + to_string(i);
+                index.Insert(id, i);
+                if (i % 4 == 0) index.Erase(id);
+            }
+        });
+    }
+    for (thread& t : writers) t.join();
+    done = true;
+    for (thread& t : readers) t.join();
+
+    REQUIRE(missed == 0);
+    REQUIRE(wrong == 0);
+    REQUIRE(index.Size() == 500 + 2 * 15000);
+    uint64_t value = 0;
+    REQUIRE(index.Find("w1-19999", value));
+    REQUIRE(value == 19999);
+    REQUIRE_FALSE(index.Find("w0-4", value));
+}
+
+#ifdef BID_INDEX_TESTING
+TEST_CASE("A lookup racing the end of a resize still finds the ID", "[index]") {
+    BidIdIndex index;
+    REQUIRE(index.Insert("keep", 7));
+    uint64_t churn = 0;
+    auto step = [&] {
+        const string id = "c" + to_string(churn++);
+        index.Insert(id, 0);
+        index.Erase(id);
+    };
+    while (!index.Resizing()) step();
+
+    // The writer stops as it ends the resize, right after the epoch moved.
+    // The reader starts then, and lets the writer finish between loading
+    // one table pointer and the other.
+    mutex m;
+    condition_variable cv;
+    int stage = 0;
+    auto advance = [&](int s) {
+        { lock_guard<mutex> lock(m); stage = s; }
+        cv.notify_all();
+    };
+    auto waitFor = [&](int s) {
+        unique_lock<mutex> lock(m);
+        cv.wait(lock, [&] { return stage >= s; });
+    };
+    BidIdIndex::testHook = [&](const char* point) {
+        const string p = point;
+        if (p == "resize:finishing") {
+            advance(1);
+            waitFor(2);
+        } else if (p == "find:tables") {
+            bool first;
+            { lock_guard<mutex> lock(m); first = stage == 1; }
+            if (first) {
+                advance(2);
+                waitFor(3);
+            }
+        }
+    };
+
+    thread writer([&] {
+        while (index.Resizing()) step();
+        advance(3);
+    });
+    waitFor(1);
+    uint64_t value = 0;
+    const bool found = index.Find("keep", value);
+    writer.join();
+    BidIdIndex::testHook = nullptr;
+
+    REQUIRE(found);
+    REQUIRE(value == 7);
+}
+#endif
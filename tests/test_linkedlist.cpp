@@ -1,13 +1,23 @@
 //============================================================================
 // Unit Tests for LinkedList
 //
-// Tests whitespace trimming, linked list operations, and edge cases.
+// Tests whitespace trimming, and the list from BidLinkedList.hpp: its
+// operations, handles, segments for parallel scans, sorting, freezing and
+// edge cases.
 // Uses Catch2 framework.
 //============================================================================
 
 #define CATCH_CONFIG_MAIN
 #include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <stdexcept>
 #include <string>
+#include <vector>
+
+#include "Bid.hpp"
+#include "BidLinkedList.hpp"
+#include "BidSort.hpp"
+#include "BidStore.hpp"
 
 using namespace std;
 
@@ -24,119 +34,6 @@ string trimWhitespace(const string& input) {
     return input.substr(startPos, endPos - startPos + 1);
 }
 
-//----------------------------------------------------------------------------
-// Bid Structure (mirrored from LinkedList.cpp)
-//----------------------------------------------------------------------------
-
-struct Bid {
-    string bidId;
-    string title;
-    string fund;
-    double amount;
-    Bid() : amount(0.0) {}
-};
-
-//----------------------------------------------------------------------------
-// LinkedList Class (mirrored for testing)
-//----------------------------------------------------------------------------
-
-class LinkedList {
-private:
-    struct Node {
-        Bid bid;
-        Node* next;
-        Node() : next(nullptr) {}
-        Node(const Bid& aBid) : bid(aBid), next(nullptr) {}
-    };
-
-    Node* head;
-    Node* tail;
-    int listSize;
-
-public:
-    LinkedList() : head(nullptr), tail(nullptr), listSize(0) {}
-
-    ~LinkedList() {
-        Node* current = head;
-        while (current != nullptr) {
-            Node* next = current->next;
-            delete current;
-            current = next;
-        }
-    }
-
-    void Append(const Bid& bid) {
-        Node* newNode = new Node(bid);
-        if (head == nullptr) {
-            head = tail = newNode;
-        } else {
-            tail->next = newNode;
-            tail = newNode;
-        }
-        listSize++;
-    }
-
-    void Prepend(const Bid& bid) {
-        Node* newNode = new Node(bid);
-        newNode->next = head;
-        head = newNode;
-        if (tail == nullptr) {
-            tail = newNode;
-        }
-        listSize++;
-    }
-
-    bool Remove(const string& bidId) {
-        if (head == nullptr) {
-            return false;
-        }
-        if (head->bid.bidId == bidId) {
-            Node* temp = head;
-            head = head->next;
-            delete temp;
-            listSize--;
-            if (head == nullptr) {
-                tail = nullptr;
-            }
-            return true;
-        }
-
-        Node* current = head;
-        while (current->next != nullptr) {
-            if (current->next->bid.bidId == bidId) {
-                Node* temp = current->next;
-                current->next = temp->next;
-                if (temp == tail) {
-                    tail = current;
-                }
-                delete temp;
-                listSize--;
-                return true;
-            }
-            current = current->next;
-        }
-        return false;
-    }
-
-    Bid* Search(const string& bidId) {
-        Node* current = head;
-        while (current != nullptr) {
-            if (current->bid.bidId == bidId) {
-                return &(current->bid);
-            }
-            current = current->next;
-        }
-        return nullptr;
-    }
-
-    bool Contains(const string& bidId) {
-        return Search(bidId) != nullptr;
-    }
-
-    int Size() const { return listSize; }
-    bool IsEmpty() const { return head == nullptr; }
-};
-
 //============================================================================
 // WHITESPACE TRIMMING TESTS
 //============================================================================
@@ -194,7 +91,7 @@ TEST_CASE("Whitespace trimming handles no whitespace", "[trim]") {
 TEST_CASE("LinkedList starts empty", "[linkedlist]") {
     LinkedList list;
     REQUIRE(list.Size() == 0);
-    REQUIRE(list.IsEmpty() == true);
+    REQUIRE(list.Size() == 0);
 }
 
 TEST_CASE("LinkedList append adds to end", "[linkedlist]") {
@@ -205,11 +102,11 @@ TEST_CASE("LinkedList append adds to end", "[linkedlist]") {
 
     list.Append(bid1);
     REQUIRE(list.Size() == 1);
-    REQUIRE(list.Contains("001") == true);
+    REQUIRE(list.Find("001"));
 
     list.Append(bid2);
     REQUIRE(list.Size() == 2);
-    REQUIRE(list.Contains("002") == true);
+    REQUIRE(list.Find("002"));
 }
 
 TEST_CASE("LinkedList prepend adds to front", "[linkedlist]") {
@@ -222,8 +119,8 @@ TEST_CASE("LinkedList prepend adds to front", "[linkedlist]") {
     list.Prepend(bid2);
 
     REQUIRE(list.Size() == 2);
-    REQUIRE(list.Contains("001") == true);
-    REQUIRE(list.Contains("002") == true);
+    REQUIRE(list.Find("001"));
+    REQUIRE(list.Find("002"));
 }
 
 TEST_CASE("LinkedList search finds existing bids", "[linkedlist]") {
@@ -232,20 +129,19 @@ TEST_CASE("LinkedList search finds existing bids", "[linkedlist]") {
     Bid bid1; bid1.bidId = "12345"; bid1.title = "Test Bid";
     list.Append(bid1);
 
-    Bid* found = list.Search("12345");
-    REQUIRE(found != nullptr);
-    REQUIRE(found->bidId == "12345");
-    REQUIRE(found->title == "Test Bid");
+    Bid found = list.Search("12345");
+    REQUIRE(found.bidId == "12345");
+    REQUIRE(found.title == "Test Bid");
 }
 
-TEST_CASE("LinkedList search returns nullptr for missing bids", "[linkedlist]") {
+TEST_CASE("LinkedList search returns an empty bid for missing IDs", "[linkedlist]") {
     LinkedList list;
 
     Bid bid1; bid1.bidId = "12345"; bid1.title = "Test Bid";
     list.Append(bid1);
 
-    REQUIRE(list.Search("99999") == nullptr);
-    REQUIRE(list.Search("") == nullptr);
+    REQUIRE(list.Search("99999").bidId.empty());
+    REQUIRE(list.Search("").bidId.empty());
 }
 
 TEST_CASE("LinkedList remove deletes head correctly", "[linkedlist]") {
@@ -261,9 +157,9 @@ TEST_CASE("LinkedList remove deletes head correctly", "[linkedlist]") {
 
     REQUIRE(list.Remove("001") == true);
     REQUIRE(list.Size() == 2);
-    REQUIRE(list.Contains("001") == false);
-    REQUIRE(list.Contains("002") == true);
-    REQUIRE(list.Contains("003") == true);
+    REQUIRE_FALSE(list.Find("001"));
+    REQUIRE(list.Find("002"));
+    REQUIRE(list.Find("003"));
 }
 
 TEST_CASE("LinkedList remove deletes middle correctly", "[linkedlist]") {
@@ -279,9 +175,9 @@ TEST_CASE("LinkedList remove deletes middle correctly", "[linkedlist]") {
 
     REQUIRE(list.Remove("002") == true);
     REQUIRE(list.Size() == 2);
-    REQUIRE(list.Contains("001") == true);
-    REQUIRE(list.Contains("002") == false);
-    REQUIRE(list.Contains("003") == true);
+    REQUIRE(list.Find("001"));
+    REQUIRE_FALSE(list.Find("002"));
+    REQUIRE(list.Find("003"));
 }
 
 TEST_CASE("LinkedList remove deletes tail correctly", "[linkedlist]") {
@@ -297,9 +193,9 @@ TEST_CASE("LinkedList remove deletes tail correctly", "[linkedlist]") {
 
     REQUIRE(list.Remove("003") == true);
     REQUIRE(list.Size() == 2);
-    REQUIRE(list.Contains("001") == true);
-    REQUIRE(list.Contains("002") == true);
-    REQUIRE(list.Contains("003") == false);
+    REQUIRE(list.Find("001"));
+    REQUIRE(list.Find("002"));
+    REQUIRE_FALSE(list.Find("003"));
 }
 
 TEST_CASE("LinkedList remove returns false for missing bid", "[linkedlist]") {
@@ -325,7 +221,350 @@ TEST_CASE("LinkedList handles single element removal", "[linkedlist]") {
 
     REQUIRE(list.Remove("001") == true);
     REQUIRE(list.Size() == 0);
-    REQUIRE(list.IsEmpty() == true);
+    REQUIRE(list.Size() == 0);
+}
+
+//============================================================================
+// FUND CHAIN TESTS
+//============================================================================
+
+static Bid fundBid(const string& id, const string& fund) {
+    Bid b;
+    b.bidId = id;
+    b.fund = fund;
+    return b;
+}
+
+static vector<string> fundIds(const LinkedList& list, const string& fund) {
+    vector<string> ids;
+    list.ForEachInFund(fund, [&](const Bid& b) { ids.push_back(b.bidId); });
+    return ids;
+}
+
+TEST_CASE("Fund chains follow list order for append and prepend", "[linkedlist][fund]") {
+    LinkedList list;
+    list.Append(fundBid("1", "General"));
+    list.Append(fundBid("2", "Enterprise"));
+    list.Append(fundBid("3", "General"));
+    list.Prepend(fundBid("0", "General"));
+
+    REQUIRE(fundIds(list, "General") == vector<string>{"0", "1", "3"});
+    REQUIRE(fundIds(list, "Enterprise") == vector<string>{"2"});
+    REQUIRE(list.FundSize("General") == 3);
+    REQUIRE(list.FundSize("Missing") == 0);
+}
+
+TEST_CASE("Removing bids keeps fund chains linked", "[linkedlist][fund]") {
+    LinkedList list;
+    list.Append(fundBid("1", "General"));
+    list.Append(fundBid("2", "General"));
+    list.Append(fundBid("3", "Enterprise"));
+    list.Append(fundBid("4", "General"));
+
+    REQUIRE(list.Remove("2"));   // middle of its chain
+    REQUIRE(fundIds(list, "General") == vector<string>{"1", "4"});
+    REQUIRE(list.Remove("4"));   // chain tail
+    list.Append(fundBid("5", "General"));
+    REQUIRE(fundIds(list, "General") == vector<string>{"1", "5"});
+
+    REQUIRE(list.Remove("3"));   // last bid of a fund
+    REQUIRE(list.FundSize("Enterprise") == 0);
+    REQUIRE(fundIds(list, "Enterprise").empty());
+}
+
+//============================================================================
+// HANDLE TESTS
+//============================================================================
+
+static vector<string> forwardIds(const LinkedList& list) {
+    vector<string> out;
+    for (auto h = list.First(); h; h = h.next()) out.push_back(h.bid().bidId);
+    return out;
+}
+
+static vector<string> backwardIds(const LinkedList& list) {
+    vector<string> out;
+    for (auto h = list.Last(); h; h = h.prev()) out.push_back(h.bid().bidId);
+    return out;
+}
+
+TEST_CASE("Remove by handle unlinks head, middle and tail", "[linkedlist][handle]") {
+    LinkedList list;
+    for (string id : {"1", "2", "3", "4"}) list.Append(fundBid(id, "General"));
+
+    auto middle = list.Find("2");
+    REQUIRE(middle);
+    list.Remove(middle);
+    REQUIRE(forwardIds(list) == vector<string>{"1", "3", "4"});
+
+    list.Remove(list.First());
+    list.Remove(list.Last());
+    REQUIRE(forwardIds(list) == vector<string>{"3"});
+    REQUIRE(backwardIds(list) == vector<string>{"3"});
+    REQUIRE(fundIds(list, "General") == vector<string>{"3"});
+    REQUIRE(list.Size() == 1);
+
+    list.Remove(list.Find("3"));
+    REQUIRE(list.Size() == 0);
+    REQUIRE_FALSE(list.First());
+    REQUIRE_FALSE(list.Last());
+}
+
+TEST_CASE("Reverse iteration sees prepends and appends", "[linkedlist][handle]") {
+    LinkedList list;
+    list.Append(fundBid("2", "F"));
+    list.Append(fundBid("3", "F"));
+    list.Prepend(fundBid("1", "F"));
+
+    REQUIRE(forwardIds(list) == vector<string>{"1", "2", "3"});
+    REQUIRE(backwardIds(list) == vector<string>{"3", "2", "1"});
+}
+
+TEST_CASE("Handles of other bids survive a removal", "[linkedlist][handle]") {
+    LinkedList list;
+    for (string id : {"1", "2", "3"}) list.Append(fundBid(id, "F"));
+
+    auto first = list.Find("1");
+    auto last = list.Find("3");
+    list.Remove("2");
+    REQUIRE(first.next() == last);
+    REQUIRE(last.prev() == first);
+    REQUIRE(first.bid().bidId == "1");
+}
+
+TEST_CASE("Repeated IDs resolve to the first one in list order", "[linkedlist][handle]") {
+    LinkedList list;
+    list.Append(fundBid("7", "A"));
+    list.Append(fundBid("8", "B"));
+    list.Append(fundBid("7", "C"));
+
+    REQUIRE(list.Search("7").fund == "A");
+    REQUIRE(list.Remove("7"));
+    REQUIRE(list.Search("7").fund == "C");   // the next one takes over
+
+    list.Prepend(fundBid("7", "D"));
+    REQUIRE(list.Search("7").fund == "D");
+    REQUIRE(list.Remove("7"));
+    REQUIRE(list.Remove("7"));
+    REQUIRE_FALSE(list.Find("7"));
+}
+
+//============================================================================
+// SEGMENT TESTS
+//============================================================================
+
+static vector<string> listIds(const LinkedList& list) {
+    vector<string> ids;
+    for (auto h = list.First(); h; h = h.next()) ids.push_back(h.bid().bidId);
+    return ids;
+}
+
+// Parts in order, each part's bids in order; must equal the list itself
+static vector<string> parallelIds(const LinkedList& list, unsigned threads, size_t& parts) {
+    vector<vector<string>> seen(threads);
+    parts = list.ForEachParallel(threads, [&](size_t part, const Bid& b) { seen[part].push_back(b.bidId); });
+    vector<string> ids;
+    for (size_t p = 0; p < parts; p++) {
+        REQUIRE_FALSE(seen[p].empty());
+        ids.insert(ids.end(), seen[p].begin(), seen[p].end());
+    }
+    return ids;
+}
+
+TEST_CASE("Appends open a new segment every N nodes", "[linkedlist][segment]") {
+    LinkedList list(4);
+    for (int i = 0; i < 10; i++) list.Append(fundBid(to_string(i), "F"));
+    REQUIRE(list.SegmentCount() == 3);   // 4 + 4 + 2
+    REQUIRE(list.SegmentsValid());
+
+    size_t parts = 0;
+    REQUIRE(parallelIds(list, 3, parts) == listIds(list));
+    REQUIRE(parts == 3);
+    REQUIRE(parallelIds(list, 8, parts) == listIds(list));
+    REQUIRE(parts == 3);                 // never more parts than segments
+    REQUIRE(parallelIds(list, 1, parts) == listIds(list));
+    REQUIRE(parts == 1);
+}
+
+TEST_CASE("Segments survive prepends and removals", "[linkedlist][segment]") {
+    LinkedList list(3);
+    unsigned seed = 7;
+    auto next = [&] { seed = seed * 1103515245u + 12345u; return (seed >> 8) % 100; };
+    for (int step = 0; step < 2000; step++) {
+        unsigned r = next();
+        string id = to_string(next());
+        if (r < 40) {
+            list.Append(fundBid(id, "F"));
+        } else if (r < 60) {
+            list.Prepend(fundBid(id, "F"));
+        } else if (r < 80) {
+            list.Remove(id);
+        } else if (list.First()) {
+            list.Remove(r % 2 ? list.First() : list.Last());
+        }
+        REQUIRE(list.SegmentsValid());
+    }
+    REQUIRE(list.Size() > 0);
+
+    size_t parts = 0;
+    REQUIRE(parallelIds(list, 4, parts) == listIds(list));
+
+    while (list.First()) list.Remove(list.First());
+    REQUIRE(list.SegmentCount() == 0);
+    list.Prepend(fundBid("1", "F"));
+    REQUIRE(list.SegmentsValid());
+}
+
+TEST_CASE("Parallel scan rethrows a part's exception", "[linkedlist][segment]") {
+    LinkedList list(2);
+    for (int i = 0; i < 20; i++) list.Append(fundBid(to_string(i), "F"));
+    REQUIRE_THROWS_AS(list.ForEachParallel(4, [](size_t, const Bid& b) {
+        if (b.bidId == "17") throw runtime_error("bad bid");
+    }), runtime_error);
+}
+
+TEST_CASE("Parallel filter and totals match a serial scan", "[linkedlist][segment]") {
+    LinkedList store(16);
+    for (int i = 0; i < 1000; i++) {
+        Bid b = fundBid(to_string(i), i % 3 ? "General" : "Enterprise");
+        b.amount = (i * 37) % 250 + 0.5;
+        store.Append(b);
+    }
+
+    vector<Bid> enterprise = store.FilterParallel([](const Bid& b) { return b.fund == "Enterprise"; }, 4);
+    REQUIRE(enterprise.size() == 334);
+    for (size_t i = 0; i < enterprise.size(); i++) {
+        REQUIRE(enterprise[i].bidId == to_string(i * 3));   // list order kept
+    }
+
+    BidTotals all = store.TotalsParallel(nullptr, 4);
+    double total = 0.0;
+    store.ForEach([&](const Bid& b) { total += b.amount; });
+    REQUIRE(all.count == 1000);
+    REQUIRE(all.total == total);                        // exact: all amounts are in halves
+    REQUIRE(all.low == 0.5);
+    REQUIRE(all.high == 249.5);
+
+    BidTotals none = store.TotalsParallel([](const Bid&) { return false; }, 4);
+    REQUIRE(none.count == 0);
+    REQUIRE(none.total == 0.0);
+}
+
+//============================================================================
+// SORT TESTS
+//============================================================================
+
+static Bid amountBid(const string& id, double amount, const string& fund = "F") {
+    Bid b = fundBid(id, fund);
+    b.amount = amount;
+    return b;
+}
+
+static vector<string> reverseIds(const LinkedList& list) {
+    vector<string> ids;
+    for (auto h = list.Last(); h; h = h.prev()) ids.insert(ids.begin(), h.bid().bidId);
+    return ids;
+}
+
+TEST_CASE("Sort by amount relinks the list, keeping ties in order", "[linkedlist][sort]") {
+    LinkedList list(2);
+    list.Append(amountBid("1", 30.00, "A"));
+    list.Append(amountBid("2", 10.00, "B"));
+    list.Append(amountBid("3", 20.00, "A"));
+    list.Append(amountBid("4", 10.00, "A"));
+    list.Append(amountBid("5", -5.00, "B"));
+    auto handle = list.Find("3");
+
+    list.Sort(BidSortKey::AMOUNT);
+    REQUIRE(listIds(list) == vector<string>{"5", "2", "4", "3", "1"});
+    REQUIRE(reverseIds(list) == listIds(list));
+    REQUIRE(fundIds(list, "A") == vector<string>{"4", "3", "1"});
+    REQUIRE(fundIds(list, "B") == vector<string>{"5", "2"});
+    REQUIRE(list.FundSize("A") == 3);
+    REQUIRE(list.SegmentsValid());
+    REQUIRE(list.SegmentCount() == 3);
+    REQUIRE(handle.bid().bidId == "3");   // same node, new place
+
+    list.Remove(handle);
+    list.Append(amountBid("6", 0.0));
+    REQUIRE(listIds(list) == vector<string>{"5", "2", "4", "1", "6"});
+    REQUIRE(list.SegmentsValid());
+}
+
+TEST_CASE("Sort by ID puts numbers first, then text", "[linkedlist][sort]") {
+    LinkedList list;
+    for (string id : {"B-2", "100", "99", "A-1", "007", "12345678901234567890123", "5"}) {
+        list.Append(fundBid(id, "F"));
+    }
+    list.Sort(BidSortKey::ID);
+    REQUIRE(listIds(list) == vector<string>{"5", "007", "99", "100", "12345678901234567890123", "A-1", "B-2"});
+}
+
+TEST_CASE("Sort moves the ID index to the new first duplicate", "[linkedlist][sort]") {
+    LinkedList list;
+    list.Append(amountBid("7", 50.0, "first"));
+    list.Append(amountBid("8", 40.0));
+    list.Append(amountBid("7", 10.0, "second"));
+
+    list.Sort(BidSortKey::AMOUNT);
+    REQUIRE(list.Search("7").fund == "second");
+    REQUIRE(list.Remove("7"));
+    REQUIRE(list.Search("7").fund == "first");
+    REQUIRE(list.Remove("7"));
+    REQUIRE_FALSE(list.Find("7"));
+    REQUIRE(listIds(list) == vector<string>{"8"});
+}
+
+TEST_CASE("Sort over many bids matches a stable sort", "[linkedlist][sort]") {
+    LinkedList list(64);
+    vector<Bid> bids;
+    for (int i = 0; i < 200000; i++) {
+        bids.push_back(amountBid(to_string(i * 7919 % 200003), (i * 37 % 10007) / 100.0, i % 2 ? "A" : "B"));
+        list.Append(bids.back());
+    }
+    stable_sort(bids.begin(), bids.end(), [](const Bid& a, const Bid& b) {
+        return amountSortKey(a.amount) < amountSortKey(b.amount);
+    });
+    vector<string> expected;
+    for (const Bid& b : bids) expected.push_back(b.bidId);
+
+    list.Sort(BidSortKey::AMOUNT, 4);
+    REQUIRE(listIds(list) == expected);
+    REQUIRE(list.SegmentsValid());
+    REQUIRE(list.FundSize("A") == 100000);
+
+    list.Sort(BidSortKey::ID, 4);
+    vector<string> ids = listIds(list);
+    REQUIRE(is_sorted(ids.begin(), ids.end(), [](const string& a, const string& b) { return bidIdLess(a, b); }));
+}
+
+//============================================================================
+// FREEZE TESTS
+//============================================================================
+
+TEST_CASE("An edit drops the frozen copy and the nodes answer again", "[linkedlist][freeze]") {
+    LinkedList list;
+    list.Append(amountBid("1", 10.0));
+    list.Append(amountBid("2", 20.0));
+    list.Freeze();
+    REQUIRE(list.IsFrozen());
+    REQUIRE(list.Search("2").amount == 20.0);
+
+    list.Append(amountBid("3", 30.0));
+    REQUIRE_FALSE(list.IsFrozen());
+    REQUIRE(list.Search("3").amount == 30.0);
+
+    list.Freeze();
+    REQUIRE(list.Remove("1"));
+    REQUIRE_FALSE(list.IsFrozen());
+    REQUIRE(list.Search("1").bidId.empty());
+
+    list.Freeze();
+    list.Sort(BidSortKey::AMOUNT);
+    REQUIRE_FALSE(list.IsFrozen());
+    vector<Bid> found = list.SearchBatch({"3", "1"});
+    REQUIRE(found[0].bidId == "3");
+    REQUIRE(found[1].bidId.empty());
 }
 
 //============================================================================
@@ -342,9 +581,8 @@ TEST_CASE("Search with trimmed whitespace finds bid", "[integration]") {
     string userInput = "  92549  ";
     string trimmedId = trimWhitespace(userInput);
 
-    Bid* found = list.Search(trimmedId);
-    REQUIRE(found != nullptr);
-    REQUIRE(found->bidId == "92549");
+    Bid found = list.Search(trimmedId);
+    REQUIRE(found.bidId == "92549");
 }
 
 TEST_CASE("Remove with trimmed whitespace removes bid", "[integration]") {
@@ -358,7 +596,7 @@ TEST_CASE("Remove with trimmed whitespace removes bid", "[integration]") {
     string trimmedId = trimWhitespace(userInput);
 
     REQUIRE(list.Remove(trimmedId) == true);
-    REQUIRE(list.Contains("92549") == false);
+    REQUIRE_FALSE(list.Find("92549"));
 }
 
 TEST_CASE("Without trimming, whitespace causes lookup failure", "[integration]") {
@@ -369,7 +607,7 @@ TEST_CASE("Without trimming, whitespace causes lookup failure", "[integration]")
 
     // Without trimming, lookup fails
     string userInputWithSpaces = "  92549  ";
-    REQUIRE(list.Search(userInputWithSpaces) == nullptr);
+    REQUIRE(list.Search(userInputWithSpaces).bidId.empty());
     REQUIRE(list.Remove(userInputWithSpaces) == false);
 }
 
@@ -384,8 +622,8 @@ TEST_CASE("LinkedList handles duplicate prevention check", "[linkedlist]") {
     list.Append(bid1);
 
     // Check if ID already exists before adding
-    REQUIRE(list.Contains("001") == true);
-    REQUIRE(list.Contains("002") == false);
+    REQUIRE(list.Find("001"));
+    REQUIRE_FALSE(list.Find("002"));
 }
 
 TEST_CASE("LinkedList handles bid with special characters in ID", "[linkedlist]") {
@@ -397,8 +635,8 @@ TEST_CASE("LinkedList handles bid with special characters in ID", "[linkedlist]"
     list.Append(bid1);
     list.Append(bid2);
 
-    REQUIRE(list.Contains("ABC-123") == true);
-    REQUIRE(list.Contains("XYZ_456") == true);
+    REQUIRE(list.Find("ABC-123"));
+    REQUIRE(list.Find("XYZ_456"));
 }
 
 TEST_CASE("LinkedList handles very long bid IDs", "[linkedlist]") {
@@ -408,6 +646,6 @@ TEST_CASE("LinkedList handles very long bid IDs", "[linkedlist]") {
     Bid bid1; bid1.bidId = longId;
     list.Append(bid1);
 
-    REQUIRE(list.Contains(longId) == true);
+    REQUIRE(list.Find(longId));
     REQUIRE(list.Remove(longId) == true);
 }
@@ -0,0 +1,93 @@
+//============================================================================
+// Unit Tests for MappedCsv
+//
+// Tests field spans over a mapped file, the column-count check, CSV
+// unquoting, and lazy titles read through Bid::Title().
+//============================================================================
+
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Bid.hpp"
+#include "MappedCsv.hpp"
+
+using namespace std;
+namespace fs = std::filesystem;
+
+static string writeTempCsv(const string& name, const string& content) {
+    fs::path p = fs::temp_directory_path() / ("mappedcsv_test_" + name + ".csv");
+    ofstream(p, ios::binary) << content;
+    return p.string();
+}
+
+TEST_CASE("Scanner reports field spans for each row", "[mappedcsv]") {
+    string path = writeTempCsv("spans",
+        "Title,ID,Amount\r\n"
+        "\"Desk, oak\",101,$5.00\r\n"
+        "\r\n"
+        "Chair,102,$1.00\n");
+    MappedFile file(path);
+
+    vector<vector<string>> rows;
+    scanCsvRows(file, ',', [&](const vector<FieldSpan>& fields) {
+        vector<string> row;
+        for (const auto& f : fields) row.emplace_back(file.view(f.offset, f.length));
+        rows.push_back(row);
+    });
+
+    REQUIRE(rows.size() == 2);
+    REQUIRE(rows[0] == vector<string>{"\"Desk, oak\"", "101", "$5.00"});
+    REQUIRE(rows[1] == vector<string>{"Chair", "102", "$1.00"});
+    fs::remove(path);
+}
+
+TEST_CASE("Scanner rejects rows with missing fields", "[mappedcsv]") {
+    string path = writeTempCsv("corrupt", "a,b,c\n1,2\n");
+    MappedFile file(path);
+    REQUIRE_THROWS_AS(scanCsvRows(file, ',', [](const vector<FieldSpan>&) {}), runtime_error);
+    fs::remove(path);
+}
+
+TEST_CASE("A CSV narrower than the columns read is rejected up front", "[mappedcsv]") {
+    string path = writeTempCsv("narrow", "Title,ID,Amount\nDesk,101,$5.00\n");
+    MappedFile file(path);
+    try {
+        requireCsvColumns(file, ',', 9);
+        FAIL("a 3-column CSV passed a 9-column check");
+    } catch (const runtime_error& e) {
+        REQUIRE(string(e.what()).find(path) != string::npos);
+    }
+    REQUIRE_NOTHROW(requireCsvColumns(file, ',', 3));
+    fs::remove(path);
+}
+
+TEST_CASE("Unquoting handles doubled quotes and plain fields", "[mappedcsv]") {
+    REQUIRE(unquoteCsvField("\"\"\"ASE\"\" File Cabinet\"") == "\"ASE\" File Cabinet");
+    REQUIRE(unquoteCsvField("\"Desk, oak\"") == "Desk, oak");
+    REQUIRE(unquoteCsvField("Chair") == "Chair");
+    REQUIRE(unquoteCsvField("\"") == "\"");
+}
+
+TEST_CASE("Lazy title is decoded from the mapping on demand", "[mappedcsv]") {
+    string path = writeTempCsv("lazy", "Title,ID\n\"\"\"Kings Inc.\"\" Couch\",92133\n");
+    MappedFile file(path);
+
+    Bid bid;
+    scanCsvRows(file, ',', [&](const vector<FieldSpan>& f) {
+        bid.titleSource = &file;
+        bid.titleOffset = f[0].offset;
+        bid.titleLength = f[0].length;
+    });
+
+    REQUIRE(bid.title.empty());
+    REQUIRE(bid.Title() == "\"Kings Inc.\" Couch");
+
+    Bid eager;
+    eager.title = "Plain";
+    REQUIRE(eager.Title() == "Plain");
+    fs::remove(path);
+}
@@ -0,0 +1,184 @@
+//============================================================================
+// Unit Tests for BidMappedList
+//
+// Tests that bids survive closing and reopening the file, growth of the
+// file past its first mapping, repeated IDs, and recovery of a file that
+// was not closed cleanly (a copy taken while open, or one whose derived
+// header fields were damaged).
+//============================================================================
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "BidMappedList.hpp"
+#include "MappedCsv.hpp"
+#include "TestBids.hpp"
+
+using namespace std;
+namespace fs = std::filesystem;
+
+// Fresh file path per test so runs don't see each other's bids
+static string tempListPath(const string& name) {
+    fs::path p = fs::temp_directory_path() / ("mappedlist_test_" + name + ".map");
+    fs::remove(p);
+    return p.string();
+}
+
+// Overwrite one 8-byte header field in the file (see BidMappedList::Header)
+static void pokeHeader(const string& path, size_t field, uint64_t value) {
+    fstream f(path, ios::in | ios::out | ios::binary);
+    f.seekp(static_cast<streamoff>(field * 8));
+    f.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+TEST_CASE("Mapped list keeps its bids across reopening", "[mappedlist]") {
+    const string path = tempListPath("reopen");
+    {
+        BidMappedList list(path);
+        REQUIRE(list.Size() == 0);
+        list.Append(makeBid("2", "B", 20.5));
+        list.Append(makeBid("3"));
+        list.Prepend(makeBid("1"));
+        list.Append(makeBid("4"));
+        REQUIRE(list.Remove("3"));
+        REQUIRE_FALSE(list.Remove("3"));
+        REQUIRE(list.GarbageBytes() > 0);
+    }
+
+    BidMappedList list(path);
+    REQUIRE_FALSE(list.Recovered());
+    REQUIRE(idsOf(list) == vector<string>{"1", "2", "4"});
+    REQUIRE(list.Size() == 3);
+    Bid two = list.Search("2");
+    REQUIRE(two.title == "Bid 2");
+    REQUIRE(two.fund == "B");
+    REQUIRE(two.amount == 20.5);
+    REQUIRE(list.Search("3").bidId.empty());
+
+    list.Append(makeBid("5"));   // the tail survived too
+    REQUIRE(idsOf(list) == vector<string>{"1", "2", "4", "5"});
+}
+
+TEST_CASE("Mapped list grows the file as bids are added", "[mappedlist]") {
+    const string path = tempListPath("grow");
+    const string longTitle(200, 't');
+    uint64_t firstSize = 0;
+    {
+        BidMappedList list(path);
+        firstSize = list.FileBytes();
+        for (int i = 0; i < 20000; i++) {
+            Bid b = makeBid(to_string(i));
+            b.title = longTitle;
+            list.Append(b);
+        }
+        REQUIRE(list.FileBytes() > firstSize);
+        REQUIRE(list.Search("19999").title == longTitle);
+    }
+
+    BidMappedList list(path);
+    REQUIRE(list.Size() == 20000);
+    REQUIRE(list.Search("0").title == longTitle);
+    REQUIRE(list.Search("12345").bidId == "12345");
+    REQUIRE(idsOf(list).back() == "19999");
+}
+
+TEST_CASE("Mapped list acts on the first of repeated IDs", "[mappedlist]") {
+    const string path = tempListPath("repeated");
+    {
+        BidMappedList list(path);
+        list.Append(makeBid("7", "B"));
+        list.Append(makeBid("8"));
+        list.Append(makeBid("7", "C"));
+        list.Prepend(makeBid("7", "A"));
+        REQUIRE(list.Search("7").fund == "A");
+        REQUIRE(list.Remove("7"));
+        REQUIRE(list.Search("7").fund == "B");
+    }
+
+    BidMappedList list(path);
+    REQUIRE(list.Search("7").fund == "B");
+    REQUIRE(list.Remove("7"));
+    REQUIRE(list.Search("7").fund == "C");
+    REQUIRE(list.Remove("7"));
+    REQUIRE_FALSE(list.Remove("7"));
+    REQUIRE(idsOf(list) == vector<string>{"8"});
+}
+
+TEST_CASE("Mapped list recovers a file that was not closed", "[mappedlist]") {
+    const string path = tempListPath("crash");
+    const string copy = tempListPath("crash_copy");
+    {
+        BidMappedList list(path);
+        for (int i = 0; i < 3000; i++) list.Append(makeBid(to_string(i), i % 2 ? "Odd" : "Even", i));
+        for (int i = 0; i < 3000; i += 3) list.Remove(to_string(i));
+        list.Prepend(makeBid("front"));
+        // What a crash right now would leave behind: the clean flag unset
+        fs::copy_file(path, copy);
+    }
+
+    BidMappedList list(copy);
+    REQUIRE(list.Recovered());
+    REQUIRE(list.Size() == 2001);
+    vector<string> ids = idsOf(list);
+    REQUIRE(ids.front() == "front");
+    REQUIRE(ids[1] == "1");
+    REQUIRE(ids.back() == "2999");
+    REQUIRE(list.Search("1000").fund == "Even");
+    REQUIRE(list.Search("999").bidId.empty());
+    list.Append(makeBid("after"));
+    REQUIRE(idsOf(list).back() == "after");
+}
+
+TEST_CASE("Mapped list rebuilds damaged derived fields", "[mappedlist]") {
+    const string path = tempListPath("damaged");
+    {
+        BidMappedList list(path);
+        list.Append(makeBid("1"));
+        list.Append(makeBid("2"));
+        list.Append(makeBid("3"));
+    }
+    // tail, count and the index offset are derived: wreck them, and clear 'clean'
+    pokeHeader(path, 3, 0);
+    pokeHeader(path, 4, 99);
+    pokeHeader(path, 5, 8);
+    pokeHeader(path, 9, 0);
+
+    {
+        BidMappedList list(path);
+        REQUIRE(list.Recovered());
+        REQUIRE(list.Size() == 3);
+        REQUIRE(list.Search("2").title == "Bid 2");
+        list.Append(makeBid("4"));
+        REQUIRE(idsOf(list) == vector<string>{"1", "2", "3", "4"});
+    }
+
+    const string other = tempListPath("not_a_list");
+    ofstream(other) << string(5000, 'x');
+    REQUIRE_THROWS_AS(BidMappedList(other), BidMappedListError);
+}
+
+TEST_CASE("Mapped list stores lazy titles decoded", "[mappedlist]") {
+    fs::path csv = fs::temp_directory_path() / "mappedlist_test_lazy.csv";
+    ofstream(csv, ios::binary) << "Title,ID\n\"Desk, \"\"oak\"\"\",7\n";
+    const string path = tempListPath("lazy");
+    {
+        MappedFile file(csv.string());
+        Bid bid = makeBid("7");
+        bid.title.clear();
+        scanCsvRows(file, ',', [&](const vector<FieldSpan>& f) {
+            bid.titleSource = &file;
+            bid.titleOffset = f[0].offset;
+            bid.titleLength = f[0].length;
+        });
+        BidMappedList list(path);
+        list.Append(bid);
+    }
+
+    BidMappedList list(path);   // the CSV mapping is gone; the title must not need it
+    REQUIRE(list.Search("7").title == "Desk, \"oak\"");
+    fs::remove(csv);
+}
@@ -0,0 +1,106 @@
+//============================================================================
+// Unit Tests for BidMemory
+//
+// Tests that placed blocks are usable and aligned, that prefaulting makes
+// them resident, that a vector with the placed allocator keeps its data as
+// it grows, and that the stores accept a policy. Whether huge pages or
+// locks are granted depends on the system, so those are only reported.
+//============================================================================
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "BidMappedList.hpp"
+#include "BidMemory.hpp"
+#include "BidVectorList.hpp"
+#include "TestBids.hpp"
+
+using namespace std;
+namespace fs = std::filesystem;
+
+TEST_CASE("Placed blocks are usable whatever the policy", "[memory]") {
+    MemoryPolicy thp;
+    thp.hugePages = HugePages::Transparent;
+    MemoryPolicy hugetlb;
+    hugetlb.hugePages = HugePages::Explicit;   // falls back to thp without reserved pages
+    MemoryPolicy locked;
+    locked.lock = true;
+
+    for (const MemoryPolicy& policy : {MemoryPolicy(), thp, hugetlb, locked}) {
+        for (size_t bytes : {size_t(100), kPlacedMinBytes, size_t(5) << 20}) {
+            char* p = static_cast<char*>(placedAllocate(bytes, policy));
+            REQUIRE(p != nullptr);
+            memset(p, 0x5a, bytes);
+            REQUIRE(p[bytes - 1] == 0x5a);
+            if (policy.Any() && bytes >= kPlacedMinBytes) {
+                REQUIRE(memoryStats(p, bytes).hugePageSize > 0);
+                REQUIRE(reinterpret_cast<uintptr_t>(p) % memoryStats(p, bytes).hugePageSize == 0);
+            }
+            placedFree(p, bytes, policy);
+        }
+    }
+}
+
+#ifdef __linux__
+TEST_CASE("Prefaulted blocks are resident before first use", "[memory]") {
+    MemoryPolicy policy;
+    policy.hugePages = HugePages::Transparent;
+    policy.prefault = true;
+
+    const size_t bytes = size_t(8) << 20;
+    void* p = placedAllocate(bytes, policy);
+    MemoryStats stats = memoryStats(p, bytes);
+    REQUIRE(stats.bytes == bytes);
+    REQUIRE(stats.resident == bytes);
+    REQUIRE(stats.huge <= stats.resident);
+    REQUIRE(stats.pageSize >= 4096);
+    placedFree(p, bytes, policy);
+}
+#endif
+
+TEST_CASE("Vector with the placed allocator keeps its data as it grows", "[memory]") {
+    MemoryPolicy policy;
+    policy.hugePages = HugePages::Transparent;
+    policy.prefault = true;
+
+    vector<uint64_t, PlacedAllocator<uint64_t>> values{PlacedAllocator<uint64_t>(policy)};
+    for (uint64_t i = 0; i < 1000000; i++) {   // 8 MB: several moves between placed blocks
+        values.push_back(i * 3);
+    }
+    REQUIRE(values[0] == 0);
+    REQUIRE(values[999999] == 999999 * 3);
+
+    vector<uint64_t, PlacedAllocator<uint64_t>> copy(values, values.get_allocator());
+    REQUIRE(copy == values);
+}
+
+TEST_CASE("Stores take a memory policy", "[memory]") {
+    MemoryPolicy policy;
+    policy.hugePages = HugePages::Transparent;
+    policy.prefault = true;
+
+    BidVectorList list(policy);
+    for (int i = 0; i < 20000; i++) {
+        list.Append(makeBid(to_string(i)));
+    }
+    REQUIRE(list.Remove("5"));
+    list.Compact();
+    REQUIRE(list.Search("19999").bidId == "19999");
+    REQUIRE(list.Memory().bytes >= list.Slots() * sizeof(Bid));
+
+    fs::path path = fs::temp_directory_path() / "memory_test_mapped.map";
+    fs::remove(path);
+    {
+        BidMappedList mapped(path.string(), false, policy);
+        mapped.Append(makeBid("1"));
+        REQUIRE(mapped.Memory().bytes == mapped.FileBytes());
+#ifdef __linux__
+        REQUIRE(mapped.Memory().resident == mapped.FileBytes());
+#endif
+    }
+    fs::remove(path);
+}
@@ -0,0 +1,151 @@
+//============================================================================
+// Unit Tests for BidReload
+//
+// Tests that reloads publish whole versions while readers keep running,
+// that old versions are freed on the reloader's thread once released,
+// failed and superseded reloads, and async queries over a reloader.
+//============================================================================
+
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BidAsync.hpp"
+#include "BidReload.hpp"
+#include "BidSkipList.hpp"
+
+using namespace std;
+
+// A skip list that records which thread destroyed it
+class TrackedStore : public BidSkipList {
+public:
+    explicit TrackedStore(atomic<thread::id>* destroyedBy = nullptr) : destroyedBy(destroyedBy) {}
+    ~TrackedStore() override {
+        if (destroyedBy) *destroyedBy = this_thread::get_id();
+    }
+private:
+    atomic<thread::id>* destroyedBy;
+};
+
+// Version 'v': 'count' bids, every one with fund "v<v>"
+static unique_ptr<BidStore> version(int v, int count, atomic<thread::id>* destroyedBy = nullptr) {
+    auto store = make_unique<TrackedStore>(destroyedBy);
+    for (int i = 0; i < count; i++) {
+        Bid b;
+        b.bidId = to_string(i);
+        b.fund = "v" + to_string(v);
+        store->Append(b);
+    }
+    return store;
+}
+
+TEST_CASE("Reload publishes a new version and frees the old one off the reader", "[reload]") {
+    atomic<thread::id> destroyedBy{};
+    BidReloader reloader(version(0, 10, &destroyedBy));
+    REQUIRE(reloader.Generation() == 0);
+
+    shared_ptr<const BidStore> pinned = reloader.Current();
+    reloader.Reload([] { return version(1, 20); });
+    reloader.Wait();
+
+    REQUIRE(reloader.Generation() == 1);
+    REQUIRE(reloader.Current()->Size() == 20);
+    REQUIRE(reloader.Current()->Search("5").fund == "v1");
+    REQUIRE(pinned->Size() == 10);                 // still whole while held
+    REQUIRE(pinned->Search("5").fund == "v0");
+    REQUIRE(reloader.Freed() == 0);
+
+    pinned.reset();                                // last reader lets go
+    reloader.Wait();
+    REQUIRE(reloader.Freed() == 1);
+    REQUIRE(destroyedBy.load() != thread::id{});
+    REQUIRE(destroyedBy.load() != this_thread::get_id());
+}
+
+TEST_CASE("Readers only ever see complete versions", "[reload]") {
+    BidReloader reloader(version(0, 1000));
+    atomic<bool> done{false};
+    atomic<int> torn{0}, reads{0};
+
+    vector<thread> readers;
+    for (int r = 0; r < 3; r++) {
+        readers.emplace_back([&] {
+            while (!done) {
+                shared_ptr<const BidStore> store = reloader.Current();
+                string fund = store->Search("0").fund;
+                int v = stoi(fund.substr(1));
+                if (store->Size() != 1000 + v || store->Search(to_string(999 + v)).fund != fund) torn++;
+                reads++;
+            }
+        });
+    }
+    for (int v = 1; v <= 20; v++) {
+        reloader.Reload([v] { return version(v, 1000 + v); });
+        reloader.Wait();
+    }
+    while (reads < 100) this_thread::yield();
+    done = true;
+    for (thread& t : readers) t.join();
+
+    REQUIRE(torn == 0);
+    REQUIRE(reloader.Generation() == 20);
+    REQUIRE(reloader.Current()->Size() == 1020);
+}
+
+TEST_CASE("A failed reload keeps the current version", "[reload]") {
+    BidReloader reloader(version(0, 5));
+    reloader.Reload([]() -> unique_ptr<BidStore> { throw runtime_error("disk gone"); });
+    reloader.Wait();
+    REQUIRE(reloader.LastError() == "disk gone");
+    REQUIRE(reloader.Generation() == 0);
+    REQUIRE(reloader.Current()->Size() == 5);
+
+    reloader.Reload([] { return unique_ptr<BidStore>(); });
+    reloader.Wait();
+    REQUIRE_FALSE(reloader.LastError().empty());
+
+    reloader.Reload([] { return version(1, 6); });
+    reloader.Wait();
+    REQUIRE(reloader.LastError().empty());
+    REQUIRE(reloader.Current()->Size() == 6);
+}
+
+TEST_CASE("Only the newest waiting reload runs", "[reload]") {
+    BidReloader reloader;
+    REQUIRE(reloader.Current() == nullptr);
+
+    promise<void> release;
+    shared_future<void> gate = release.get_future().share();
+    promise<void> started;
+    reloader.Reload([&] {
+        started.set_value();
+        gate.wait();
+        return version(1, 1);
+    });
+    started.get_future().wait();                   // the first build is running
+    atomic<int> builds{0};
+    for (int v = 2; v <= 5; v++) {
+        reloader.Reload([&builds, v] { builds++; return version(v, v); });
+    }
+    release.set_value();
+    reloader.Wait();
+
+    REQUIRE(builds == 1);
+    REQUIRE(reloader.Generation() == 2);
+    REQUIRE(reloader.Current()->Size() == 5);
+}
+
+TEST_CASE("Async queries follow the reloader's current version", "[reload][async]") {
+    BidReloader reloader(version(0, 10));
+    BidAsyncQueries queries(reloader, {2, 64, true});
+    REQUIRE(queries.Search("3").get().fund == "v0");
+
+    reloader.Reload([] { return version(1, 10); });
+    reloader.Wait();
+    REQUIRE(queries.Search("3").get().fund == "v1");
+    REQUIRE(queries.Filter([](const Bid& b) { return b.fund == "v1"; }).get().size() == 10);
+}
@@ -0,0 +1,69 @@
+//============================================================================
+// Unit Tests for BidSampler
+//
+// Tests sample size, file order, repeatability and that every row has the
+// same chance of being picked.
+//============================================================================
+
+#include <catch2/catch_test_macros.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "BidSampler.hpp"
+
+using namespace std;
+
+// Header plus rows "0".."count-1"
+static string numberedCsv(int count) {
+    string csv = "id\n";
+    for (int i = 0; i < count; i++) {
+        csv += to_string(i) + "\n";
+    }
+    return csv;
+}
+
+TEST_CASE("Sampler keeps the header and N rows in file order", "[sampler]") {
+    istringstream in(numberedCsv(1000));
+    SampledLines sample = reservoirSampleLines(in, 50, 7);
+
+    REQUIRE(sample.header == "id");
+    REQUIRE(sample.lines.size() == 50);
+    REQUIRE(sample.rowsSeen == 1000);
+    for (size_t i = 1; i < sample.lines.size(); i++) {
+        REQUIRE(stoi(sample.lines[i - 1]) < stoi(sample.lines[i]));
+    }
+}
+
+TEST_CASE("Sampler returns every row when the file is small", "[sampler]") {
+    istringstream in("id\r\n1\r\n2\r\n\r\n3\r\n");
+    SampledLines sample = reservoirSampleLines(in, 10, 1);
+    REQUIRE(sample.header == "id");
+    REQUIRE(sample.lines == vector<string>{"1", "2", "3"});
+}
+
+TEST_CASE("Sampler is repeatable for a given seed", "[sampler]") {
+    istringstream a(numberedCsv(5000)), b(numberedCsv(5000)), c(numberedCsv(5000));
+    auto first = reservoirSampleLines(a, 20, 42).lines;
+    auto second = reservoirSampleLines(b, 20, 42).lines;
+    auto other = reservoirSampleLines(c, 20, 43).lines;
+    REQUIRE(first == second);
+    REQUIRE(first != other);
+}
+
+TEST_CASE("Sampler picks rows uniformly", "[sampler]") {
+    const int rows = 100, keep = 10, trials = 4000;
+    vector<int> picked(rows, 0);
+    string csv = numberedCsv(rows);
+    for (int t = 0; t < trials; t++) {
+        istringstream in(csv);
+        for (const auto& line : reservoirSampleLines(in, keep, t).lines) {
+            picked[stoi(line)]++;
+        }
+    }
+    // Expected 400 picks per row; allow a generous 25% band
+    for (int count : picked) {
+        REQUIRE(count > 300);
+        REQUIRE(count < 500);
+    }
+}
@@ -0,0 +1,149 @@
+//============================================================================
+// Unit Tests for BidShards
+//
+// Tests routing by ID, repeated IDs and the ID index that counts them,
+// fund queries and parallel scans across shards, and many threads reading
+// and writing at once.
+//============================================================================
+
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BidShards.hpp"
+#include "TestBids.hpp"
+
+using namespace std;
+
+// Plain insertion-ordered shard; Search and Remove act on the first match
+class ListStore : public BidStore {
+public:
+    vector<Bid> bids;
+    void Append(const Bid& bid) override { bids.push_back(bid); }
+    void Prepend(const Bid& bid) override { bids.insert(bids.begin(), bid); }
+    bool Remove(const string& bidId) override {
+        auto it = find_if(bids.begin(), bids.end(), [&](const Bid& b) { return b.bidId == bidId; });
+        if (it == bids.end()) return false;
+        bids.erase(it);
+        return true;
+    }
+    Bid Search(const string& bidId) const override {
+        auto it = find_if(bids.begin(), bids.end(), [&](const Bid& b) { return b.bidId == bidId; });
+        return it == bids.end() ? Bid{} : *it;
+    }
+    int Size() const override { return static_cast<int>(bids.size()); }
+    void ForEach(const function<void(const Bid&)>& visit) const override {
+        for (const Bid& b : bids) visit(b);
+    }
+};
+
+static BidShardedStore::ShardFactory listShards() {
+    return [] { return make_unique<ListStore>(); };
+}
+
+TEST_CASE("Sharded store routes every ID to one shard", "[shards]") {
+    BidShardedStore store(8, listShards());
+    REQUIRE(store.Shards() == 8);
+    for (int i = 0; i < 1000; i++) store.Append(makeBid(to_string(i)));
+
+    REQUIRE(store.Size() == 1000);
+    REQUIRE(store.Search("417").title == "Bid 417");
+    REQUIRE(store.Search("1000").bidId.empty());
+    REQUIRE(store.Remove("417"));
+    REQUIRE_FALSE(store.Remove("417"));
+    REQUIRE(store.Size() == 999);
+
+    vector<size_t> perShard(8, 0);
+    store.ForEach([&](const Bid& b) { perShard[store.ShardOf(b.bidId)]++; });
+    for (size_t count : perShard) {
+        REQUIRE(count > 60);   // about 125 each
+        REQUIRE(count < 200);
+    }
+}
+
+TEST_CASE("Sharded store keeps repeated IDs in order", "[shards]") {
+    BidShardedStore store(4, listShards());
+    store.Append(makeBid("5", "B"));
+    store.Prepend(makeBid("5", "A"));
+    store.Append(makeBid("5", "C"));
+
+    REQUIRE(store.Search("5").fund == "A");
+    REQUIRE(store.Remove("5"));
+    REQUIRE(store.Search("5").fund == "B");
+}
+
+TEST_CASE("Sharded store's ID index counts every copy of an ID", "[shards]") {
+    BidShardedStore store(4, listShards());
+    store.Append(makeBid("5", "A"));
+    store.Append(makeBid("5", "B"));
+    store.Append(makeBid("6"));
+    REQUIRE(store.DistinctIds() == 2);
+
+    // The index only forgets an ID once its last bid is gone
+    REQUIRE(store.Remove("5"));
+    REQUIRE(store.Search("5").fund == "B");
+    REQUIRE(store.Remove("5"));
+    REQUIRE(store.Search("5").bidId.empty());
+    REQUIRE_FALSE(store.Remove("5"));
+    REQUIRE(store.DistinctIds() == 1);
+
+    store.Prepend(makeBid("5", "C"));
+    REQUIRE(store.Search("5").fund == "C");
+    REQUIRE(store.DistinctIds() == 2);
+}
+
+TEST_CASE("Sharded fund queries and scans cover every shard", "[shards]") {
+    BidShardedStore store(6, listShards());
+    for (int i = 0; i < 600; i++) {
+        store.Append(makeBid(to_string(i), i % 3 ? "General" : "Enterprise", i % 50 + 0.5));
+    }
+
+    REQUIRE(store.FundSize("Enterprise") == 200);
+    int seen = 0;
+    store.ForEachInFund("Enterprise", [&](const Bid& b) { seen += b.fund == "Enterprise"; });
+    REQUIRE(seen == 200);
+
+    vector<string> serial;
+    store.ForEach([&](const Bid& b) { if (b.fund == "Enterprise") serial.push_back(b.bidId); });
+    for (unsigned threads : {1u, 4u, 16u}) {
+        INFO(threads << " threads");
+        vector<Bid> found = store.FilterParallel([](const Bid& b) { return b.fund == "Enterprise"; }, threads);
+        vector<string> ids;
+        for (const Bid& b : found) ids.push_back(b.bidId);
+        REQUIRE(ids == serial);                 // shard order, same as ForEach
+
+        BidTotals totals = store.TotalsParallel(nullptr, threads);
+        REQUIRE(totals.count == 600);
+        REQUIRE(totals.low == 0.5);
+        REQUIRE(totals.high == 49.5);
+    }
+    REQUIRE(store.ForEachParallel(16, [](size_t, const Bid&) {}) == 6);
+}
+
+TEST_CASE("Sharded store takes reads and writes from many threads", "[shards]") {
+    BidShardedStore store(16, listShards());
+    for (int i = 0; i < 400; i++) store.Append(makeBid("base" + to_string(i)));
+
+    atomic<int> lost{0};
+    vector<thread> workers;
+    for (int t = 0; t < 6; t++) {
+        workers.emplace_back([&store, &lost, t] {
+            for (int i = 0; i < 300; i++) {
+                string id = "t" + to_string(t) + "-" + to_string(i);
+                store.Append(makeBid(id));
+                if (store.Search("base" + to_string(i % 400)).bidId.empty()) lost++;
+                if (i % 3 == 0) store.Remove(id);
+            }
+        });
+    }
+    for (thread& w : workers) w.join();
+
+    REQUIRE(lost == 0);
+    REQUIRE(store.Size() == 400 + 6 * 200);
+    REQUIRE(store.Search("t3-1").bidId == "t3-1");
+    REQUIRE(store.Search("t3-3").bidId.empty());
+    REQUIRE(store.DistinctIds() == 400 + 6 * 200);
+}
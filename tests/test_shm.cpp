@@ -0,0 +1,169 @@
+//============================================================================
+// Unit Tests for BidShm
+//
+// Tests that an attached view reads what was published (order, repeated
+// IDs, parallel slices), that it is read-only, that republishing leaves
+// attached views on their generation until they refresh, and that another
+// process can attach.
+//============================================================================
+
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+#include "BidShm.hpp"
+#include "BidVectorList.hpp"
+#include "MappedCsv.hpp"
+#include "TestBids.hpp"
+
+using namespace std;
+
+// Name per test and process so runs don't see each other's stores
+static string shmName(const string& name) {
+    string full = "bidshm_test_" + name + "_" + to_string(getpid());
+    unpublishShared(full);
+    return full;
+}
+
+TEST_CASE("Attached view reads the published store", "[shm]") {
+    const string name = shmName("read");
+    BidVectorList list;
+    list.Append(makeBid("10", "A", 10.25));
+    list.Append(makeBid("20", "B", 20.5));
+    list.Append(makeBid("10", "C", 30.0));   // repeated ID: Search finds the first
+    list.Prepend(makeBid("5", "", 0.0));
+
+    REQUIRE(publishShared(name, list) == 1);
+    BidSharedView view(name);
+    REQUIRE(view.Generation() == 1);
+    REQUIRE(view.Size() == 4);
+    REQUIRE(idsOf(view) == vector<string>{"5", "10", "20", "10"});
+
+    Bid found = view.Search("10");
+    REQUIRE(found.title == "Bid 10");
+    REQUIRE(found.fund == "A");
+    REQUIRE(found.amount == 10.25);
+    REQUIRE(view.Search("5").fund.empty());
+    REQUIRE(view.Search("99").bidId.empty());
+    REQUIRE(view.FundSize("C") == 1);
+
+    unpublishShared(name);
+}
+
+TEST_CASE("Published image holds lazy titles decoded", "[shm]") {
+    const string name = shmName("lazy");
+    filesystem::path csv = filesystem::temp_directory_path() / ("bidshm_test_lazy_" + to_string(getpid()) + ".csv");
+    ofstream(csv, ios::binary) << "Title,ID\n\"Desk, oak\",7\n";
+    {
+        MappedFile file(csv.string());
+        Bid bid = makeBid("7");
+        bid.title.clear();
+        scanCsvRows(file, ',', [&](const vector<FieldSpan>& f) {
+            bid.titleSource = &file;
+            bid.titleOffset = f[0].offset;
+            bid.titleLength = f[0].length;
+        });
+        BidVectorList list;
+        list.Append(bid);
+        publishShared(name, list);
+    }
+
+    BidSharedView view(name);
+    REQUIRE(view.Search("7").title == "Desk, oak");
+    unpublishShared(name);
+    filesystem::remove(csv);
+}
+
+TEST_CASE("Attached view is read-only", "[shm]") {
+    const string name = shmName("readonly");
+    BidVectorList list;
+    list.Append(makeBid("1"));
+    publishShared(name, list);
+
+    BidSharedView view(name);
+    REQUIRE_THROWS_AS(view.Append(makeBid("2")), BidShmError);
+    REQUIRE_THROWS_AS(view.Prepend(makeBid("2")), BidShmError);
+    REQUIRE_THROWS_AS(view.Remove("1"), BidShmError);
+    REQUIRE(view.Size() == 1);
+
+    unpublishShared(name);
+    REQUIRE_THROWS_AS(BidSharedView(name), BidShmError);
+}
+
+TEST_CASE("Republishing leaves attached views on their generation until refreshed", "[shm]") {
+    const string name = shmName("republish");
+    BidVectorList list;
+    list.Append(makeBid("1"));
+    publishShared(name, list);
+    BidSharedView view(name);
+
+    list.Append(makeBid("2"));
+    REQUIRE(publishShared(name, list) == 2);
+    list.Append(makeBid("3"));
+    REQUIRE(publishShared(name, list) == 3);
+
+    // Generation 1 is unlinked, but still mapped here
+    REQUIRE(view.Stale());
+    REQUIRE(idsOf(view) == vector<string>{"1"});
+
+    REQUIRE(view.Refresh());
+    REQUIRE(view.Generation() == 3);
+    REQUIRE_FALSE(view.Stale());
+    REQUIRE_FALSE(view.Refresh());
+    REQUIRE(idsOf(view) == vector<string>{"1", "2", "3"});
+    REQUIRE(view.Search("3").bidId == "3");
+
+    unpublishShared(name);
+}
+
+TEST_CASE("Parallel walk of an attached view covers every bid once", "[shm]") {
+    const string name = shmName("parallel");
+    BidVectorList list;
+    for (int i = 0; i < 1000; i++) {
+        list.Append(makeBid(to_string(i), "F", i));
+    }
+    publishShared(name, list);
+    BidSharedView view(name);
+
+    vector<int> seen(1000, 0);
+    REQUIRE(view.ForEachParallel(4, [&](size_t, const Bid& b) { seen[stoi(b.bidId)]++; }) == 4);
+    REQUIRE(count(seen.begin(), seen.end(), 1) == 1000);
+
+    BidTotals totals = view.TotalsParallel(nullptr, 4);
+    REQUIRE(totals.count == 1000);
+    REQUIRE(totals.total == 999.0 * 1000 / 2);
+
+    unpublishShared(name);
+}
+
+TEST_CASE("Another process attaches to a published store", "[shm]") {
+    const string name = shmName("fork");
+    BidVectorList list;
+    list.Append(makeBid("81517", "Enterprise", 123.45));
+    publishShared(name, list);
+
+    pid_t child = fork();
+    REQUIRE(child >= 0);
+    if (child == 0) {
+        int status = 1;
+        try {
+            BidSharedView view(name);
+            Bid b = view.Search("81517");
+            status = (view.Size() == 1 && b.fund == "Enterprise" && b.amount == 123.45) ? 0 : 2;
+        } catch (...) {
+            status = 3;
+        }
+        _exit(status);
+    }
+    int status = -1;
+    waitpid(child, &status, 0);
+    REQUIRE(WIFEXITED(status));
+    REQUIRE(WEXITSTATUS(status) == 0);
+
+    unpublishShared(name);
+}
@@ -0,0 +1,103 @@
+//============================================================================
+// Unit Tests for BidSketches
+//
+// Tests that each sketch lands within its expected error and that merging
+// two sketches matches one sketch fed everything.
+//============================================================================
+
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <string>
+
+#include "BidSketches.hpp"
+
+using namespace std;
+
+TEST_CASE("HyperLogLog estimates distinct counts", "[sketches]") {
+    HyperLogLog hll;
+    for (int i = 0; i < 20000; i++) {
+        hll.Add("fund-" + to_string(i % 10000));  // every value twice
+    }
+    REQUIRE(fabs(hll.Estimate() - 10000) < 10000 * 0.05);
+}
+
+TEST_CASE("HyperLogLog is exact-ish for small counts", "[sketches]") {
+    HyperLogLog hll;
+    hll.Add("General Fund");
+    hll.Add("Water Fund");
+    hll.Add("General Fund");
+    REQUIRE(llround(hll.Estimate()) == 2);
+}
+
+TEST_CASE("HyperLogLog merge equals the union", "[sketches]") {
+    HyperLogLog a, b, both;
+    for (int i = 0; i < 5000; i++) {
+        a.Add(to_string(i));
+        b.Add(to_string(i + 2500));
+        both.Add(to_string(i));
+        both.Add(to_string(i + 2500));
+    }
+    a.Merge(b);
+    REQUIRE(a.Estimate() == both.Estimate());
+}
+
+TEST_CASE("TDigest quantiles of a uniform range", "[sketches]") {
+    TDigest digest;
+    for (int i = 1; i <= 10000; i++) {
+        digest.Add(i);
+    }
+    REQUIRE(digest.Count() == 10000);
+    REQUIRE(fabs(digest.Quantile(0.50) - 5000) < 100);
+    REQUIRE(fabs(digest.Quantile(0.95) - 9500) < 50);
+    REQUIRE(fabs(digest.Quantile(0.99) - 9900) < 20);
+}
+
+TEST_CASE("TDigest merge keeps quantiles", "[sketches]") {
+    TDigest low, high;
+    for (int i = 1; i <= 5000; i++) {
+        low.Add(i);
+        high.Add(i + 5000);
+    }
+    low.Merge(high);
+    REQUIRE(low.Count() == 10000);
+    REQUIRE(fabs(low.Quantile(0.50) - 5000) < 100);
+    REQUIRE(fabs(low.Quantile(0.99) - 9900) < 30);
+}
+
+TEST_CASE("Count-min finds heavy hitters and never undercounts", "[sketches]") {
+    CountMinSketch cms;
+    for (int i = 0; i < 3000; i++) {
+        cms.Add("noise-" + to_string(i));
+    }
+    for (int i = 0; i < 50; i++) cms.Add("Office Chair");
+    for (int i = 0; i < 30; i++) cms.Add("Desk");
+
+    REQUIRE(cms.Estimate("Office Chair") >= 50);
+    auto top = cms.TopK();
+    REQUIRE(top.size() >= 2);
+    REQUIRE(top[0].first == "Office Chair");
+    REQUIRE(top[1].first == "Desk");
+}
+
+TEST_CASE("Count-min merge combines counts from two loaders", "[sketches]") {
+    CountMinSketch a, b;
+    for (int i = 0; i < 20; i++) a.Add("Desk");
+    for (int i = 0; i < 25; i++) b.Add("Desk");
+    for (int i = 0; i < 30; i++) b.Add("Truck");
+
+    a.Merge(b);
+    REQUIRE(a.Estimate("Desk") >= 45);
+    REQUIRE(a.TopK()[0].first == "Desk");
+}
+
+TEST_CASE("LoadSketches merge across loaders", "[sketches]") {
+    LoadSketches first, second;
+    first.Add("General Fund", "GENERAL SERVICES", 10.0, "Chair");
+    second.Add("Water Fund", "WATER", 20.0, "Chair");
+
+    first.Merge(second);
+    REQUIRE(llround(first.funds.Estimate()) == 2);
+    REQUIRE(llround(first.departments.Estimate()) == 2);
+    REQUIRE(first.amounts.Count() == 2);
+    REQUIRE(first.titles.Estimate("Chair") >= 2);
+}
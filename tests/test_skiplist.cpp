@@ -0,0 +1,110 @@
+//============================================================================
+// Unit Tests for BidSkipList
+//
+// Tests ID ordering, search/remove with repeated and zero-padded IDs,
+// range scans, the BidStore fund fallbacks, and readers running alongside
+// a writer.
+//============================================================================
+
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BidSkipList.hpp"
+#include "TestBids.hpp"
+
+using namespace std;
+
+TEST_CASE("Skip list keeps bids in ID order", "[skiplist]") {
+    BidSkipList list;
+    for (string id : {"100", "9", "A7", "42", "1000", "A10"}) list.Append(makeBid(id));
+
+    REQUIRE(list.Size() == 6);
+    REQUIRE(idsOf(list) == vector<string>{"9", "42", "100", "1000", "A10", "A7"});
+}
+
+TEST_CASE("Skip list search and remove find exact IDs", "[skiplist]") {
+    BidSkipList list;
+    for (int i = 0; i < 2000; i++) list.Append(makeBid(to_string(i * 7 % 2000)));
+    list.Append(makeBid("007"));
+
+    REQUIRE(list.Search("1999").bidId == "1999");
+    REQUIRE(list.Search("7").title == "Bid 7");
+    REQUIRE(list.Search("007").bidId == "007");   // sorts with "7" but is its own bid
+    REQUIRE(list.Search("2000").bidId.empty());
+
+    REQUIRE(list.Remove("7"));
+    REQUIRE(list.Search("7").bidId.empty());
+    REQUIRE(list.Search("007").bidId == "007");
+    REQUIRE_FALSE(list.Remove("7"));
+    REQUIRE(list.Size() == 2000);
+}
+
+TEST_CASE("Skip list orders repeated IDs like the list", "[skiplist]") {
+    BidSkipList list;
+    list.Append(makeBid("5", "A"));
+    list.Append(makeBid("5", "B"));
+    list.Prepend(makeBid("5", "C"));
+
+    REQUIRE(list.Search("5").fund == "C");
+    REQUIRE(list.Remove("5"));
+    REQUIRE(list.Search("5").fund == "A");
+}
+
+TEST_CASE("Skip list range scan is inclusive and ordered", "[skiplist]") {
+    BidSkipList list;
+    for (int i = 100; i > 0; i--) list.Append(makeBid(to_string(i)));
+
+    vector<string> ids;
+    list.ForEachInRange("20", "25", [&](const Bid& b) { ids.push_back(b.bidId); });
+    REQUIRE(ids == vector<string>{"20", "21", "22", "23", "24", "25"});
+}
+
+TEST_CASE("Skip list answers fund queries through BidStore", "[skiplist]") {
+    BidSkipList list;
+    list.Append(makeBid("2", "Enterprise"));
+    list.Append(makeBid("1", "General Fund"));
+    list.Append(makeBid("3", "Enterprise"));
+
+    vector<string> ids;
+    list.ForEachInFund("Enterprise", [&](const Bid& b) { ids.push_back(b.bidId); });
+    REQUIRE(ids == vector<string>{"2", "3"});
+    REQUIRE(list.FundSize("Enterprise") == 2);
+    REQUIRE(list.Snapshot().size() == 3);
+}
+
+TEST_CASE("Skip list readers run while a writer inserts and removes", "[skiplist]") {
+    BidSkipList list;
+    for (int i = 0; i < 1000; i += 2) list.Append(makeBid(to_string(i)));
+
+    atomic<bool> done{false};
+    atomic<int> errors{0};
+    vector<thread> readers;
+    for (int r = 0; r < 4; r++) {
+        readers.emplace_back([&] {
+            while (!done.load()) {
+                // Even IDs are never removed, so every one must always be found
+                for (int i = 0; i < 1000; i += 50) {
+                    if (list.Search(to_string(i)).bidId != to_string(i)) errors++;
+                }
+                string last;
+                list.ForEach([&](const Bid& b) {
+                    if (!last.empty() && bidIdLess(b.bidId, last)) errors++;
+                    last = b.bidId;
+                });
+            }
+        });
+    }
+
+    for (int round = 0; round < 20; round++) {
+        for (int i = 1; i < 1000; i += 2) list.Append(makeBid(to_string(i)));
+        for (int i = 1; i < 1000; i += 2) list.Remove(to_string(i));
+    }
+    done = true;
+    for (auto& t : readers) t.join();
+
+    REQUIRE(errors.load() == 0);
+    REQUIRE(list.Size() == 500);
+}
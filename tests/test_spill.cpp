@@ -0,0 +1,142 @@
+//============================================================================
+// Unit Tests for BidSpillStore
+//
+// Tests that the store keeps list order and first-ID semantics while most
+// segments are on disk, that it stays near its budget, that scans don't
+// evict the segments being searched, and that a damaged page is reported.
+//============================================================================
+
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "BidSpill.hpp"
+#include "TestBids.hpp"
+
+using namespace std;
+namespace fs = std::filesystem;
+
+static string tempSpillPath(const string& name) {
+    fs::path p = fs::temp_directory_path() / ("spill_test_" + name + ".spill");
+    fs::remove(p);
+    return p.string();
+}
+
+// Titles past the small-string buffer, so segments weigh what real bids do
+static Bid heapBid(const string& id, const string& fund = "General Fund", double amount = 1.0) {
+    Bid b = makeBid(id, fund, amount);
+    b.title = "A title long enough to live on the heap, for bid " + id;
+    return b;
+}
+
+TEST_CASE("Spill store keeps list order across segments", "[spill]") {
+    const string path = tempSpillPath("order");
+    BidSpillStore store(path, 1 << 20, 4);
+    store.Append(heapBid("3"));
+    store.Append(heapBid("4"));
+    store.Prepend(heapBid("2"));
+    store.Prepend(heapBid("1"));
+    for (int i = 5; i <= 12; i++) {
+        store.Append(heapBid(to_string(i)));
+    }
+    for (int i = 0; i >= -5; i--) {
+        store.Prepend(heapBid(to_string(i)));
+    }
+
+    vector<string> expected;
+    for (int i = -5; i <= 12; i++) {
+        expected.push_back(to_string(i));
+    }
+    REQUIRE(idsOf(store) == expected);
+    REQUIRE(store.Size() == 18);
+
+    REQUIRE(store.Remove("4"));
+    REQUIRE_FALSE(store.Remove("4"));
+    REQUIRE(store.Search("4").bidId.empty());
+    REQUIRE(store.Size() == 17);
+    REQUIRE(idsOf(store).size() == 17);
+}
+
+TEST_CASE("Spill store finds and removes the first bid with an ID", "[spill]") {
+    const string path = tempSpillPath("repeats");
+    BidSpillStore store(path, 1 << 20, 2);
+    store.Append(heapBid("7", "second"));
+    store.Append(heapBid("8"));
+    store.Append(heapBid("7", "third"));
+    store.Prepend(heapBid("7", "first"));   // a prepend segment comes before all others
+
+    REQUIRE(store.Search("7").fund == "first");
+    REQUIRE(store.Remove("7"));
+    REQUIRE(store.Search("7").fund == "second");
+    REQUIRE(store.Remove("7"));
+    REQUIRE(store.Search("7").fund == "third");
+    REQUIRE(store.FundSize("third") == 1);
+}
+
+TEST_CASE("Spill store stays within its budget past RAM and reads pages back", "[spill]") {
+    const string path = tempSpillPath("budget");
+    const uint64_t budget = 256 * 1024;
+    BidSpillStore store(path, budget, 256);
+    const int n = 20000;
+    for (int i = 0; i < n; i++) {
+        store.Append(heapBid(to_string(i), "F" + to_string(i % 7), i));
+    }
+
+    SpillStats stats = store.Stats();
+    REQUIRE(stats.segments == (n + 255) / 256);
+    REQUIRE(stats.resident < stats.segments);
+    REQUIRE(stats.residentBytes <= budget);
+    REQUIRE(stats.fileBytes > 0);
+    REQUIRE(stats.fileBytes % 4096 == 0);
+
+    // Every bid is still there, in order, through the pages
+    int expected = 0;
+    double total = 0;
+    store.ForEach([&](const Bid& b) {
+        REQUIRE(b.bidId == to_string(expected++));
+        total += b.amount;
+    });
+    REQUIRE(expected == n);
+    REQUIRE(total == double(n - 1) * n / 2);
+    REQUIRE(store.Stats().residentBytes <= budget);
+
+    Bid b = store.Search("12345");
+    REQUIRE(b.fund == "F" + to_string(12345 % 7));
+    REQUIRE(b.title == heapBid("12345").title);
+    REQUIRE(store.Remove("12345"));
+    REQUIRE(store.Search("12345").bidId.empty());
+    REQUIRE(store.Size() == n - 1);
+}
+
+TEST_CASE("A scan does not evict the segments being searched", "[spill]") {
+    const string path = tempSpillPath("scan");
+    BidSpillStore store(path, 96 * 1024, 128);
+    for (int i = 0; i < 5000; i++) {
+        store.Append(heapBid(to_string(i)));
+    }
+    REQUIRE(store.Search("10").bidId == "10");   // segment 0 is now hot
+    REQUIRE(store.Search("200").bidId == "200");
+
+    store.ForEach([](const Bid&) {});
+    const uint64_t faults = store.Stats().faults;
+    REQUIRE(store.Search("10").bidId == "10");
+    REQUIRE(store.Search("200").bidId == "200");
+    REQUIRE(store.Stats().faults == faults);
+}
+
+TEST_CASE("A damaged spill page is reported", "[spill]") {
+    const string path = tempSpillPath("damaged");
+    BidSpillStore store(path, 32 * 1024, 64);
+    for (int i = 0; i < 2000; i++) {
+        store.Append(heapBid(to_string(i)));
+    }
+    {
+        fstream f(path, ios::in | ios::out | ios::binary);
+        f.seekp(100);
+        f.write("garbage", 7);   // inside the first page written
+    }
+    REQUIRE_THROWS_AS(store.Search("0"), BidSpillError);
+    REQUIRE(store.Search("1999").bidId == "1999");   // resident pages are unaffected
+}
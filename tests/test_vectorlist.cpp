@@ -0,0 +1,112 @@
+//============================================================================
+// Unit Tests for BidVectorList
+//
+// Tests list order through appends, prepends and removals, reuse of freed
+// slots, repeated IDs, and Compact() putting the vector back in list
+// order for sliced parallel scans.
+//============================================================================
+
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <vector>
+
+#include "BidVectorList.hpp"
+#include "TestBids.hpp"
+
+using namespace std;
+
+TEST_CASE("Vector list keeps list order through edits", "[vectorlist]") {
+    BidVectorList list;
+    list.Append(makeBid("2"));
+    list.Append(makeBid("3"));
+    list.Prepend(makeBid("1"));
+    list.Append(makeBid("4"));
+    REQUIRE(idsOf(list) == vector<string>{"1", "2", "3", "4"});
+    REQUIRE(list.Size() == 4);
+
+    REQUIRE(list.Remove("1"));   // head
+    REQUIRE(list.Remove("4"));   // tail
+    REQUIRE(list.Remove("3"));
+    REQUIRE_FALSE(list.Remove("3"));
+    REQUIRE(idsOf(list) == vector<string>{"2"});
+    REQUIRE(list.Search("2").title == "Bid 2");
+    REQUIRE(list.Search("3").bidId.empty());
+
+    REQUIRE(list.Remove("2"));
+    REQUIRE(list.Size() == 0);
+    REQUIRE(list.Slots() == 0);
+    REQUIRE(idsOf(list).empty());
+    list.Append(makeBid("5"));
+    REQUIRE(idsOf(list) == vector<string>{"5"});
+}
+
+TEST_CASE("Vector list reuses freed slots before growing", "[vectorlist]") {
+    BidVectorList list;
+    for (int i = 0; i < 100; i++) list.Append(makeBid(to_string(i)));
+    REQUIRE(list.InOrder());
+    REQUIRE(list.Remove("99"));       // last slot: dropped, still in order
+    REQUIRE(list.InOrder());
+    REQUIRE(list.Slots() == 99);
+
+    for (int i = 0; i < 50; i += 2) REQUIRE(list.Remove(to_string(i)));
+    REQUIRE_FALSE(list.InOrder());
+    REQUIRE(list.Slots() == 99);
+    for (int i = 100; i < 125; i++) list.Append(makeBid(to_string(i)));
+    REQUIRE(list.Slots() == 99);      // all 25 went into freed slots
+    list.Append(makeBid("125"));
+    REQUIRE(list.Slots() == 100);
+
+    vector<string> ids = idsOf(list);
+    REQUIRE(ids.size() == 100);
+    REQUIRE(ids.front() == "1");
+    REQUIRE(ids.back() == "125");
+    REQUIRE(list.Search("110").title == "Bid 110");
+}
+
+TEST_CASE("Vector list finds and removes the first of repeated IDs", "[vectorlist]") {
+    BidVectorList list;
+    list.Append(makeBid("7", "B"));
+    list.Append(makeBid("8"));
+    list.Append(makeBid("7", "C"));
+    list.Prepend(makeBid("7", "A"));
+
+    REQUIRE(list.Search("7").fund == "A");
+    REQUIRE(list.Remove("7"));
+    REQUIRE(list.Search("7").fund == "B");
+    REQUIRE(list.Remove("7"));
+    REQUIRE(list.Search("7").fund == "C");
+    REQUIRE(list.Remove("7"));
+    REQUIRE_FALSE(list.Remove("7"));
+    REQUIRE(idsOf(list) == vector<string>{"8"});
+}
+
+TEST_CASE("Vector list compacts back into list order", "[vectorlist]") {
+    BidVectorList list;
+    for (int i = 0; i < 1000; i++) {
+        if (i % 2) list.Append(makeBid(to_string(i), "F", i));
+        else list.Prepend(makeBid(to_string(i), "F", i));
+    }
+    for (int i = 0; i < 1000; i += 3) list.Remove(to_string(i));
+    const vector<string> before = idsOf(list);
+    REQUIRE_FALSE(list.InOrder());
+
+    list.Compact();
+    REQUIRE(list.InOrder());
+    REQUIRE(list.Slots() == before.size());
+    REQUIRE(idsOf(list) == before);
+    REQUIRE(list.Search("998").title == "Bid 998");
+    REQUIRE(list.Remove(before.back()));   // the tail is the last slot: stays in order
+    REQUIRE(list.InOrder());
+    REQUIRE(list.Search(before.back()).bidId.empty());
+
+    // In order, parallel scans slice the vector and still follow list order
+    const vector<string> serial = idsOf(list);
+    for (unsigned threads : {1u, 4u}) {
+        vector<Bid> all = list.FilterParallel([](const Bid&) { return true; }, threads);
+        vector<string> ids;
+        for (const Bid& b : all) ids.push_back(b.bidId);
+        REQUIRE(ids == serial);
+    }
+    REQUIRE(list.ForEachParallel(4, [](size_t, const Bid&) {}) == 4);
+    REQUIRE(list.TotalsParallel(nullptr, 4).count == serial.size());
+}